@@ -19,6 +19,7 @@ sudo apt install -y \
     libswresample-dev \
     libglfw3-dev \
     libgl1-mesa-dev \
+    libegl1-mesa-dev \
     portaudio19-dev \
     libglew-dev \
     libxinerama-dev \
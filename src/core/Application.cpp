@@ -2,8 +2,13 @@
 #include <GLFW/glfw3.h>
 #include "Application.h"
 #include "imgui.h"
+#include "media/EncodeRateController.h"
+#include "media/Recorder.h"
 #include "report/HttpReportSource.h"
+#include "Utils.h"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <filesystem>
 
 Application::Application() {
@@ -79,7 +84,7 @@ bool Application::initialize() {
 
     // Media Player
     _mediaPlayer = std::make_unique<MediaPlayer>();
-    if (!_mediaPlayer->initialize(_window, VIDEO_WIDTH, VIDEO_HEIGHT)) {
+    if (!_mediaPlayer->initialize(VIDEO_WIDTH, VIDEO_HEIGHT)) {
         std::cerr << "Failed to initialize media player\n";
         return false;
     }
@@ -100,6 +105,14 @@ bool Application::initializeWindow() {
 
     glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
 
+    // 렌더러/ImGui 모두 GLSL 330 core 사용
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
     _window = glfwCreateWindow(_windowWidth, _windowHeight,
                                "Loki Media Player", nullptr, nullptr);
     if (!_window) {
@@ -124,6 +137,8 @@ bool Application::initializeWindow() {
 }
 
 bool Application::initializeOpenGL() {
+    // core profile 에서 확장 함수 포인터를 모두 로드
+    glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) {
         std::cerr << "Failed to initialize GLEW\n";
         return false;
@@ -143,6 +158,21 @@ bool Application::initializeUI() {
         _fileLoaded = false;
     });
 
+    // Playlist - 체크한 파일들 재생/추가
+    _uiManager->getFileSelector()->setPlaylistCallback([this](const std::vector<std::string> &files) {
+        _requestedPlaylist = files;
+    });
+    _uiManager->getFileSelector()->setEnqueueCallback([this](const std::vector<std::string> &files) {
+        // 이어 붙일 단일 파일 재생이 없으면 바로 재생 목록으로 시작
+        if (!_fileLoaded || _mediaPlayer->isGridMode()) {
+            _requestedPlaylist = files;
+            return;
+        }
+        for (const auto &file: files) {
+            _mediaPlayer->enqueue(file);
+        }
+    });
+
     // OSD
     _uiManager->setWindowSize(_windowWidth, _windowHeight);
 
@@ -177,6 +207,28 @@ void Application::setupUICallbacks() {
         _mediaPlayer->stopRecording();
     });
     
+    _controlPanel->setExportClipCallback([this](double inTime, double outTime) {
+        if (_exportResult.valid()) {
+            std::cout << "Clip export already in progress: " << _exportFile << std::endl;
+            return;
+        }
+
+        // 녹화 보관 정책이 지우지 않도록 녹화 디렉터리와 분리
+        std::string clipsDir = "clips";
+        std::error_code ec;
+        std::filesystem::create_directories(clipsDir, ec);
+
+        auto now = std::chrono::system_clock::now();
+        auto in_time_t = std::chrono::system_clock::to_time_t(now);
+        std::stringstream ss;
+        ss << std::put_time(std::localtime(&in_time_t), "%Y%m%d_%H%M%S");
+        _exportFile = clipsDir + "/clip_" + ss.str() + ".mp4";
+
+        _exportResult = _mediaPlayer->exportClip(inTime, outTime, _exportFile);
+        std::cout << "Exporting clip " << Utils::formatTime(inTime) << " - " << Utils::formatTime(outTime)
+                  << " to: " << _exportFile << std::endl;
+    });
+
     _mediaPlayer->setOnRecordingStateChanged([this](bool isRecording) {
         _controlPanel->setRecordingState(isRecording);
     });
@@ -203,6 +255,21 @@ void Application::handleEvents() {
     if (_uiManager) {
         _uiManager->handleOSDInput(_window);
     }
+
+    // Grid - 타일 클릭 시 해당 채널 포커스 (다시 클릭하면 해제)
+    static bool mouseWasPressed = false;
+    const bool mouseIsPressed = (glfwGetMouseButton(_window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS);
+
+    if (mouseIsPressed && !mouseWasPressed && _mediaPlayer->isGridMode() && !ImGui::GetIO().WantCaptureMouse) {
+        double x = 0.0, y = 0.0;
+        glfwGetCursorPos(_window, &x, &y);
+
+        const int channel = _mediaPlayer->getChannelAt(x, y, _windowWidth, _windowHeight - CONTROLS_HEIGHT);
+        if (channel >= 0) {
+            _mediaPlayer->setFocusedChannel(channel == _mediaPlayer->getFocusedChannel() ? -1 : channel);
+        }
+    }
+    mouseWasPressed = mouseIsPressed;
 }
 
 void Application::update() {
@@ -214,15 +281,92 @@ void Application::update() {
             _fileLoaded = true;
         }
     }
+
+    // Playlist
+    if (!_requestedPlaylist.empty()) {
+        const auto playlist = std::move(_requestedPlaylist);
+        _requestedPlaylist.clear();
+        if (_mediaPlayer->setPlaylist(playlist)) {
+            std::cout << "Playing playlist: " << playlist.size() << " files\n";
+            _fileLoaded = true;
+        }
+    }
+    // Live - 녹화 디렉터리의 최신 세션에서 기록 중인 세그먼트를 따라 재생
+    if (_liveRequested) {
+        _liveRequested = false;
+        if (_mediaPlayer->loadLive(Recorder::DEFAULT_OUTPUT_DIR)) {
+            _selectedFile = _mediaPlayer->getState().currentFile;
+            std::cout << "Following live recording: " << _selectedFile << "\n";
+            _fileLoaded = true;
+        }
+    }
+    // 재생 목록이 다음 항목으로 넘어가면 선택 파일도 따라감
+    if (_fileLoaded && !_mediaPlayer->getPlaylist().empty()) {
+        _selectedFile = _mediaPlayer->getState().currentFile;
+    }
+
+    // Clip export 결과
+    if (_exportResult.valid() && _exportResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        if (_exportResult.get()) {
+            std::cout << "Clip exported: " << _exportFile << "\n";
+        } else {
+            std::cerr << "Clip export failed: " << _exportFile << "\n";
+        }
+    }
+
+    // Grid - assets 폴더의 영상들을 동기화 재생
+    if (_gridRequested) {
+        _gridRequested = false;
+
+        std::vector<std::string> gridFiles;
+        std::copy_if(_videoFiles.begin(), _videoFiles.end(), std::back_inserter(gridFiles), Utils::isVideoFile);
+        if (gridFiles.size() > MediaPlayer::MAX_GRID_CHANNELS) {
+            gridFiles.resize(MediaPlayer::MAX_GRID_CHANNELS);
+        }
+
+        if (_mediaPlayer->loadFiles(gridFiles)) {
+            std::cout << "Playing grid: " << gridFiles.size() << " channels\n";
+            _selectedFile = gridFiles.front();
+            _fileLoaded = true;
+        }
+    }
     
     // Report
     if (_mediaPlayer) {
         const auto state = _mediaPlayer->getState();
-        _channelStatus[0].fps = 30;
-        _channelStatus[0].queue_length = 0;
+        const auto channelCount = _mediaPlayer->getChannelCount();
+        if (channelCount > 0) {
+            _channelStatus.resize(channelCount);
+            for (size_t i = 0; i < channelCount; ++i) {
+                _channelStatus[i].id = static_cast<int>(i);
+                _channelStatus[i].fps = 30;
+                _channelStatus[i].queue_length = static_cast<int>(_mediaPlayer->getChannelQueueSize(i));
+            }
+        }
 
         _syncStatus.max_offset_ms = state.audioVideoSyncOffset * 1000.0; // ms
         _syncStatus.locked = state.isPlaying && (std::abs(state.audioVideoSyncOffset) < 0.1);
+        _syncStatus.channel_offsets.clear();
+
+        // Grid - 채널간 clock offset 추정치
+        const auto estimates = _mediaPlayer->getChannelClockEstimates();
+        if (!estimates.empty()) {
+            bool converged = true;
+            double maxOffsetMs = 0.0;
+            for (size_t i = 0; i < estimates.size(); ++i) {
+                const auto &estimate = estimates[i];
+                _syncStatus.channel_offsets.push_back(ChannelSyncOffset{
+                        .id = static_cast<int>(i),
+                        .offset_ms = estimate.offset * 1000.0,
+                        .drift_ppm = estimate.skew * 1e6,
+                        .window_ms = estimate.window * 1000.0
+                });
+                maxOffsetMs = std::max(maxOffsetMs, std::abs(estimate.offset) * 1000.0);
+                converged = converged && estimate.converged;
+            }
+            _syncStatus.max_offset_ms = maxOffsetMs;
+            _syncStatus.locked = state.isPlaying && converged;
+        }
 
         updateReporters();
     }
@@ -335,9 +479,32 @@ void Application::render() {
             _uiManager->getFileSelector()->setVisible(true);
         }
     }
+    ImGui::SameLine();
+    if (ImGui::Button("Open Grid")) {
+        _gridRequested = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Live")) {
+        _liveRequested = true;
+    }
     ImGui::Text("Selected: %s", _selectedFile.empty() ? "None" : _selectedFile.c_str());
+
+    // Playlist - 이전/다음 항목
+    if (const auto &playlist = _mediaPlayer->getPlaylist(); !playlist.empty()) {
+        if (ImGui::Button("Prev")) {
+            _mediaPlayer->playPrevious();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Next")) {
+            _mediaPlayer->playNext();
+        }
+        ImGui::SameLine();
+        ImGui::Text("Playlist: %zu / %zu", _mediaPlayer->getPlaylistIndex() + 1, playlist.size());
+    }
     ImGui::End();
 
+    renderRecordOptions();
+
     // OSD
     if (_uiManager) {
         _uiManager->render();
@@ -347,6 +514,61 @@ void Application::render() {
     glfwSwapBuffers(_window);
 }
 
+void Application::renderRecordOptions() {
+    static constexpr const char *MODES[] = {"Transcode", "Passthrough"};
+    static constexpr float MAX_PRE_RECORD_SECONDS = 30.0f;
+
+    ImGui::Begin("Record");
+
+    // 녹화 중에는 진행 중인 녹화 설정을 바꾸지 않음
+    if (_mediaPlayer->isRecording()) {
+        ImGui::Text("Recording: %s", MODES[static_cast<int>(_recordOptions.mode)]);
+        ImGui::End();
+        return;
+    }
+
+    bool changed = false;
+    int mode = static_cast<int>(_recordOptions.mode);
+    if (ImGui::Combo("Mode", &mode, MODES, static_cast<int>(std::size(MODES)))) {
+        _recordOptions.mode = static_cast<RecordMode>(mode);
+        changed = true;
+    }
+
+    if (_recordOptions.mode == RecordMode::Passthrough) {
+        // 녹화 시작 전 구간 (압축 패킷 보관)
+        auto preRecord = static_cast<float>(_recordOptions.preRecord.seconds);
+        if (ImGui::SliderFloat("Pre-record (s)", &preRecord, 0.0f, MAX_PRE_RECORD_SECONDS, "%.0f")) {
+            _recordOptions.preRecord.seconds = preRecord;
+            changed = true;
+        }
+    } else {
+        auto &encoder = _recordOptions.encoder;
+        const auto &presets = EncodeRateController::PRESETS;
+        int preset = EncodeRateController::presetIndex(encoder.preset);
+        if (ImGui::Combo("Preset", &preset, presets.data(), static_cast<int>(presets.size()))) {
+            encoder.preset = presets[preset];
+            changed = true;
+        }
+        changed |= ImGui::SliderInt("CRF", &encoder.crf, 18, 35);
+        changed |= ImGui::Checkbox("Adaptive preset", &encoder.adaptivePreset);
+
+        // 원본과 함께 360p proxy 기록
+        bool proxy = !_recordOptions.renditions.empty();
+        if (ImGui::Checkbox("360p proxy", &proxy)) {
+            _recordOptions.renditions.clear();
+            if (proxy) {
+                _recordOptions.renditions.emplace_back();
+            }
+            changed = true;
+        }
+    }
+    ImGui::End();
+
+    if (changed) {
+        _mediaPlayer->setRecordOptions(_recordOptions);
+    }
+}
+
 void Application::cleanup() {
     if (_httpReporter) {
         _httpReporter->stop();
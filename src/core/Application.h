@@ -1,6 +1,7 @@
 #pragma once
 
 #include <GLFW/glfw3.h>
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,6 +40,9 @@ private:
 
     void render();
 
+    // 녹화 방식/pre-record/rendition/인코더 설정
+    void renderRecordOptions();
+
     void cleanup();
 
     // OSD
@@ -65,6 +69,14 @@ private:
     std::vector<std::string> _videoFiles;
     std::string _selectedFile;
     bool _fileLoaded = false;
+    bool _gridRequested = false;
+    bool _liveRequested = false;
+    RecordOptions _recordOptions;
+
+    // Clip export (백그라운드에서 진행, update 에서 결과 확인)
+    std::future<bool> _exportResult;
+    std::string _exportFile;
+    std::vector<std::string> _requestedPlaylist;
 
     // Sensor
     std::unique_ptr<ISensorSource> _sensorSource;
@@ -0,0 +1,163 @@
+#include "HeadlessRunner.h"
+#include <iostream>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+HeadlessRunner::HeadlessRunner(Options options) : _options(std::move(options)) {
+}
+
+HeadlessRunner::~HeadlessRunner() {
+    if (_output) {
+        std::fclose(_output);
+    }
+
+    // GL 리소스는 컨텍스트가 유효할 때 해제
+    if (_context) {
+        _context->makeCurrent();
+    }
+    _targetFBO.reset();
+    _mediaPlayer.reset();
+}
+
+bool HeadlessRunner::initialize() {
+    if (_options.inputFiles.empty()) {
+        std::cerr << "No input files\n";
+        return false;
+    }
+
+    _context = std::make_unique<HeadlessContext>();
+    if (!_context->initialize()) {
+        return false;
+    }
+
+    // 기본 프레임버퍼가 없으므로 FBO 에 렌더링 후 readback
+    _targetFBO = std::make_unique<VideoFBO>();
+    _targetFBO->create(_options.width, _options.height);
+
+    _mediaPlayer = std::make_unique<MediaPlayer>();
+    _mediaPlayer->setRealtimePacing(_options.realtime);
+    if (!_mediaPlayer->initialize(_options.width, _options.height, false)) {
+        std::cerr << "Failed to initialize media player\n";
+        return false;
+    }
+
+    if (!_mediaPlayer->loadFiles(_options.inputFiles)) {
+        return false;
+    }
+
+    if (!_options.outputPath.empty()) {
+        _output = std::fopen(_options.outputPath.c_str(), "wb");
+        if (!_output) {
+            std::cerr << "Failed to open output: " << _options.outputPath << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int HeadlessRunner::run() {
+    _mediaPlayer->play();
+
+    const auto startTime = std::chrono::steady_clock::now();
+    auto lastFrameTime = startTime;
+    uint64_t lastPresented = 0;
+
+    while (_options.maxFrames == 0 || _frameCount < _options.maxFrames) {
+        _mediaPlayer->update();
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto presented = _mediaPlayer->getPresentedFrameCount();
+        if (presented == lastPresented) {
+            if (now - lastFrameTime >= IDLE_TIMEOUT) {
+                break;
+            }
+            // grid 모드는 update 가 대기하지 않으므로 busy loop 방지
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        lastPresented = presented;
+        lastFrameTime = now;
+        renderAndReadBack();
+    }
+
+    _mediaPlayer->stop();
+
+    // 마지막 프레임 이후 대기 시간은 제외
+    const double elapsed = std::chrono::duration<double>(lastFrameTime - startTime).count();
+    const double fps = elapsed > 0.0 ? static_cast<double>(_frameCount) / elapsed : 0.0;
+    spdlog::info("Headless: {} frames in {:.2f}s ({:.1f} fps, {} channels, {}x{}, readback {:.1f} MB)",
+                 _frameCount, elapsed, fps, _mediaPlayer->getChannelCount(), _options.width, _options.height,
+                 static_cast<double>(_readBackBytes) / (1024.0 * 1024.0));
+
+    if (_output) {
+        spdlog::info("Raw RGBA output: {} (ffmpeg -f rawvideo -pix_fmt rgba -s {}x{} -i {})",
+                     _options.outputPath, _options.width, _options.height, _options.outputPath);
+    }
+    return _frameCount > 0 ? 0 : 1;
+}
+
+void HeadlessRunner::renderAndReadBack() {
+    _targetFBO->bind();
+    glViewport(0, 0, _options.width, _options.height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    _mediaPlayer->render(_options.width, _options.height, 0);
+
+    VideoFBO::unbind();
+
+    // readback (top-down 순서로 뒤집어서 기록)
+    const auto pixels = _targetFBO->readPixels(true);
+    _readBackBytes += pixels.size();
+    if (_output) {
+        std::fwrite(pixels.data(), 1, pixels.size(), _output);
+    }
+    ++_frameCount;
+}
+
+bool HeadlessRunner::parseArguments(const int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = (i + 1 < argc);
+
+        try {
+            if (arg == "--headless") {
+                continue;
+            } else if (arg == "--output" && hasValue) {
+                options.outputPath = argv[++i];
+            } else if (arg == "--frames" && hasValue) {
+                options.maxFrames = std::stoull(argv[++i]);
+            } else if (arg == "--width" && hasValue) {
+                options.width = std::stoi(argv[++i]);
+            } else if (arg == "--height" && hasValue) {
+                options.height = std::stoi(argv[++i]);
+            } else if (arg == "--realtime") {
+                options.realtime = true;
+            } else if (arg.rfind("--", 0) == 0) {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            } else {
+                options.inputFiles.push_back(arg);
+            }
+        } catch (const std::exception &) {
+            std::cerr << "Invalid value for " << arg << "\n";
+            return false;
+        }
+    }
+
+    if (options.width <= 0 || options.height <= 0) {
+        std::cerr << "Invalid output size\n";
+        return false;
+    }
+    return !options.inputFiles.empty();
+}
+
+void HeadlessRunner::printUsage() {
+    std::cerr << "Usage: loki_media_player --headless [options] <file> [file...]\n"
+              << "  --frames <n>       stop after n frames (default: until end of input)\n"
+              << "  --output <path>    write rendered frames as raw RGBA\n"
+              << "  --width <px>       render width (default: 1280)\n"
+              << "  --height <px>      render height (default: 720)\n"
+              << "  --realtime         pace playback in real time (default: as fast as possible)\n";
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/MediaPlayer.h"
+#include "rendering/HeadlessContext.h"
+#include "rendering/VideoFBO.h"
+
+// 창 없이 decode -> upload -> render -> readback 전체 파이프라인 실행 (벤치마크 / 서버 렌더링)
+class HeadlessRunner {
+public:
+    struct Options {
+        std::vector<std::string> inputFiles;    // 2개 이상이면 grid
+        std::string outputPath;                 // 비어 있지 않으면 readback 결과를 raw RGBA 로 기록
+        uint64_t maxFrames{0};                  // 0: 끝까지
+        int width{1280};
+        int height{720};
+        bool realtime{false};                   // true: 실시간 속도로 재생
+    };
+
+    explicit HeadlessRunner(Options options);
+
+    ~HeadlessRunner();
+
+    bool initialize();
+
+    int run();
+
+    // main 인자 파싱 (--headless 이후), 실패 시 false
+    static bool parseArguments(int argc, char **argv, Options &options);
+
+    static void printUsage();
+
+private:
+    void renderAndReadBack();
+
+    Options _options;
+    std::unique_ptr<HeadlessContext> _context;
+    std::unique_ptr<MediaPlayer> _mediaPlayer;
+    std::unique_ptr<VideoFBO> _targetFBO;
+
+    FILE *_output{nullptr};
+    uint64_t _frameCount{0};
+    uint64_t _readBackBytes{0};
+
+    // 이 시간 동안 새 프레임이 없으면 입력 끝으로 판단
+    static constexpr auto IDLE_TIMEOUT = std::chrono::seconds(3);
+};
@@ -1,12 +1,41 @@
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 #include "../gl_common.h"
+#include "../media/ClipExporter.h"
 #include "../media/FileVideoSource.h"
+#include "../media/LiveFileInput.h"
+#include "../media/SegmentedVideoSource.h"
 #include "MediaPlayer.h"
 #include "Utils.h"
 
 namespace fs = std::filesystem;
 
+namespace {
+    // 재생 목록 항목 디코딩 시작 (warm 이 있으면 처음으로 되돌려 재사용)
+    // 큐가 차면 디코더가 대기하므로 재생 전에는 첫 GOP 와 오디오까지만 디코딩됨
+    std::unique_ptr<FileVideoSource> startPlaylistSource(const std::string &filename,
+                                                         const IDecoderSource::DecoderConfig &config,
+                                                         std::unique_ptr<FileVideoSource> warm,
+                                                         std::shared_ptr<IFrameAllocator> allocator) {
+        auto source = std::move(warm);
+        if (source) {
+            source->rewind();
+            // 보관 중에 바뀌었을 수 있는 표시 크기 적용
+            source->setOutputSize(config.outputWidth, config.outputHeight);
+        } else {
+            source = std::make_unique<FileVideoSource>(filename, config);
+            if (const auto proxy = FileVideoSource::findProxyFile(filename); !proxy.empty()) {
+                source->setProxy(proxy);
+            }
+        }
+        // 할당자는 start 전에 설정 (PBO 크기가 맞지 않으면 힙 버퍼로 대체됨)
+        source->decoder().setFrameAllocator(std::move(allocator));
+        source->start();
+        return source;
+    }
+}
+
 MediaPlayer::MediaPlayer() = default;
 
 MediaPlayer::~MediaPlayer() {
@@ -16,45 +45,41 @@ MediaPlayer::~MediaPlayer() {
         _audioThread.reset();
     }
 
-    if (_frontFBO) {
-        _frontFBO.reset();
-    }
-
-    if (_backFBO) {
-        _backFBO.reset();
-    }
-
-    if (_shaderProgram) {
-        _shaderProgram.reset();
-    }
-
     if (_source) {
         _source->getVideoQueue().clear();
         _source->getAudioQueue().clear();
         _source.reset();
     }
+
+    discardPreroll();
+    // 열고 있는 pre-roll 은 완료까지 대기 후 해제
+    _retiringPrerolls.clear();
+    _warmPool.clear();
+    _channels.clear();
+    _gridRenderer.reset();
 }
 
-bool MediaPlayer::initialize(GLFWwindow *window, int videoWidth, int videoHeight) {
+bool MediaPlayer::initialize(const int videoWidth, const int videoHeight, const bool enableAudio) {
     _videoWidth = videoWidth;
     _videoHeight = videoHeight;
 
     // Initialize audio player
-    _audioPlayer = std::make_unique<AudioPlayer>(48000, 2);
+    if (enableAudio) {
+        _audioPlayer = std::make_unique<AudioPlayer>(48000, 2);
+    }
     _syncManager = std::make_unique<SyncManager>();
 
     // Initialize renderer
-    _renderer = std::make_unique<VideoRenderer>(window, videoWidth, videoHeight);
-
-    // Initialize FBOs
-    _frontFBO = std::make_unique<VideoFBO>();
-    _backFBO = std::make_unique<VideoFBO>();
-    _frontFBO->create(videoWidth, videoHeight);
-    _backFBO->create(videoWidth, videoHeight);
+    try {
+        _renderer = std::make_unique<VideoRenderer>(videoWidth, videoHeight);
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to initialize renderer: " << e.what() << "\n";
+        return false;
+    }
 
-    // Initialize shaders
-    if (!initializeShaders()) {
-        std::cerr << "Failed to initialize shaders\n";
+    // Initialize grid renderer
+    _gridRenderer = std::make_unique<GridRenderer>();
+    if (!_gridRenderer->initialize()) {
         return false;
     }
 
@@ -64,58 +89,83 @@ bool MediaPlayer::initialize(GLFWwindow *window, int videoWidth, int videoHeight
     return true;
 }
 
-bool MediaPlayer::initializeShaders() {
-    _shaderProgram = std::make_unique<ShaderProgram>();
+void MediaPlayer::setViewSize(const int width, const int height) {
+    if (width == _videoWidth && height == _videoHeight) {
+        return;
+    }
+    _videoWidth = width;
+    _videoHeight = height;
+    updateOutputSizes();
+}
 
-    const auto vertexShaderSrc = R"(
-        #version 330 core
-        layout (location = 0) in vec2 aPos;
-        layout (location = 1) in vec2 aTex;
-        out vec2 TexCoord;
-        void main() {
-            TexCoord = aTex;
-            gl_Position = vec4(aPos.xy, 0.0, 1.0);
-        })";
+bool MediaPlayer::loadFile(const std::string &filename) {
+    clearPlaylist();
+    return openSource(filename, makeDecoderConfig());
+}
 
-    const auto fragmentShaderSrc = R"(
-        #version 330 core
-        out vec4 FragColor;
-        in vec2 TexCoord;
-        uniform sampler2D screenTexture;
-        void main() { FragColor = texture(screenTexture, TexCoord); })";
+bool MediaPlayer::loadLive(const std::string &path, const double latencySeconds) {
+    // 녹화 디렉터리가 주어지면 가장 최근 세션에서 기록 중인 세그먼트
+    std::error_code ec;
+    const std::string segment = std::filesystem::is_directory(path, ec) ? LiveFileInput::findActiveSegment(path) : path;
+    if (segment.empty()) {
+        std::cerr << "No recording segment to follow in " << path << "\n";
+        return false;
+    }
 
-    return _shaderProgram->loadVertexFragment(vertexShaderSrc, fragmentShaderSrc);
+    clearPlaylist();
+    auto config = makeDecoderConfig();
+    config.liveTail = true;
+    config.liveLatency = latencySeconds;
+    return openSource(segment, config);
 }
 
-bool MediaPlayer::loadFile(const std::string &filename) {
+bool MediaPlayer::openSource(const std::string &filename, const IDecoderSource::DecoderConfig &config) {
     try {
         // Clean up existing decoder
-        if (_source) {
-            stop();
-            _audioThread.reset();
-            _source.reset();
-        }
+        unloadSources();
+
+        // 녹화 세션 디렉터리는 세그먼트를 이어서 하나의 시간축으로 재생
+        if (!config.liveTail && SegmentedVideoSource::isSessionDirectory(filename)) {
+            auto session = std::make_unique<SegmentedVideoSource>(filename, config);
+            if (_renderer) {
+                _renderer->prepareFrameSize(session->getVideoWidth(), session->getVideoHeight());
+                session->setFrameAllocator(_renderer->getFrameAllocator());
+            }
+            _source = std::move(session);
+        } else {
+            // 최근 닫은 파일이면 열어 둔 디코더를 처음부터 다시 사용
+            std::unique_ptr<FileVideoSource> source;
+            if (!config.liveTail) {
+                source = takeWarmSource(filename);
+            }
+            if (source) {
+                source->rewind();
+                source->setOutputSize(config.outputWidth, config.outputHeight);
+            } else {
+                source = std::make_unique<FileVideoSource>(filename, config);
+                if (const auto proxy = FileVideoSource::findProxyFile(filename); !proxy.empty() && !config.liveTail) {
+                    source->setProxy(proxy);
+                }
+            }
 
-        auto config = Decoder::DecoderConfig{
-                .decoderType = Decoder::DecoderType::SW
-        };
+            // 단일 화면은 디코더가 PBO 에 직접 기록 (그리드는 타일별 업로드라 기존 경로 유지)
+            if (_renderer) {
+                auto &decoder = source->decoder();
+                _renderer->prepareFrameSize(decoder.getOutputWidth(), decoder.getOutputHeight());
+                decoder.setFrameAllocator(_renderer->getFrameAllocator());
+            }
+            _source = std::move(source);
+        }
 
-        _source = std::make_unique<FileVideoSource>(filename, config);
+        applyPreRecord();
+        _liveTail = config.liveTail;
         _state.currentFile = filename;
         _state.totalDuration = _source->getDuration();
         _state.reset();
 
         // Initialize audio thread
-        _audioThread = std::make_unique<AudioThread>(
-                _source->getAudioQueue(),
-                _source->getVideoQueue(),
-                *_audioPlayer,
-                *_syncManager,
-                *_source
-        );
-
-        _audioThread->start();
-        
+        startAudioThread(*_source);
+
         // Set - I-Frame/P-Frame timestamps
         const auto iFrameTimestamps = _source->getIFrameTimestamps();
         const auto pFrameTimestamps = _source->getPFrameTimestamps();
@@ -130,18 +180,462 @@ bool MediaPlayer::loadFile(const std::string &filename) {
     }
 }
 
+bool MediaPlayer::loadFiles(const std::vector<std::string> &filenames) {
+    if (filenames.size() <= 1) {
+        return !filenames.empty() && loadFile(filenames.front());
+    }
+
+    try {
+        clearPlaylist();
+        unloadSources();
+
+        const auto count = std::min(filenames.size(), MAX_GRID_CHANNELS);
+        _gridRenderer->setChannelCount(count);
+
+        auto config = makeDecoderConfig();
+        // 채널 수만큼 버퍼가 생기므로 read-ahead 를 줄임
+        config.readAheadBytes = GRID_READ_AHEAD_BYTES;
+        // 각 채널은 타일 크기로 변환
+        config.outputWidth = _videoWidth / static_cast<int>(_gridRenderer->getColumns());
+        config.outputHeight = _videoHeight / static_cast<int>(_gridRenderer->getRows());
+        for (size_t i = 0; i < count; ++i) {
+            auto channel = std::make_unique<FileVideoSource>(filenames[i], config);
+            if (const auto proxy = FileVideoSource::findProxyFile(filenames[i]); !proxy.empty()) {
+                channel->setProxy(proxy);
+            }
+            _channels.push_back(std::move(channel));
+        }
+
+        // 채널 수에 맞춰 동기화 관리자 재생성
+        _syncManager = std::make_unique<SyncManager>(count);
+        _focusedChannel = -1;
+        updateChannelPriorities();
+        applyPreRecord();
+
+        _state.currentFile = filenames.front();
+        _state.totalDuration = 0.0;
+        for (const auto &channel: _channels) {
+            _state.totalDuration = std::max(_state.totalDuration, channel->getDuration());
+        }
+        _state.reset();
+
+        // 오디오는 마스터 채널(0)만 재생
+        auto &master = *_channels.front();
+        startAudioThread(master);
+
+        _state.setIFrameTimestamps(master.getIFrameTimestamps());
+        _state.setPFrameTimestamps(master.getPFrameTimestamps());
+
+        return true;
+
+    } catch (const std::exception &e) {
+        std::cerr << "Failed to load files: " << e.what() << "\n";
+        unloadSources();
+        return false;
+    }
+}
+
+bool MediaPlayer::setPlaylist(const std::vector<std::string> &filenames, const size_t startIndex) {
+    if (startIndex >= filenames.size()) {
+        return false;
+    }
+
+    clearPlaylist();
+    if (!openSource(filenames[startIndex], makeDecoderConfig())) {
+        return false;
+    }
+    _playlist = filenames;
+    _playlistIndex = startIndex;
+    prerollNext();
+    return true;
+}
+
+void MediaPlayer::enqueue(const std::string &filename) {
+    // 재생 목록 없이 연 파일이 있으면 그 뒤에 이어서 재생
+    if (_playlist.empty() && _source && !_liveTail) {
+        _playlist.push_back(_state.currentFile);
+        _playlistIndex = 0;
+    }
+    _playlist.push_back(filename);
+    prerollNext();
+}
+
+bool MediaPlayer::playNext() {
+    return _playlistIndex + 1 < _playlist.size() && switchToPlaylistItem(_playlistIndex + 1);
+}
+
+bool MediaPlayer::playPrevious() {
+    return _playlistIndex > 0 && _playlistIndex <= _playlist.size() && switchToPlaylistItem(_playlistIndex - 1);
+}
+
+bool MediaPlayer::switchToPlaylistItem(const size_t index) {
+    if (index >= _playlist.size()) {
+        return false;
+    }
+    const std::string filename = _playlist[index];
+
+    std::unique_ptr<FileVideoSource> next;
+    try {
+        if (_preroll.valid() && _prerollFile == filename) {
+            // 아직 여는 중이면 UI 스레드를 막지 않고 update 에서 완료 후 전환
+            if (_preroll.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                _pendingPlaylistIndex = index;
+                return true;
+            }
+            _prerollFile.clear();
+            next = _preroll.get();
+        } else {
+            next = startPlaylistSource(filename, makeDecoderConfig(), takeWarmSource(filename),
+                                       _renderer ? _renderer->getFrameAllocator() : nullptr);
+        }
+    } catch (const std::exception &e) {
+        // 열 수 없는 항목은 목록에서 제거 (다음 update 에서 그 다음 항목으로 진행)
+        std::cerr << "Failed to open playlist item " << filename << ": " << e.what() << "\n";
+        _pendingPlaylistIndex.reset();
+        _playlist.erase(_playlist.begin() + static_cast<std::ptrdiff_t>(index));
+        if (index < _playlistIndex) {
+            --_playlistIndex;
+        }
+        prerollNext();
+        return false;
+    }
+
+    if (isGridMode()) {
+        unloadSources();
+    }
+    _audioThread.reset();
+    retireSource();
+
+    auto &source = *next;
+    _source = std::move(next);
+    _playlistIndex = index;
+    _pendingPlaylistIndex.reset();
+    attachToRenderer(source);
+    applyPreRecord();
+    _state.currentFile = filename;
+    _state.totalDuration = _source->getDuration();
+    _state.reset();
+    _state.setIFrameTimestamps(_source->getIFrameTimestamps());
+    _state.setPFrameTimestamps(_source->getPFrameTimestamps());
+    startAudioThread(*_source);
+
+    // play() 는 큐를 비우고 디코더를 다시 시작하므로, 미리 디코딩한 큐를 유지한 채 재생 상태로 전환
+    source.restartClock();
+    _syncManager->reset();
+    _clock.reset();
+    _pendingFrames.clear();
+    _state.isPlaying = true;
+    sendPlaybackHint();
+    if (_audioPlayer) {
+        _audioPlayer->resume();
+    }
+    if (_audioThread) {
+        _audioThread->setPlaying(true);
+    }
+    _syncManager->resume();
+
+    prerollNext();
+    return true;
+}
+
+bool MediaPlayer::isPlaylistItemFinished() const {
+    auto *file = dynamic_cast<FileVideoSource *>(_source.get());
+    // 남은 오디오까지 출력 스레드로 넘어간 뒤 전환
+    return file && file->isFinished() && file->getVideoQueue().empty() && file->getAudioQueue().empty();
+}
+
+void MediaPlayer::prerollNext() {
+    if (_playlistIndex + 1 >= _playlist.size()) {
+        return;
+    }
+    const std::string &next = _playlist[_playlistIndex + 1];
+    if (_preroll.valid() && _prerollFile == next) {
+        return;
+    }
+    discardPreroll();
+
+    _prerollFile = next;
+    _preroll = std::async(std::launch::async,
+                          [filename = next, config = makeDecoderConfig(), warm = takeWarmSource(next),
+                           allocator = _renderer ? _renderer->getFrameAllocator() : nullptr]() mutable {
+                              return startPlaylistSource(filename, config, std::move(warm), std::move(allocator));
+                          });
+}
+
+void MediaPlayer::discardPreroll() {
+    if (_preroll.valid()) {
+        // 다시 선택될 수 있으므로 열린 디코더는 warm pool 로 (열기가 끝난 뒤)
+        _retiringPrerolls.emplace_back(_prerollFile, std::move(_preroll));
+        collectRetiredPrerolls();
+    }
+    _prerollFile.clear();
+    _pendingPlaylistIndex.reset();
+}
+
+void MediaPlayer::collectRetiredPrerolls() {
+    for (auto it = _retiringPrerolls.begin(); it != _retiringPrerolls.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        try {
+            addWarmSource(it->first, it->second.get());
+        } catch (const std::exception &e) {
+            std::cerr << "Failed to pre-roll " << it->first << ": " << e.what() << "\n";
+        }
+        it = _retiringPrerolls.erase(it);
+    }
+}
+
+void MediaPlayer::attachToRenderer(FileVideoSource &source) {
+    if (!_renderer) {
+        return;
+    }
+    // pre-roll/warm 소스는 다른 표시 크기로 열렸을 수 있음
+    updateOutputSizes();
+    auto &decoder = source.decoder();
+    _renderer->prepareFrameSize(decoder.getOutputWidth(), decoder.getOutputHeight());
+}
+
+void MediaPlayer::clearPlaylist() {
+    discardPreroll();
+    _playlist.clear();
+    _playlistIndex = 0;
+}
+
+void MediaPlayer::retireSource() {
+    if (!_source) {
+        return;
+    }
+
+    // 녹화는 소스 단위이므로 보관 전에 종료
+    stopRecording();
+
+    if (auto *file = dynamic_cast<FileVideoSource *>(_source.get()); file && !_liveTail) {
+        _source.release();
+        addWarmSource(_state.currentFile, std::unique_ptr<FileVideoSource>(file));
+        return;
+    }
+    _source.reset();
+}
+
+void MediaPlayer::addWarmSource(const std::string &filename, std::unique_ptr<FileVideoSource> source) {
+    source->stop();
+    source->getVideoQueue().clear();
+    source->getAudioQueue().clear();
+
+    _warmPool.emplace_front(filename, std::move(source));
+    while (_warmPool.size() > WARM_POOL_SIZE) {
+        _warmPool.pop_back();
+    }
+}
+
+std::unique_ptr<FileVideoSource> MediaPlayer::takeWarmSource(const std::string &filename) {
+    const auto it = std::find_if(_warmPool.begin(), _warmPool.end(),
+                                 [&filename](const auto &entry) { return entry.first == filename; });
+    if (it == _warmPool.end()) {
+        return nullptr;
+    }
+    auto source = std::move(it->second);
+    _warmPool.erase(it);
+    return source;
+}
+
+IDecoderSource::DecoderConfig MediaPlayer::makeDecoderConfig() const {
+    return Decoder::DecoderConfig{
+            .decoderType = Decoder::DecoderType::SW,
+            .realtimePacing = _realtimePacing,
+            .outputWidth = _videoWidth,
+            .outputHeight = _videoHeight
+    };
+}
+
+void MediaPlayer::updateOutputSizes() {
+    // Transcode 녹화는 디코더 frame tap 에서 원본 크기로 받으므로 표시 크기와 무관
+    if (isGridMode()) {
+        const int tileWidth = _videoWidth / static_cast<int>(_gridRenderer->getColumns());
+        const int tileHeight = _videoHeight / static_cast<int>(_gridRenderer->getRows());
+        for (const auto &channel: _channels) {
+            channel->setOutputSize(tileWidth, tileHeight);
+        }
+    } else if (_source) {
+        _source->setOutputSize(_videoWidth, _videoHeight);
+    }
+}
+
+void MediaPlayer::startAudioThread(IVideoSource &source) {
+    if (!_audioPlayer) {
+        return;
+    }
+
+    _audioThread = std::make_unique<AudioThread>(
+            source.getAudioQueue(),
+            source.getVideoQueue(),
+            *_audioPlayer,
+            *_syncManager,
+            source
+    );
+
+    _audioThread->start();
+}
+
+size_t MediaPlayer::getChannelCount() const {
+    if (isGridMode()) {
+        return _channels.size();
+    }
+    return _source ? 1 : 0;
+}
+
+size_t MediaPlayer::getChannelQueueSize(const size_t channel) const {
+    const auto sources = activeSources();
+    if (channel >= sources.size()) {
+        return 0;
+    }
+
+    size_t size = sources[channel]->getVideoQueue().size();
+    if (isGridMode() && _syncManager) {
+        size += _syncManager->getQueueSize(channel);
+    }
+    return size;
+}
+
+IVideoSource *MediaPlayer::primarySource() const {
+    if (_source) {
+        return _source.get();
+    }
+    return _channels.empty() ? nullptr : _channels.front().get();
+}
+
+void MediaPlayer::setFocusedChannel(const int channel) {
+    if (!isGridMode()) {
+        return;
+    }
+
+    const bool valid = channel >= 0 && static_cast<size_t>(channel) < _channels.size();
+    _focusedChannel = valid ? channel : -1;
+    updateChannelPriorities();
+}
+
+std::vector<SyncManager::ClockEstimate> MediaPlayer::getChannelClockEstimates() const {
+    if (!isGridMode() || !_syncManager) {
+        return {};
+    }
+    return _syncManager->getClockEstimates();
+}
+
+int MediaPlayer::getChannelAt(const double x, const double y, const int width, const int height) const {
+    if (!isGridMode() || !_gridRenderer) {
+        return -1;
+    }
+    return _gridRenderer->tileAt(x, y, width, height);
+}
+
+void MediaPlayer::updateChannelPriorities() {
+    using Priority = IDecoderSource::DecodePriority;
+
+    // 포커스가 없으면 모든 채널 full rate
+    const auto background = _channels.size() > REDUCED_FPS_CHANNEL_LIMIT ? Priority::KeyframeOnly
+                                                                          : Priority::ReducedFps;
+    for (size_t i = 0; i < _channels.size(); ++i) {
+        const bool focused = _focusedChannel < 0 || static_cast<size_t>(_focusedChannel) == i;
+        // 녹화 채널(0)은 포커스와 무관하게 모든 프레임을 디코딩
+        const bool recorded = _isRecording && i == 0;
+        const auto priority = focused || recorded ? Priority::Full : background;
+
+        _channels[i]->setPriority(priority);
+        _syncManager->setChannelRelaxed(i, priority != Priority::Full);
+    }
+
+    // 표시 기준(마스터)은 포커스 채널을 따름
+    const auto master = getMasterChannel();
+    if (_syncManager->getMasterChannel() != master) {
+        _syncManager->setMasterChannel(master);
+        _clock.reset();
+        _pendingFrames.clear();
+    }
+}
+
+size_t MediaPlayer::getMasterChannel() const {
+    const size_t preferred = _focusedChannel >= 0 ? static_cast<size_t>(_focusedChannel) : 0;
+
+    // 기준 채널이 끝나면 아직 출력 중인 채널을 기준으로 (가장 짧은 파일에서 멈추지 않도록)
+    if (preferred < _channels.size() && isChannelFinished(preferred)) {
+        for (size_t i = 0; i < _channels.size(); ++i) {
+            if (!isChannelFinished(i)) {
+                return i;
+            }
+        }
+    }
+    return preferred;
+}
+
+bool MediaPlayer::isChannelFinished(const size_t index) const {
+    auto &channel = *_channels[index];
+    return channel.isFinished() && channel.getVideoQueue().empty() && _syncManager->getQueueSize(index) == 0;
+}
+
+std::vector<IVideoSource *> MediaPlayer::activeSources() const {
+    std::vector<IVideoSource *> sources;
+    if (_source) {
+        sources.push_back(_source.get());
+    }
+    for (const auto &channel: _channels) {
+        sources.push_back(channel.get());
+    }
+    return sources;
+}
+
+void MediaPlayer::unloadSources() {
+    if (!_source && _channels.empty()) {
+        return;
+    }
+
+    stop();
+    _audioThread.reset();
+    retireSource();
+    _liveTail = false;
+    _channels.clear();
+    _pendingFrames.clear();
+
+    if (_renderer) {
+        _renderer->clear();
+    }
+}
+
 void MediaPlayer::play() {
-    if (!_source) return;
+    const auto sources = activeSources();
+    if (sources.empty()) return;
 
     if (!_state.isPlaying) {
-        _source->stop();
-        _source->getVideoQueue().clear();
-        _source->getAudioQueue().clear();
+        // 일시정지에서 재개는 디코더/큐를 그대로 두고 시계만 다시 진행
+        if (_state.isPaused) {
+            resumePlayback();
+            return;
+        }
+
+        for (auto *source: sources) {
+            source->stop();
+            source->getVideoQueue().clear();
+            source->getAudioQueue().clear();
+        }
         _syncManager->reset();
+        _clock.reset();
+        _pendingFrames.clear();
 
-        _source->start();
+        for (auto *source: sources) {
+            source->start();
+        }
         _state.isPlaying = true;
         _state.isPaused = false;
+        sendPlaybackHint();
+        if (_audioPlayer) {
+            _audioPlayer->resume();
+        }
+
+        // grid 모드는 오디오 유무와 관계없이 마스터 채널을 기준으로 동기화 시작
+        if (isGridMode()) {
+            _syncManager->initialize(0.0, 0.0, getMasterChannel());
+        }
 
         if (_audioThread) {
             _audioThread->setPlaying(true);
@@ -155,10 +649,38 @@ void MediaPlayer::pause() {
         _state.isPlaying = false;
         _state.isPaused = true;
 
+        // 디코더는 실행 상태로 두고 출력 시계만 멈춤 (디코딩된 프레임/오디오 유지)
+        sendPlaybackHint();
+        if (_audioPlayer) {
+            _audioPlayer->pause();
+        }
         if (_audioThread) {
             _audioThread->setPlaying(false);
         }
         _syncManager->pause();
+        _clock.pause();
+    }
+}
+
+void MediaPlayer::resumePlayback() {
+    _state.isPlaying = true;
+    _state.isPaused = false;
+
+    sendPlaybackHint();
+    _clock.resume();
+    if (_audioPlayer) {
+        _audioPlayer->resume();
+    }
+    if (_audioThread) {
+        _audioThread->setPlaying(true);
+    }
+    _syncManager->resume();
+}
+
+void MediaPlayer::sendPlaybackHint() const {
+    const PlaybackHint hint{_state.isPlaying, _state.playbackSpeed};
+    for (auto *source: activeSources()) {
+        source->setPlaybackHint(hint);
     }
 }
 
@@ -166,10 +688,10 @@ void MediaPlayer::stop() {
     _state.isPlaying = false;
     _state.isPaused = false;
 
-    if (_source) {
-        _source->stop();
-        _source->getVideoQueue().clear();
-        _source->getAudioQueue().clear();
+    for (auto *source: activeSources()) {
+        source->stop();
+        source->getVideoQueue().clear();
+        source->getAudioQueue().clear();
     }
 
     if (_audioThread) {
@@ -180,6 +702,8 @@ void MediaPlayer::stop() {
         _syncManager->reset();
     }
 
+    _clock.reset();
+    _pendingFrames.clear();
     _state.currentTime = 0.0;
 }
 
@@ -187,27 +711,83 @@ void MediaPlayer::seek(double time) {
     _state.seekTarget = time;
     _state.seekRequested = true;
 
+    if (isGridMode()) {
+        seekChannels(time);
+        return;
+    }
+
     if (_audioThread) {
         _audioThread->requestSeek(time);
     }
 }
 
+void MediaPlayer::seekChannels(const double time) {
+    // 동기화를 멈춘 상태에서 모든 채널에 seek 요청 후 동기화 큐를 일괄 초기화
+    _syncManager->pause();
+    for (auto &channel: _channels) {
+        channel->seek(time);
+    }
+
+    _syncManager->reset();
+    _syncManager->initialize(time, time, getMasterChannel());
+    if (!_state.isPlaying) {
+        _syncManager->pause();
+    }
+
+    _clock.reset();
+    _pendingFrames.clear();
+    _state.currentTime = time;
+    _state.seekRequested = false;
+}
+
 void MediaPlayer::update() {
+    // 일시정지 중에도 전달 (proxy -> 원본 복귀 판단)
+    sendPlaybackHint();
+    collectRetiredPrerolls();
+
+    if (isGridMode()) {
+        updateChannels();
+        return;
+    }
+
     if (!_source) {
         return;
     }
 
+    // live 재생은 기록이 진행되는 만큼 전체 길이가 늘어남
+    if (_liveTail) {
+        _state.totalDuration = _source->getDuration();
+    }
+
+    // 열기를 기다리던 재생 목록 전환
+    if (_pendingPlaylistIndex) {
+        switchToPlaylistItem(*_pendingPlaylistIndex);
+        return;
+    }
+
     if (!_state.isPlaying) {
         return;
     }
 
+    // 재생 목록의 현재 항목을 모두 출력하면 pre-roll 된 다음 항목으로 전환
+    if (_playlistIndex + 1 < _playlist.size() && isPlaylistItemFinished()) {
+        switchToPlaylistItem(_playlistIndex + 1);
+        return;
+    }
+
+    // 오디오 출력이 없으면 오디오 큐를 비워 디코더가 막히지 않게 함
+    if (!_audioThread) {
+        _source->getAudioQueue().clear();
+    }
+
     auto now = std::chrono::steady_clock::now();
-    if (now - _lastFrameTime >= TARGET_FRAME_TIME) {
+    if (!_realtimePacing || now - _lastFrameTime >= TARGET_FRAME_TIME) {
         auto &videoQueue = _source->getVideoQueue();
 
         // 비디오 큐에서 프레임 추출
         if (auto vfOpt = Utils::waitPopOpt(videoQueue, 5)) {
-            const auto vf = std::move(*vfOpt);
+            // 녹화는 디코더 frame tap 에서 받으므로 표시 프레임은 업로드만
+            const VideoFrame &vf = *vfOpt;
             
             if (!_syncManager->isInitialized()) {
                 _syncManager->initialize(vf.pts, vf.pts, 0);
@@ -215,26 +795,15 @@ void MediaPlayer::update() {
 
             _syncManager->setAudioClock(vf.pts);
             
-            _backFBO->bind();
             try {
-                glViewport(0, 0, _videoWidth, _videoHeight);
-                glClearColor(0, 0, 0, 1);
-                glClear(GL_COLOR_BUFFER_BIT);
-
-                _renderer->renderFrame(vf);
-                swapFrameBuffers();
+                _renderer->uploadFrame(vf);
                 _lastFrameTime = now;
+                ++_presentedFrames;
                 
                 _state.currentTime = vf.pts;
-                
-                // Set Record Queue
-                if (_isRecording && _source) {
-                    _source->encodeFrame(vf);
-                }
             } catch (const std::exception &e) {
                 std::cerr << "Error rendering frame: " << e.what() << std::endl;
             }
-            _backFBO->unbind();
         }
     }
 
@@ -244,29 +813,89 @@ void MediaPlayer::update() {
     }
 }
 
-void MediaPlayer::render(const int windowWidth, const int windowHeight, const int controlsHeight) const {
-    // Draw front FBO to screen (비디오를 상단에 표시)
-    glViewport(0, controlsHeight, windowWidth, windowHeight - controlsHeight);
+void MediaPlayer::updateChannels() {
+    if (!_state.isPlaying) {
+        return;
+    }
+
+    // 채널별 디코더 큐 -> SyncManager 채널 큐
+    for (size_t i = 0; i < _channels.size(); ++i) {
+        auto &channel = *_channels[i];
+
+        // seek 처리 전의 프레임은 디코더가 폐기하므로 전달하지 않음
+        if (channel.isSeekPending()) {
+            continue;
+        }
+
+        while (_syncManager->getQueueSize(i) < MAX_FRAME_QUEUE_SIZE) {
+            VideoFrame frame;
+            if (!channel.getVideoQueue().tryPop(frame)) {
+                break;
+            }
+            if (frame.empty()) {
+                continue;
+            }
+            _syncManager->addFrame(std::move(frame), i);
+        }
 
-    _shaderProgram->use();
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, _frontFBO->getTexture());
-    _shaderProgram->setUniform1i("screenTexture", 0);
+        // 마스터 이외 채널의 오디오는 재생하지 않으므로 비워서 디코더가 막히지 않게 함
+        if (i != 0 || !_audioThread) {
+            channel.getAudioQueue().clear();
+        }
 
-    _shaderProgram->drawQuad();
+        // 먼저 끝난 채널은 기다리지 않고 마지막 타일 유지
+        _syncManager->setChannelFinished(i, isChannelFinished(i));
+    }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    glUseProgram(0);
+    // 기준 채널이 끝나면 남은 채널로 기준 전환
+    if (const auto master = getMasterChannel(); _syncManager->getMasterChannel() != master) {
+        _syncManager->setMasterChannel(master);
+        _clock.reset();
+        _pendingFrames.clear();
+    }
 
-    glViewport(0, 0, windowWidth, windowHeight);
+    if (_pendingFrames.empty() && !_syncManager->popSynchronizedFrames(_pendingFrames)) {
+        return;
+    }
+
+    const auto master = _syncManager->getMasterChannel();
+    if (master >= _pendingFrames.size()) {
+        _pendingFrames.clear();
+        return;
+    }
+
+    // 마스터 채널 PTS 기준으로 표시 시점 결정
+    const double masterPts = _pendingFrames[master].pts;
+    if (!_clock.isAnchored()) {
+        _clock.anchor(masterPts);
+    }
+    if (_realtimePacing && !_clock.isDue(masterPts)) {
+        return;
+    }
+
+    for (size_t i = 0; i < _pendingFrames.size(); ++i) {
+        _gridRenderer->updateTile(i, _pendingFrames[i]);
+    }
+    ++_presentedFrames;
+
+    _state.currentTime = masterPts;
+    _pendingFrames.clear();
 }
 
-void MediaPlayer::swapFrameBuffers() {
-    std::swap(_frontFBO, _backFBO);
+void MediaPlayer::render(const int windowWidth, const int windowHeight, const int controlsHeight) const {
+    // 기본 프레임버퍼에 직접 그림 (비디오를 상단에 표시)
+    const int videoAreaHeight = windowHeight - controlsHeight;
+    if (isGridMode()) {
+        _gridRenderer->render(0, controlsHeight, windowWidth, videoAreaHeight);
+    } else if (_source) {
+        _renderer->render(0, controlsHeight, windowWidth, videoAreaHeight);
+    }
+
+    glViewport(0, 0, windowWidth, windowHeight);
 }
 
 bool MediaPlayer::startRecording(const std::string& outputDir) {
-    if (_isRecording || !_source) {
+    if (_isRecording || !primarySource()) {
         return false;
     }
 
@@ -278,7 +907,18 @@ bool MediaPlayer::startRecording(const std::string& outputDir) {
 
         // Record
         _isRecording = true;
-        _source->startRecord();
+        auto options = _recordOptions;
+        if (_retention) {
+            options.onSegmentClosed = [weak = std::weak_ptr<RetentionManager>(_retention)](const std::string &path) {
+                if (const auto retention = weak.lock()) {
+                    retention->addSegment(path);
+                }
+            };
+        }
+        primarySource()->startRecord(options);
+        if (isGridMode()) {
+            updateChannelPriorities();
+        }
 
         std::cout << "Recording started. Output directory: " << outputDir << std::endl;
         return true;
@@ -294,12 +934,14 @@ bool MediaPlayer::startRecording(const std::string& outputDir) {
 
 void MediaPlayer::stopRecording() {
     bool wasRecording = _isRecording.exchange(false);
-    if (!wasRecording || !_source) {
+    if (!wasRecording || !primarySource()) {
         return;
     }
 
-    _source->stopRecord();
-
+    primarySource()->stopRecord();
+    if (isGridMode()) {
+        updateChannelPriorities();
+    }
 
     // Record 버튼 변경
     if (_onRecordingStateChanged) {
@@ -307,6 +949,51 @@ void MediaPlayer::stopRecording() {
     }
 }
 
+std::future<bool> MediaPlayer::exportClip(const double inTime, const double outTime,
+                                          const std::string &outputFile) const {
+    if (_state.currentFile.empty()) {
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+
+    // 재생 중인 디코더와 별도로 파일을 열어 처리
+    return std::async(std::launch::async,
+                      [input = _state.currentFile, keyframes = _state.getIFrameTimestamps(), inTime, outTime, outputFile] {
+                          ClipExporter exporter(input, keyframes);
+                          return exporter.exportClip(inTime, outTime, outputFile);
+                      });
+}
+
+void MediaPlayer::setRecordOptions(const RecordOptions &options) {
+    _recordOptions = options;
+    if (!_isRecording) {
+        applyPreRecord();
+    }
+}
+
+void MediaPlayer::setRetention(const RetentionConfig &config) {
+    if (config.maxTotalBytes == 0 && config.maxAge.count() == 0) {
+        _retention.reset();
+        return;
+    }
+
+    if (_retention) {
+        _retention->setConfig(config);
+        return;
+    }
+    _retention = std::make_shared<RetentionManager>(Recorder::DEFAULT_OUTPUT_DIR, config);
+    _retention->start();
+}
+
+void MediaPlayer::applyPreRecord() const {
+    if (auto *source = primarySource()) {
+        // 압축 패킷 보관은 stream copy 녹화에서만 이어 붙일 수 있음
+        const bool passthrough = _recordOptions.mode == RecordMode::Passthrough;
+        source->setPreRecord(passthrough ? _recordOptions.preRecord : PreRecordConfig{});
+    }
+}
+
 void MediaPlayer::setOnRecordingStateChanged(std::function<void(bool)> cb) {
     _onRecordingStateChanged = std::move(cb);
 }
\ No newline at end of file
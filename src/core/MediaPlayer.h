@@ -2,8 +2,8 @@
 
 #include "../gl_common.h"
 #include "../core/MediaState.h"
-#include "../rendering/VideoFBO.h"
 #include "../rendering/ShaderProgram.h"
+#include "../rendering/GridRenderer.h"
 #include "../threads/AudioThread.h"
 #include "../media/interface/IVideoSource.h"
 #include "../media/VideoRenderer.h"
@@ -13,13 +13,20 @@
 #include "../media/VideoFrame.h"
 #include "../media/AudioFrame.h"
 #include "../media/Encoder.h"
+#include "../media/FileVideoSource.h"
+#include "../media/RetentionManager.h"
+#include "PlaybackClock.h"
 #include <GLFW/glfw3.h>
 #include <memory>
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <deque>
 #include <mutex>
 #include <functional>
+#include <future>
+#include <optional>
+#include <vector>
 
 class MediaPlayer {
 public:
@@ -27,10 +34,60 @@ public:
 
     ~MediaPlayer();
 
-    bool initialize(GLFWwindow *window, int videoWidth, int videoHeight);
+    // enableAudio=false: 오디오 장치 없이 동작 (headless)
+    bool initialize(int videoWidth, int videoHeight, bool enableAudio = true);
+
+    // 비디오 표시 영역 크기 변경 - 디코더가 이 크기(grid 는 타일 크기)로 축소해 변환하도록 다시 전달
+    void setViewSize(int width, int height);
+
+    // false 이면 디코더/표시 모두 실시간 대기 없이 최대 속도로 진행 (load 전에 설정)
+    void setRealtimePacing(bool enabled) { _realtimePacing = enabled; }
+
+    // 텍스처로 업로드된 프레임 수 (grid 모드는 동기화 세트 단위)
+    uint64_t getPresentedFrameCount() const { return _presentedFrames; }
 
     bool loadFile(const std::string &filename);
 
+    // 기록 중인 fragmented MP4 세그먼트를 live edge 에서 latencySeconds 뒤부터 따라 재생
+    // path 가 녹화(또는 세션) 디렉터리이면 가장 최근에 기록 중인 세그먼트를 선택
+    bool loadLive(const std::string &path, double latencySeconds = DEFAULT_LIVE_LATENCY);
+
+    bool isLive() const { return _liveTail; }
+
+    // 재생 목록 (단일 화면) - 재생 중 다음 항목을 백그라운드에서 열어 첫 GOP/오디오까지 미리 디코딩하고
+    // 현재 항목을 모두 출력하면 끊김 없이 전환
+    bool setPlaylist(const std::vector<std::string> &filenames, size_t startIndex = 0);
+
+    void enqueue(const std::string &filename);
+
+    bool playNext();
+
+    bool playPrevious();
+
+    const std::vector<std::string> &getPlaylist() const { return _playlist; }
+
+    size_t getPlaylistIndex() const { return _playlistIndex; }
+
+    // Multi-channel (grid) - 여러 파일을 프레임 단위로 동기화하여 타일로 재생
+    bool loadFiles(const std::vector<std::string> &filenames);
+
+    bool isGridMode() const { return !_channels.empty(); }
+
+    size_t getChannelCount() const;
+
+    size_t getChannelQueueSize(size_t channel) const;
+
+    // 포커스 채널만 full rate, 나머지는 저우선순위로 디코딩 (-1: 포커스 해제)
+    void setFocusedChannel(int channel);
+
+    int getFocusedChannel() const { return _focusedChannel; }
+
+    // 채널별 마스터 대비 clock offset/skew 추정치 (grid 모드)
+    std::vector<SyncManager::ClockEstimate> getChannelClockEstimates() const;
+
+    // 비디오 영역 좌표(좌상단 기준)의 채널 인덱스, 없으면 -1
+    int getChannelAt(double x, double y, int width, int height) const;
+
     // Playback
     void play();
 
@@ -46,7 +103,23 @@ public:
 
     void stopRecording();
 
+    // 현재 파일의 [in, out) 구간을 새 파일로 내보내기 (백그라운드 실행, 경계 GOP 만 재인코딩)
+    std::future<bool> exportClip(double inTime, double outTime, const std::string &outputFile) const;
+
     bool isRecording() const { return _isRecording; }
+
+    // 녹화 모드 / 인코딩 큐 설정 (다음 녹화부터 적용, pre-record 는 즉시 적용)
+    void setRecordOptions(const RecordOptions &options);
+
+    // 녹화 폴더 보관 정책 (오래된 세그먼트를 백그라운드에서 삭제, 두 값 모두 0 이면 해제)
+    void setRetention(const RetentionConfig &config);
+
+    uint64_t getRecordDroppedFrames() const {
+        return primarySource() != nullptr ? primarySource()->getDroppedRecordFrames() : 0;
+    }
+
+    // 모든 녹화 세그먼트 파일의 쓰기 지연/대기 누적 지표
+    static WriteStats getRecordWriteStats() { return SegmentWriter::getGlobalStats(); }
     
     void setOnRecordingStateChanged(std::function<void(bool)> cb);
 
@@ -61,19 +134,89 @@ public:
     MediaState &getState() { return _state; }
 
     double getDuration() {
-        return _source != nullptr ? _source->getDuration() : 0.0;
+        return primarySource() != nullptr ? primarySource()->getDuration() : 0.0;
     }
 
     CodecInfo getCodecInfo() const {
-        return _source != nullptr ? _source->getCodecInfo() : CodecInfo{};
+        return primarySource() != nullptr ? primarySource()->getCodecInfo() : CodecInfo{};
     }
 
+    static constexpr size_t MAX_GRID_CHANNELS = 16;
+    // 이 수를 넘으면 비포커스 채널은 keyframe-only 로 디코딩
+    static constexpr size_t REDUCED_FPS_CHANNEL_LIMIT = 4;
+    static constexpr double DEFAULT_LIVE_LATENCY = 5.0;
+    static constexpr size_t GRID_READ_AHEAD_BYTES = 4 * 1024 * 1024;
+    // 닫은 뒤에도 디코더를 열어 둘 최근 파일 수
+    static constexpr size_t WARM_POOL_SIZE = 2;
+
 private:
-    void initializeQueues();
+    // 단일 파일 모드의 소스 또는 grid 모드의 마스터 채널
+    IVideoSource *primarySource() const;
 
-    void swapFrameBuffers();
+    std::vector<IVideoSource *> activeSources() const;
 
-    bool initializeShaders();
+    IDecoderSource::DecoderConfig makeDecoderConfig() const;
+
+    // 현재 표시 영역/grid 배치에 맞춰 소스별 출력 크기 힌트 갱신
+    void updateOutputSizes();
+
+    // 단일 파일/세션/live 세그먼트 열기
+    bool openSource(const std::string &filename, const IDecoderSource::DecoderConfig &config);
+
+    void startAudioThread(IVideoSource &source);
+
+    // 녹화 대상(primary) 소스에 pre-record 설정 적용
+    void applyPreRecord() const;
+
+    // 일시정지에서 재개 (디코더 재시작 없음)
+    void resumePlayback();
+
+    // 현재 재생 상태를 소스에 전달 (일시정지 시 디코더 출력 시계 정지)
+    void sendPlaybackHint() const;
+
+    void unloadSources();
+
+    // 현재 파일 소스를 정지 상태로 warm pool 에 보관 (live/세션 소스는 해제)
+    void retireSource();
+
+    void addWarmSource(const std::string &filename, std::unique_ptr<FileVideoSource> source);
+
+    std::unique_ptr<FileVideoSource> takeWarmSource(const std::string &filename);
+
+    void clearPlaylist();
+
+    // 재생 목록 항목으로 전환 (pre-roll 또는 warm pool 에 있으면 그대로 사용)
+    bool switchToPlaylistItem(size_t index);
+
+    // 현재 항목 출력이 끝났는지 (디코더 EOF 이후 큐까지 비었을 때)
+    bool isPlaylistItemFinished() const;
+
+    void prerollNext();
+
+    // 끝나지 않은 pre-roll 은 기다리지 않고 _retiringPrerolls 로 넘김
+    void discardPreroll();
+
+    // [Main thread] 열기가 끝난 retired pre-roll 을 warm pool 로 이동
+    void collectRetiredPrerolls();
+
+    // 단일 화면 렌더러에 맞춰 출력 크기/PBO 크기 갱신 (재생 목록 전환 시)
+    void attachToRenderer(FileVideoSource &source);
+
+    void updateChannels();
+
+    void seekChannels(double time);
+
+    void updateChannelPriorities();
+
+    size_t getMasterChannel() const;
+
+    // EOF 이후 디코더/동기화 큐까지 모두 출력한 채널
+    bool isChannelFinished(size_t index) const;
+
+    void initializeQueues();
+
+    // 녹화 중인 encoder 는 weak_ptr 로 참조 (해제 후 닫힌 세그먼트는 등록하지 않음)
+    std::shared_ptr<RetentionManager> _retention;
 
     std::unique_ptr<IVideoSource> _source;
     std::unique_ptr<VideoRenderer> _renderer;
@@ -81,9 +224,23 @@ private:
     std::unique_ptr<SyncManager> _syncManager;
     std::unique_ptr<AudioThread> _audioThread;
 
-    std::unique_ptr<VideoFBO> _frontFBO;
-    std::unique_ptr<VideoFBO> _backFBO;
-    std::unique_ptr<ShaderProgram> _shaderProgram;
+    // Multi-channel (grid)
+    std::vector<std::unique_ptr<FileVideoSource>> _channels;
+    std::unique_ptr<GridRenderer> _gridRenderer;
+    std::vector<VideoFrame> _pendingFrames;
+    PlaybackClock _clock;
+    int _focusedChannel{-1};
+
+    // Playlist
+    std::vector<std::string> _playlist;
+    size_t _playlistIndex{0};
+    std::string _prerollFile;
+    std::future<std::unique_ptr<FileVideoSource>> _preroll;
+    std::vector<std::pair<std::string, std::future<std::unique_ptr<FileVideoSource>>>> _retiringPrerolls;
+    // pre-roll 이 끝나면 전환할 항목 (UI 스레드에서 열기를 기다리지 않음)
+    std::optional<size_t> _pendingPlaylistIndex;
+    // 최근 닫은 파일 소스 (앞쪽이 최근)
+    std::deque<std::pair<std::string, std::unique_ptr<FileVideoSource>>> _warmPool;
 
     MediaState _state;
     ThreadSafeQueue<VideoFrame> _videoQueue;
@@ -91,11 +248,15 @@ private:
 
     std::chrono::steady_clock::time_point _lastFrameTime;
     static constexpr auto TARGET_FRAME_TIME = std::chrono::milliseconds(16);
+    bool _realtimePacing{true};
+    bool _liveTail{false};
+    uint64_t _presentedFrames{0};
 
     int _videoWidth = 0;
     int _videoHeight = 0;
 
     // Record
     std::atomic<bool> _isRecording{false};
+    RecordOptions _recordOptions;
     std::function<void(bool)> _onRecordingStateChanged;
 };
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+
+// 프레젠테이션 클럭: 최초 PTS를 현재 시각에 고정(anchor)하고 경과 시간으로 미디어 시간을 계산
+class PlaybackClock {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void anchor(const double pts) {
+        _anchorPts = pts;
+        _anchorTime = Clock::now();
+        _pausedAt = _anchorTime;
+        _anchored = true;
+    }
+
+    bool isAnchored() const { return _anchored; }
+
+    double now() const {
+        if (!_anchored) {
+            return 0.0;
+        }
+        const auto reference = _paused ? _pausedAt : Clock::now();
+        return _anchorPts + std::chrono::duration<double>(reference - _anchorTime).count();
+    }
+
+    // 해당 PTS의 프레임을 지금 표시해야 하는지 여부
+    bool isDue(const double pts) const { return !_anchored || pts <= now(); }
+
+    void pause() {
+        if (!_paused) {
+            _pausedAt = Clock::now();
+            _paused = true;
+        }
+    }
+
+    void resume() {
+        if (_paused) {
+            // 일시정지 구간만큼 anchor를 이동시켜 미디어 시간을 고정
+            _anchorTime += Clock::now() - _pausedAt;
+            _paused = false;
+        }
+    }
+
+    bool isPaused() const { return _paused; }
+
+    void reset() {
+        _anchored = false;
+        _paused = false;
+        _anchorPts = 0.0;
+    }
+
+private:
+    bool _anchored{false};
+    bool _paused{false};
+    double _anchorPts{0.0};
+    Clock::time_point _anchorTime{};
+    Clock::time_point _pausedAt{};
+};
@@ -1,6 +1,10 @@
 #include "Utils.h"
 #include <iostream>
 #include <cstdio>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <filesystem>
 
 namespace Utils {
     std::string formatTime(double seconds) {
@@ -26,4 +30,13 @@ namespace Utils {
         }
         return files[choice - 1];
     }
-}
\ No newline at end of file
+
+    bool isVideoFile(const std::string &path) {
+        static constexpr std::array<const char *, 6> extensions = {".mp4", ".mkv", ".mov", ".avi", ".ts", ".h264"};
+
+        auto ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+                       [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return std::find(extensions.begin(), extensions.end(), ext) != extensions.end();
+    }
+}
@@ -10,6 +10,8 @@ namespace Utils {
 
     std::string selectVideoFile(const std::vector<std::string> &files);
 
+    bool isVideoFile(const std::string &path);
+
     template<typename T>
     std::optional<T> waitPopOpt(ThreadSafeQueue<T> &queue, int timeoutMs = 10) {
         T item;
@@ -4,5 +4,28 @@
 #define GL_GLEXT_PROTOTYPES
 
 #include <GL/gl.h>
+#include <cstring>
 
-#endif // GL_COMMON_H
\ No newline at end of file
+// 현재 컨텍스트의 GL 버전 확인
+inline bool isGLVersionAtLeast(const int major, const int minor) {
+    GLint currentMajor = 0;
+    GLint currentMinor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &currentMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &currentMinor);
+    return currentMajor > major || (currentMajor == major && currentMinor >= minor);
+}
+
+// 현재 컨텍스트의 확장 지원 여부
+inline bool hasGLExtension(const char *name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const auto *extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // GL_COMMON_H
@@ -1,8 +1,40 @@
 #include "core/Application.h"
+#include "core/HeadlessRunner.h"
+#include <cstring>
 #include <iostream>
 
-int main() {
+namespace {
+    bool hasHeadlessFlag(const int argc, char **argv) {
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--headless") == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int runHeadless(const int argc, char **argv) {
+        HeadlessRunner::Options options;
+        if (!HeadlessRunner::parseArguments(argc, argv, options)) {
+            HeadlessRunner::printUsage();
+            return 2;
+        }
+
+        HeadlessRunner runner(std::move(options));
+        if (!runner.initialize()) {
+            std::cerr << "Failed to initialize headless runner\n";
+            return -1;
+        }
+        return runner.run();
+    }
+}
+
+int main(int argc, char **argv) {
     try {
+        if (hasHeadlessFlag(argc, argv)) {
+            return runHeadless(argc, argv);
+        }
+
         Application app;
 
         if (!app.initialize()) {
@@ -18,4 +50,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <mutex>
@@ -58,17 +59,10 @@ public:
         return pts;
     }
 
-    void pause() const noexcept {
-        if (_stream) {
-            Pa_StopStream(_stream);
-        }
-    }
+    // 스트림은 열어 둔 채 버퍼 소비만 멈춤 (남은 오디오 유지, 재개 시 장치 재시작 없음)
+    void pause() noexcept { _paused = true; }
 
-    void resume() const noexcept {
-        if (_stream) {
-            Pa_StartStream(_stream);
-        }
-    }
+    void resume() noexcept { _paused = false; }
 
 private:
     static int audioCallback(const void * /*inputBuffer*/, void *outputBuffer, const unsigned long framesPerBuffer,
@@ -83,6 +77,11 @@ private:
         const size_t samplesNeeded = framesPerBuffer * _channels;
         size_t samplesWritten = 0;
 
+        if (_paused.load()) {
+            std::fill(out, out + samplesNeeded, 0);
+            return paContinue;
+        }
+
         std::lock_guard<std::mutex> lock(_bufferMutex);
 
         while (samplesWritten < samplesNeeded && !_audioBuffer.empty()) {
@@ -119,4 +118,5 @@ private:
     mutable std::mutex _bufferMutex;
     size_t _currentFrameOffset{0};
     double _lastPlayedPts{0.0};
+    std::atomic<bool> _paused{false};
 };
\ No newline at end of file
@@ -0,0 +1,565 @@
+#include "ClipExporter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include "Encoder.h"
+#include "VideoFrame.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+    int64_t toTimeBase(const double seconds, const AVRational timeBase) {
+        return av_rescale_q(std::llround(seconds * AV_TIME_BASE), AV_TIME_BASE_Q, timeBase);
+    }
+
+    double packetTime(const AVPacket *packet, const AVRational timeBase) {
+        const int64_t ts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+        return ts != AV_NOPTS_VALUE ? static_cast<double>(ts) * av_q2d(timeBase) : -1.0;
+    }
+
+    // 입력 시간축 -> 출력 시간축 (offset 은 출력 time base)
+    void rebasePacket(AVPacket *packet, const AVRational from, const AVRational to, const int64_t offset) {
+        av_packet_rescale_ts(packet, from, to);
+        if (packet->pts != AV_NOPTS_VALUE) {
+            packet->pts += offset;
+        }
+        if (packet->dts != AV_NOPTS_VALUE) {
+            packet->dts += offset;
+        }
+        packet->pos = -1;
+    }
+}
+
+ClipExporter::ClipExporter(std::string inputFile, std::vector<double> keyframes)
+        : _inputFile(std::move(inputFile)), _keyframes(std::move(keyframes)) {
+    std::sort(_keyframes.begin(), _keyframes.end());
+}
+
+ClipExporter::~ClipExporter() {
+    closeOutput(false);
+    closeInput();
+}
+
+bool ClipExporter::exportClip(double inTime, double outTime, const std::string &outputFile) {
+    if (!openInput()) {
+        return false;
+    }
+
+    const AVStream *videoStream = _inCtx->streams[_videoStreamIndex];
+    const double startTime = videoStream->start_time != AV_NOPTS_VALUE
+                             ? static_cast<double>(videoStream->start_time) * av_q2d(videoStream->time_base) : 0.0;
+    const double endTime = _inCtx->duration > 0
+                           ? startTime + static_cast<double>(_inCtx->duration) / AV_TIME_BASE
+                           : std::numeric_limits<double>::infinity();
+    inTime = std::max(inTime, startTime);
+    outTime = std::min(outTime, endTime);
+    if (outTime <= inTime + TIME_EPSILON) {
+        spdlog::error("Invalid clip range: {:.3f}s - {:.3f}s", inTime, outTime);
+        return false;
+    }
+
+    const bool smart = canSmartRender();
+    const auto infinity = std::numeric_limits<double>::infinity();
+    double copyStart = outTime;
+    double copyEnd = outTime;
+
+    if (smart) {
+        // 구간 안 첫 키프레임부터 out 이 속한 GOP 직전까지 stream copy
+        const auto first = std::lower_bound(_keyframes.begin(), _keyframes.end(), inTime - TIME_EPSILON);
+        const auto next = std::lower_bound(_keyframes.begin(), _keyframes.end(), outTime - TIME_EPSILON);
+        if (first != _keyframes.end() && *first < outTime - TIME_EPSILON) {
+            copyStart = *first;
+            if (next != _keyframes.end() && std::abs(*next - outTime) <= TIME_EPSILON) {
+                copyEnd = *next;
+            } else if (next == _keyframes.end() && outTime >= endTime - TIME_EPSILON) {
+                copyEnd = infinity;
+            } else {
+                copyEnd = *(next - 1);
+            }
+        }
+    } else {
+        // 재인코딩 결과와 이어 붙일 수 없는 스트림은 키프레임 경계로 넓혀 stream copy 만 수행
+        const auto before = std::upper_bound(_keyframes.begin(), _keyframes.end(), inTime + TIME_EPSILON);
+        const auto after = std::lower_bound(_keyframes.begin(), _keyframes.end(), outTime - TIME_EPSILON);
+        copyStart = before != _keyframes.begin() ? *(before - 1) : startTime;
+        copyEnd = after != _keyframes.end() ? *after : infinity;
+        spdlog::warn("Smart render unavailable for {}, clip snapped to keyframes {:.3f}s - {:.3f}s",
+                     _inputFile, copyStart, copyEnd);
+        inTime = copyStart;
+        outTime = copyEnd;
+    }
+
+    const fs::path outputPath(outputFile);
+    const fs::path tempDir = outputPath.parent_path() / (".clip_" + outputPath.stem().string());
+    std::error_code ec;
+    fs::remove_all(tempDir, ec);
+
+    _lastVideoDts = AV_NOPTS_VALUE;
+    _lastCopiedPts = -1.0;
+
+    EncodedPart head;
+    EncodedPart tail;
+    bool ok = true;
+    if (smart && copyStart > inTime + TIME_EPSILON) {
+        ok = encodeRange(inTime, copyStart, (tempDir / "head").string(), head);
+    }
+
+    ok = ok && openOutput(outputFile);
+    ok = ok && writeEncodedPart(head, inTime);
+    // 재인코딩 구간 뒤에는 원본 SPS/PPS 를 다시 넣어 디코더가 원본 파라미터로 돌아가게 함
+    ok = ok && copyPackets(inTime, outTime, copyStart, copyEnd, !head.file.empty());
+
+    if (ok && smart) {
+        // 마지막으로 복사한 프레임 이후 ~ out 재인코딩
+        const double tailStart = _lastCopiedPts >= 0.0 ? _lastCopiedPts + frameDuration() / 2.0 : copyStart;
+        if (tailStart < outTime - TIME_EPSILON) {
+            ok = encodeRange(tailStart, outTime, (tempDir / "tail").string(), tail) &&
+                 writeEncodedPart(tail, inTime);
+        }
+    }
+
+    closeOutput(ok);
+    fs::remove_all(tempDir, ec);
+    if (!ok) {
+        fs::remove(outputPath, ec);
+        spdlog::error("Clip export failed: {}", outputFile);
+        return false;
+    }
+
+    spdlog::info("Clip exported: {} ({:.3f}s - {:.3f}s, re-encoded head {}, tail {})", outputFile, inTime, outTime,
+                 !head.file.empty(), !tail.file.empty());
+    return true;
+}
+
+bool ClipExporter::openInput() {
+    closeInput();
+
+    if (avformat_open_input(&_inCtx, _inputFile.c_str(), nullptr, nullptr) < 0) {
+        spdlog::error("Could not open input for clip export: {}", _inputFile);
+        return false;
+    }
+    if (avformat_find_stream_info(_inCtx, nullptr) < 0) {
+        spdlog::error("Could not read stream info: {}", _inputFile);
+        closeInput();
+        return false;
+    }
+
+    _videoStreamIndex = av_find_best_stream(_inCtx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    _audioStreamIndex = av_find_best_stream(_inCtx, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+    if (_videoStreamIndex < 0) {
+        spdlog::error("No video stream in {}", _inputFile);
+        closeInput();
+        return false;
+    }
+    return true;
+}
+
+void ClipExporter::closeInput() {
+    if (_inCtx) {
+        avformat_close_input(&_inCtx);
+    }
+    _videoStreamIndex = -1;
+    _audioStreamIndex = -1;
+}
+
+bool ClipExporter::canSmartRender() const {
+    // Encoder 출력(H.264 YUV420P, avcC 4-byte NAL 길이)과 같은 형식이어야 SPS/PPS 교체만으로 이어 붙일 수 있음
+    const AVCodecParameters *params = _inCtx->streams[_videoStreamIndex]->codecpar;
+    if (params->codec_id != AV_CODEC_ID_H264 || _keyframes.empty()) {
+        return false;
+    }
+    if (params->format != AV_PIX_FMT_YUV420P && params->format != AV_PIX_FMT_YUVJ420P) {
+        return false;
+    }
+    return params->extradata_size >= 7 && params->extradata[0] == 1 && (params->extradata[4] & 0x03) == 0x03;
+}
+
+bool ClipExporter::encodeRange(const double from, const double to, const std::string &dir, EncodedPart &part) {
+    const AVStream *stream = _inCtx->streams[_videoStreamIndex];
+    const AVCodec *codec = avcodec_find_decoder(stream->codecpar->codec_id);
+    auto codecDeleter = [](AVCodecContext *ctx) { avcodec_free_context(&ctx); };
+    std::unique_ptr<AVCodecContext, decltype(codecDeleter)> decCtx(avcodec_alloc_context3(codec), codecDeleter);
+    if (!codec || !decCtx || avcodec_parameters_to_context(decCtx.get(), stream->codecpar) < 0) {
+        spdlog::error("Could not create decoder for clip export");
+        return false;
+    }
+    decCtx->pkt_timebase = stream->time_base;
+    if (avcodec_open2(decCtx.get(), codec, nullptr) < 0) {
+        spdlog::error("Could not open decoder for clip export");
+        return false;
+    }
+
+    const int width = stream->codecpar->width;
+    const int height = stream->codecpar->height;
+    const int fps = static_cast<int>(std::lround(1.0 / frameDuration()));
+
+    // 원본 화질에 가깝게 (경계 GOP 만 인코딩하므로 속도 영향 작음)
+    EncoderConfig config;
+    config.preset = "medium";
+    config.crf = CLIP_CRF;
+    config.adaptivePreset = false;
+    Encoder encoder(dir, CLIP_SEGMENT_DURATION, Encoder::OutputFormat::MP4);
+    if (!encoder.initialize(width, height, fps, config)) {
+        spdlog::error("Could not initialize encoder for clip export");
+        return false;
+    }
+
+    const int64_t seekTarget = static_cast<int64_t>(std::floor(from / av_q2d(stream->time_base)));
+    if (av_seek_frame(_inCtx, _videoStreamIndex, seekTarget, AVSEEK_FLAG_BACKWARD) < 0) {
+        spdlog::error("Could not seek to {:.3f}s for clip export", from);
+        encoder.finalize();
+        return false;
+    }
+
+    auto packetDeleter = [](AVPacket *p) { av_packet_free(&p); };
+    auto frameDeleter = [](AVFrame *f) { av_frame_free(&f); };
+    std::unique_ptr<AVPacket, decltype(packetDeleter)> packet(av_packet_alloc(), packetDeleter);
+    std::unique_ptr<AVFrame, decltype(frameDeleter)> frame(av_frame_alloc(), frameDeleter);
+    SwsContext *swsCtx = nullptr;
+    int frameCount = 0;
+    bool done = false;
+
+    // 디코딩된 프레임 중 [from, to) 만 인코더로 전달, to 에 도달하면 true
+    auto receiveFrames = [&]() {
+        while (avcodec_receive_frame(decCtx.get(), frame.get()) >= 0) {
+            const int64_t ts = frame->best_effort_timestamp;
+            const double t = ts != AV_NOPTS_VALUE ? static_cast<double>(ts) * av_q2d(stream->time_base) : -1.0;
+            if (t >= to - TIME_EPSILON) {
+                av_frame_unref(frame.get());
+                return true;
+            }
+            if (t >= from - TIME_EPSILON) {
+                auto output = std::make_shared<VideoFrame>();
+                output->width = width;
+                output->height = height;
+                output->pts = t;
+                output->format = VideoFrame::PixelFormat::YUV420P;
+                output->data.resize(av_image_get_buffer_size(AV_PIX_FMT_YUV420P, width, height, 1));
+
+                swsCtx = sws_getCachedContext(swsCtx, frame->width, frame->height,
+                                              static_cast<AVPixelFormat>(frame->format),
+                                              width, height, AV_PIX_FMT_YUV420P, SWS_BICUBIC,
+                                              nullptr, nullptr, nullptr);
+                uint8_t *dst[4];
+                int dstLinesize[4];
+                av_image_fill_arrays(dst, dstLinesize, output->data.data(), AV_PIX_FMT_YUV420P, width, height, 1);
+                if (swsCtx) {
+                    sws_scale(swsCtx, frame->data, frame->linesize, 0, frame->height, dst, dstLinesize);
+                    if (frameCount++ == 0) {
+                        part.startTime = t;
+                    }
+                    encoder.encodeFrame(output);
+                }
+            }
+            av_frame_unref(frame.get());
+        }
+        return false;
+    };
+
+    while (!done && av_read_frame(_inCtx, packet.get()) >= 0) {
+        if (packet->stream_index == _videoStreamIndex && avcodec_send_packet(decCtx.get(), packet.get()) >= 0) {
+            done = receiveFrames();
+        }
+        av_packet_unref(packet.get());
+    }
+    if (!done) {
+        avcodec_send_packet(decCtx.get(), nullptr);
+        receiveFrames();
+    }
+
+    sws_freeContext(swsCtx);
+    encoder.finalize();
+
+    if (frameCount == 0) {
+        return true;
+    }
+
+    // 세그먼트 하나만 기록되므로 디렉터리의 파일이 결과
+    std::error_code ec;
+    for (const auto &entry: fs::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file()) {
+            part.file = entry.path().string();
+            break;
+        }
+    }
+    if (part.file.empty()) {
+        spdlog::error("Encoded clip part not found in {}", dir);
+        return false;
+    }
+    return true;
+}
+
+bool ClipExporter::openOutput(const std::string &outputFile) {
+    if (avformat_alloc_output_context2(&_outCtx, nullptr, nullptr, outputFile.c_str()) < 0 || !_outCtx) {
+        spdlog::error("Could not create output context for {}", outputFile);
+        return false;
+    }
+
+    const AVStream *inVideo = _inCtx->streams[_videoStreamIndex];
+    if (avformat_query_codec(_outCtx->oformat, inVideo->codecpar->codec_id, FF_COMPLIANCE_NORMAL) != 1) {
+        spdlog::error("Container of {} does not support the source video codec", outputFile);
+        return false;
+    }
+
+    _outVideo = avformat_new_stream(_outCtx, nullptr);
+    if (!_outVideo || avcodec_parameters_copy(_outVideo->codecpar, inVideo->codecpar) < 0) {
+        return false;
+    }
+    _outVideo->codecpar->codec_tag = 0;
+    _outVideo->time_base = inVideo->time_base;
+
+    if (_audioStreamIndex >= 0) {
+        const AVStream *inAudio = _inCtx->streams[_audioStreamIndex];
+        if (avformat_query_codec(_outCtx->oformat, inAudio->codecpar->codec_id, FF_COMPLIANCE_NORMAL) == 1) {
+            _outAudio = avformat_new_stream(_outCtx, nullptr);
+            if (!_outAudio || avcodec_parameters_copy(_outAudio->codecpar, inAudio->codecpar) < 0) {
+                return false;
+            }
+            _outAudio->codecpar->codec_tag = 0;
+            _outAudio->time_base = inAudio->time_base;
+        } else {
+            spdlog::warn("Container of {} does not support the source audio codec, audio skipped", outputFile);
+        }
+    }
+
+    if (!(_outCtx->oformat->flags & AVFMT_NOFILE) &&
+        avio_open(&_outCtx->pb, outputFile.c_str(), AVIO_FLAG_WRITE) < 0) {
+        spdlog::error("Could not open output file {}", outputFile);
+        return false;
+    }
+
+    if (avformat_write_header(_outCtx, nullptr) < 0) {
+        spdlog::error("Error writing header for {}", outputFile);
+        return false;
+    }
+    _headerWritten = true;
+    return true;
+}
+
+void ClipExporter::closeOutput(const bool writeTrailer) {
+    if (!_outCtx) {
+        return;
+    }
+
+    if (_headerWritten && writeTrailer) {
+        av_write_trailer(_outCtx);
+    }
+    if (!(_outCtx->oformat->flags & AVFMT_NOFILE)) {
+        avio_closep(&_outCtx->pb);
+    }
+    avformat_free_context(_outCtx);
+    _outCtx = nullptr;
+    _outVideo = nullptr;
+    _outAudio = nullptr;
+    _headerWritten = false;
+}
+
+bool ClipExporter::writeEncodedPart(const EncodedPart &part, const double inTime) {
+    if (part.file.empty()) {
+        return true;
+    }
+
+    AVFormatContext *ctx = nullptr;
+    if (avformat_open_input(&ctx, part.file.c_str(), nullptr, nullptr) < 0) {
+        spdlog::error("Could not open encoded clip part {}", part.file);
+        return false;
+    }
+    const int streamIndex = avformat_find_stream_info(ctx, nullptr) >= 0
+                            ? av_find_best_stream(ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0) : -1;
+    if (streamIndex < 0) {
+        avformat_close_input(&ctx);
+        return false;
+    }
+
+    // 인코더 SPS/PPS 를 첫 키프레임 앞에 넣어 출력 헤더(원본 avcC)와 관계없이 디코딩되게 함
+    const AVStream *stream = ctx->streams[streamIndex];
+    const auto nalus = parameterSetNalus(stream->codecpar);
+    const int64_t base = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+    const int64_t offset = toTimeBase(part.startTime - inTime, _outVideo->time_base) -
+                           av_rescale_q(base, stream->time_base, _outVideo->time_base);
+
+    auto packetDeleter = [](AVPacket *p) { av_packet_free(&p); };
+    std::unique_ptr<AVPacket, decltype(packetDeleter)> packet(av_packet_alloc(), packetDeleter);
+    bool first = true;
+    bool ok = true;
+    while (ok && av_read_frame(ctx, packet.get()) >= 0) {
+        if (packet->stream_index == streamIndex) {
+            if (first) {
+                ok = prependNalus(packet.get(), nalus);
+            }
+            rebasePacket(packet.get(), stream->time_base, _outVideo->time_base, offset);
+            packet->stream_index = _outVideo->index;
+            ok = ok && writeVideoPacket(packet.get(), first);
+            first = false;
+        }
+        av_packet_unref(packet.get());
+    }
+
+    avformat_close_input(&ctx);
+    return ok;
+}
+
+bool ClipExporter::copyPackets(const double inTime, const double outTime, const double copyStart,
+                               const double copyEnd, const bool prependParameterSets) {
+    const AVStream *videoStream = _inCtx->streams[_videoStreamIndex];
+    const AVStream *audioStream = _outAudio ? _inCtx->streams[_audioStreamIndex] : nullptr;
+
+    const double seekTime = std::min(inTime, copyStart);
+    const int64_t seekTarget = static_cast<int64_t>(std::floor(seekTime / av_q2d(videoStream->time_base)));
+    if (av_seek_frame(_inCtx, _videoStreamIndex, seekTarget, AVSEEK_FLAG_BACKWARD) < 0) {
+        spdlog::error("Could not seek to {:.3f}s for clip export", seekTime);
+        return false;
+    }
+
+    const auto nalus = prependParameterSets ? parameterSetNalus(videoStream->codecpar) : std::vector<uint8_t>{};
+    const int64_t videoOffset = toTimeBase(-inTime, _outVideo->time_base);
+    const int64_t audioOffset = _outAudio ? toTimeBase(-inTime, _outAudio->time_base) : 0;
+
+    auto packetDeleter = [](AVPacket *p) { av_packet_free(&p); };
+    std::unique_ptr<AVPacket, decltype(packetDeleter)> packet(av_packet_alloc(), packetDeleter);
+    bool copying = false;
+    bool firstCopied = true;
+    bool videoDone = copyEnd <= copyStart + TIME_EPSILON;
+    bool audioDone = audioStream == nullptr;
+    bool ok = true;
+
+    while (ok && !(videoDone && audioDone) && av_read_frame(_inCtx, packet.get()) >= 0) {
+        if (packet->stream_index == _videoStreamIndex && !videoDone) {
+            const double t = packetTime(packet.get(), videoStream->time_base);
+            const bool key = packet->flags & AV_PKT_FLAG_KEY;
+            if (key && t >= copyEnd - TIME_EPSILON) {
+                videoDone = true;
+            } else {
+                if (!copying && key && t >= copyStart - TIME_EPSILON) {
+                    copying = true;
+                }
+                // 열린 GOP 의 선행 B 프레임은 이전 GOP 를 참조하므로 제외 (경계 재인코딩 구간에 포함됨)
+                if (copying && t >= copyStart - TIME_EPSILON) {
+                    if (firstCopied) {
+                        ok = prependNalus(packet.get(), nalus);
+                    }
+                    _lastCopiedPts = std::max(_lastCopiedPts, t);
+                    rebasePacket(packet.get(), videoStream->time_base, _outVideo->time_base, videoOffset);
+                    packet->stream_index = _outVideo->index;
+                    ok = ok && writeVideoPacket(packet.get(), firstCopied);
+                    firstCopied = false;
+                }
+            }
+        } else if (audioStream && packet->stream_index == _audioStreamIndex && !audioDone) {
+            const double t = packetTime(packet.get(), audioStream->time_base);
+            if (t >= outTime - TIME_EPSILON) {
+                audioDone = true;
+            } else if (t >= inTime - TIME_EPSILON) {
+                rebasePacket(packet.get(), audioStream->time_base, _outAudio->time_base, audioOffset);
+                packet->stream_index = _outAudio->index;
+                if (av_interleaved_write_frame(_outCtx, packet.get()) < 0) {
+                    spdlog::error("Error writing audio packet for clip export");
+                    ok = false;
+                }
+            }
+        }
+        av_packet_unref(packet.get());
+    }
+
+    return ok;
+}
+
+bool ClipExporter::writeVideoPacket(AVPacket *packet, const bool partStart) {
+    // 재인코딩/복사 구간의 B 프레임 지연이 달라 경계에서 DTS 가 겹치면 구간 전체를 뒤로 이동
+    if (partStart) {
+        _partDtsShift = 0;
+        if (_lastVideoDts != AV_NOPTS_VALUE && packet->dts != AV_NOPTS_VALUE && packet->dts <= _lastVideoDts) {
+            _partDtsShift = _lastVideoDts + 1 - packet->dts;
+        }
+    }
+    if (packet->pts != AV_NOPTS_VALUE) {
+        packet->pts += _partDtsShift;
+    }
+    if (packet->dts != AV_NOPTS_VALUE) {
+        packet->dts += _partDtsShift;
+        if (_lastVideoDts != AV_NOPTS_VALUE && packet->dts <= _lastVideoDts) {
+            packet->dts = _lastVideoDts + 1;
+        }
+        _lastVideoDts = packet->dts;
+    }
+
+    if (av_interleaved_write_frame(_outCtx, packet) < 0) {
+        spdlog::error("Error writing video packet for clip export");
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> ClipExporter::parameterSetNalus(const AVCodecParameters *params) {
+    std::vector<uint8_t> nalus;
+    if (!params || params->extradata_size < 7 || params->extradata[0] != 1) {
+        return nalus;
+    }
+
+    // avcC: [version, profile, compat, level, nal length size, sps count, (len, sps)..., pps count, (len, pps)...]
+    const uint8_t *p = params->extradata + 5;
+    const uint8_t *end = params->extradata + params->extradata_size;
+    auto appendSets = [&](const int count) {
+        for (int i = 0; i < count; ++i) {
+            if (end - p < 2) {
+                return false;
+            }
+            const int length = (p[0] << 8) | p[1];
+            p += 2;
+            if (end - p < length) {
+                return false;
+            }
+            nalus.push_back(static_cast<uint8_t>(length >> 24));
+            nalus.push_back(static_cast<uint8_t>(length >> 16));
+            nalus.push_back(static_cast<uint8_t>(length >> 8));
+            nalus.push_back(static_cast<uint8_t>(length));
+            nalus.insert(nalus.end(), p, p + length);
+            p += length;
+        }
+        return true;
+    };
+
+    const int spsCount = *p++ & 0x1f;
+    if (!appendSets(spsCount) || p >= end) {
+        return {};
+    }
+    const int ppsCount = *p++;
+    if (!appendSets(ppsCount)) {
+        return {};
+    }
+    return nalus;
+}
+
+bool ClipExporter::prependNalus(AVPacket *packet, const std::vector<uint8_t> &nalus) {
+    if (nalus.empty()) {
+        return true;
+    }
+
+    AVPacket *merged = av_packet_alloc();
+    if (!merged || av_new_packet(merged, static_cast<int>(nalus.size()) + packet->size) < 0) {
+        av_packet_free(&merged);
+        return false;
+    }
+    std::memcpy(merged->data, nalus.data(), nalus.size());
+    std::memcpy(merged->data + nalus.size(), packet->data, packet->size);
+    av_packet_copy_props(merged, packet);
+
+    av_packet_unref(packet);
+    av_packet_move_ref(packet, merged);
+    av_packet_free(&merged);
+    return true;
+}
+
+double ClipExporter::frameDuration() const {
+    const AVRational rate = _inCtx->streams[_videoStreamIndex]->avg_frame_rate;
+    return rate.num > 0 && rate.den > 0 ? av_q2d(av_inv_q(rate)) : 1.0 / DEFAULT_FPS;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+// 파일의 [in, out) 구간을 새 파일로 내보내기 (smart render)
+// 구간 안쪽의 온전한 GOP 는 stream copy, in/out 경계의 부분 GOP 만 Encoder 로 재인코딩
+class ClipExporter {
+public:
+    // keyframes: 원본 비디오 키프레임 PTS (초, Decoder::getIFrameTimestamps)
+    ClipExporter(std::string inputFile, std::vector<double> keyframes);
+
+    ~ClipExporter();
+
+    ClipExporter(const ClipExporter &) = delete;
+
+    ClipExporter &operator=(const ClipExporter &) = delete;
+
+    // 실패 시 false (출력 파일은 삭제)
+    bool exportClip(double inTime, double outTime, const std::string &outputFile);
+
+private:
+    // 재인코딩한 경계 구간 (Encoder 가 기록한 임시 파일)
+    struct EncodedPart {
+        std::string file;
+        double startTime{0.0};      // 첫 프레임의 원본 PTS
+    };
+
+    bool openInput();
+
+    void closeInput();
+
+    // 재인코딩한 구간과 이어 붙일 수 있는 스트림인지 (H.264 4:2:0, 4-byte NAL 길이)
+    bool canSmartRender() const;
+
+    // from <= pts < to 인 프레임을 디코딩해 Encoder 로 임시 파일에 기록 (프레임이 없으면 file 이 비어 있음)
+    bool encodeRange(double from, double to, const std::string &dir, EncodedPart &part);
+
+    bool openOutput(const std::string &outputFile);
+
+    void closeOutput(bool writeTrailer);
+
+    bool writeEncodedPart(const EncodedPart &part, double inTime);
+
+    // [copyStart, copyEnd) 키프레임 구간의 비디오와 [inTime, outTime) 오디오를 stream copy
+    bool copyPackets(double inTime, double outTime, double copyStart, double copyEnd, bool prependParameterSets);
+
+    // 출력 비디오 패킷 기록 (구간 시작 시 DTS 가 역행하지 않도록 이동)
+    bool writeVideoPacket(AVPacket *packet, bool partStart);
+
+    // avcC extradata 의 SPS/PPS 를 4-byte 길이 접두 NAL 로 변환
+    static std::vector<uint8_t> parameterSetNalus(const AVCodecParameters *params);
+
+    static bool prependNalus(AVPacket *packet, const std::vector<uint8_t> &nalus);
+
+    double frameDuration() const;
+
+    std::string _inputFile;
+    std::vector<double> _keyframes;
+
+    AVFormatContext *_inCtx{nullptr};
+    int _videoStreamIndex{-1};
+    int _audioStreamIndex{-1};
+
+    AVFormatContext *_outCtx{nullptr};
+    AVStream *_outVideo{nullptr};
+    AVStream *_outAudio{nullptr};
+    bool _headerWritten{false};
+    int64_t _lastVideoDts{AV_NOPTS_VALUE};
+    int64_t _partDtsShift{0};
+    double _lastCopiedPts{-1.0};
+
+    static constexpr double TIME_EPSILON = 0.001;
+    static constexpr int CLIP_SEGMENT_DURATION = 24 * 60 * 60;     // 경계 구간이 세그먼트로 나뉘지 않도록
+    static constexpr int CLIP_CRF = 18;
+    static constexpr int DEFAULT_FPS = 30;
+};
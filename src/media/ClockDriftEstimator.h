@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+
+// 채널 PTS 와 마스터 PTS 의 차이(delta)를 마스터 PTS 에 대해 선형 회귀하여 offset/skew 추정
+// delta(t) = offset + skew * (t - meanPts)
+class ClockDriftEstimator {
+public:
+    explicit ClockDriftEstimator(const size_t windowSize = DEFAULT_WINDOW_SIZE)
+            : _windowSize(windowSize) {
+    }
+
+    void addSample(const double masterPts, const double channelPts) {
+        const double delta = channelPts - masterPts;
+
+        // 수렴 후 추정치에서 크게 벗어난 샘플은 잘못된 매칭으로 보고 제외 (연속되면 addUnmatched 에서 다시 맞춤)
+        if (isConverged() && std::abs(delta - predictDelta(masterPts)) > OUTLIER_THRESHOLD_SEC) {
+            ++_consecutiveOutliers;
+            return;
+        }
+        _consecutiveOutliers = 0;
+
+        _samples.push_back({masterPts, delta});
+        if (_samples.size() > _windowSize) {
+            _samples.pop_front();
+        }
+        _lastMasterPts = masterPts;
+
+        fit();
+    }
+
+    // 매칭 허용 오차 밖의 가장 가까운 프레임 (매칭 실패 시 window 로 걸러지기 전에 전달)
+    // 샘플이 없으면 이 차이로 offset 을 바로 맞추고(acquisition), 연속으로 벗어나면 불연속으로 보고 다시 맞춤
+    // 다시 맞췄으면 true (이 프레임을 매칭으로 사용 가능)
+    bool addUnmatched(const double masterPts, const double channelPts) {
+        if (!_samples.empty() && ++_consecutiveOutliers < MAX_CONSECUTIVE_OUTLIERS) {
+            return false;
+        }
+        reset();
+        _samples.push_back({masterPts, channelPts - masterPts});
+        _lastMasterPts = masterPts;
+        fit();
+        return true;
+    }
+
+    // 채널 PTS 를 마스터 시간축으로 보정
+    double correct(const double channelPts) const {
+        if (_samples.empty()) {
+            return channelPts;
+        }
+        return (channelPts - _meanDelta + _skew * _meanPts) / (1.0 + _skew);
+    }
+
+    double predictDelta(const double masterPts) const {
+        return _samples.empty() ? 0.0 : _meanDelta + _skew * (masterPts - _meanPts);
+    }
+
+    // 현재(마지막 샘플) 시점의 offset (초)
+    double getOffset() const { return predictDelta(_lastMasterPts); }
+
+    double getSkew() const { return _skew; }
+
+    // 회귀 잔차 표준편차 (초)
+    double getResidual() const { return _residual; }
+
+    size_t getSampleCount() const { return _samples.size(); }
+
+    bool isConverged() const { return _samples.size() >= MIN_SAMPLES; }
+
+    void reset() {
+        _samples.clear();
+        _meanPts = 0.0;
+        _meanDelta = 0.0;
+        _skew = 0.0;
+        _residual = 0.0;
+        _lastMasterPts = 0.0;
+        _consecutiveOutliers = 0;
+    }
+
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 300;
+    static constexpr size_t MIN_SAMPLES = 30;
+    static constexpr double OUTLIER_THRESHOLD_SEC = 0.1;
+    static constexpr size_t MAX_CONSECUTIVE_OUTLIERS = 30;
+
+private:
+    struct Sample {
+        double masterPts;
+        double delta;
+    };
+
+    void fit() {
+        const auto n = static_cast<double>(_samples.size());
+
+        double sumPts = 0.0;
+        double sumDelta = 0.0;
+        for (const auto &sample: _samples) {
+            sumPts += sample.masterPts;
+            sumDelta += sample.delta;
+        }
+        _meanPts = sumPts / n;
+        _meanDelta = sumDelta / n;
+
+        // 평균을 뺀 값으로 계산 (PTS 가 큰 경우 정밀도 유지)
+        double sxx = 0.0;
+        double sxy = 0.0;
+        for (const auto &sample: _samples) {
+            const double dx = sample.masterPts - _meanPts;
+            sxx += dx * dx;
+            sxy += dx * (sample.delta - _meanDelta);
+        }
+        _skew = (sxx > MIN_PTS_VARIANCE) ? sxy / sxx : 0.0;
+
+        double sse = 0.0;
+        for (const auto &sample: _samples) {
+            const double error = sample.delta - predictDelta(sample.masterPts);
+            sse += error * error;
+        }
+        _residual = std::sqrt(sse / n);
+    }
+
+    static constexpr double MIN_PTS_VARIANCE = 1e-6;
+
+    const size_t _windowSize;
+    std::deque<Sample> _samples;
+
+    double _meanPts{0.0};
+    double _meanDelta{0.0};
+    double _skew{0.0};
+    double _residual{0.0};
+    double _lastMasterPts{0.0};
+    size_t _consecutiveOutliers{0};
+};
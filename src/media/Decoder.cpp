@@ -7,20 +7,32 @@
 #include <utility>
 
 #include "AudioPlayer.h"
+#include "LiveFileInput.h"
+#include "ProbeCache.h"
+#include "ReadAheadInput.h"
 #include "VideoRenderer.h"
 
 Decoder::Decoder(std::string file, DecoderConfig config) : filename(std::move(file)), _config(std::move(config)) {
+    _requestedPriority = _config.priority;
+    _appliedPriority = _config.priority;
+    _outputWidth = _config.outputWidth;
+    _outputHeight = _config.outputHeight;
+
     initializeFFmpeg();
 
     openInputFile();
 
     findStreams();
 
-    scanFrameTypes();
+    if (_config.scanFrameTypes) {
+        scanFrameTypes();
+    }
 
     initializeVideoDecoder();
 
-    initializeAudioDecoder();
+    if (_config.enableAudio) {
+        initializeAudioDecoder();
+    }
 
     initializeCodecInfo();
 }
@@ -30,15 +42,49 @@ Decoder::~Decoder() { cleanup(); }
 void Decoder::initializeFFmpeg() { avformat_network_init(); }
 
 void Decoder::openInputFile() {
+    AVIOContext *customIO = nullptr;
+    if (_config.liveTail) {
+        // 기록 중인 파일은 끝이 계속 늘어나므로 전체 패킷 스캔을 하지 않음
+        _config.scanFrameTypes = false;
+        _liveInput = std::make_unique<LiveFileInput>(filename, _config.liveLatency);
+        customIO = _liveInput->context();
+    } else if (_config.readAheadBytes > 0 && ReadAheadInput::isLocalFile(filename)) {
+        // 디코딩 스레드에서 작은 동기 read 를 하지 않도록 전용 I/O 스레드가 미리 읽음
+        _readAhead = std::make_unique<ReadAheadInput>(filename, _config.readAheadBytes);
+        customIO = _readAhead->context();
+    }
+
+    if (customIO) {
+        _fmtCtx = avformat_alloc_context();
+        if (!_fmtCtx) {
+            throw std::runtime_error("Failed to allocate format context");
+        }
+        _fmtCtx->pb = customIO;
+        _fmtCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+    }
+
     const auto result = avformat_open_input(&_fmtCtx, filename.c_str(), nullptr, nullptr);
     if (result < 0) {
         throw std::runtime_error("Failed to open input file");
     }
 
+    // 같은 파일을 다시 열면 저장된 probe 결과로 stream info 스캔 생략
+    if (!_config.liveTail) {
+        _probeKey = ProbeCache::fileKey(filename);
+    }
+    if (_probeKey && ProbeCache::instance().restore(*_probeKey, _fmtCtx)) {
+        return;
+    }
+
+    ProbeCache::tuneProbeLimits(_fmtCtx);
     const auto streamInfoResult = avformat_find_stream_info(_fmtCtx, nullptr);
     if (streamInfoResult < 0) {
         throw std::runtime_error("Failed to get stream info");
     }
+
+    if (_probeKey) {
+        ProbeCache::instance().store(*_probeKey, _fmtCtx);
+    }
 }
 
 void Decoder::findStreams() {
@@ -61,8 +107,24 @@ void Decoder::scanFrameTypes() {
         return;
     }
 
+    if (_probeKey) {
+        std::vector<double> iFrames;
+        std::vector<double> pFrames;
+        if (ProbeCache::instance().getFrameTypes(*_probeKey, iFrames, pFrames)) {
+            std::lock_guard<std::mutex> lock1(_iFrameTimestampsMutex);
+            std::lock_guard<std::mutex> lock2(_pFrameTimestampsMutex);
+            _iFrameTimestamps = std::move(iFrames);
+            _pFrameTimestamps = std::move(pFrames);
+            return;
+        }
+    }
+
     std::vector<double> tempTimestamps;
     scanForFrameTypes(_fmtCtx, _videoStreamIndex, tempTimestamps);
+
+    if (_probeKey) {
+        ProbeCache::instance().storeFrameTypes(*_probeKey, getIFrameTimestamps(), getPFrameTimestamps());
+    }
 }
 
 void Decoder::initializeVideoDecoder() {
@@ -87,10 +149,13 @@ void Decoder::initializeVideoDecoder() {
     if (_config.enableLowLatency) {
         _videoCtx->flags2 |= AV_CODEC_FLAG2_FAST;
         _videoCtx->thread_type = FF_THREAD_FRAME;
-        _videoCtx->thread_count = (_config.maxThreads > 0) ? _config.maxThreads : 1;
         _videoCtx->flags |= AV_CODEC_FLAG_LOW_DELAY;
     }
 
+    // 채널간 병렬성은 DecodeExecutor가 담당하므로 코덱 내부 스레드는 상한 내에서만 사용
+    _videoCtx->thread_count = DecodeExecutor::instance().getCodecThreadLimit(_config.maxThreads);
+    _videoCtx->skip_frame = toDiscard(_appliedPriority);
+
     // initialize(CUDA)
     _useHW = (_config.decoderType == DecoderType::CUDA);
     spdlog::info("GPU acceleration requested: {}", _useHW ? "Yes" : "No");
@@ -105,10 +170,18 @@ void Decoder::initializeVideoDecoder() {
         }
     }
 
+    // 코덱이 지원하면 출력 크기 이상을 유지하는 범위에서 저해상도로 디코딩
+    _videoCtx->lowres = chooseLowres(videoCodec);
+    if (_videoCtx->lowres > 0) {
+        spdlog::info("Decoding {} at lowres {}", videoCodec->name, _videoCtx->lowres);
+    }
+
     int openResult = avcodec_open2(_videoCtx, videoCodec, nullptr);
     if (openResult < 0) {
         throw std::runtime_error("Failed to open video codec");
     }
+    _decodedWidth = _videoCtx->width;
+    _decodedHeight = _videoCtx->height;
 
     if (_useHW) {
         if (!initializeCudaFrames(_videoCtx)) {
@@ -213,28 +286,38 @@ void Decoder::initializeVideoScaler(AVPixelFormat srcFmt) {
 
     const int width = (_videoCtx && _videoCtx->width > 0) ? _videoCtx->width : 640;
     const int height = (_videoCtx && _videoCtx->height > 0) ? _videoCtx->height : 480;
+    int dstWidth = 0;
+    int dstHeight = 0;
+    fitOutputSize(width, height, dstWidth, dstHeight);
 
-    _swsCtx = sws_getContext(width, height, srcFmt, width, height, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr,
-                             nullptr);
+    _swsCtx = sws_getContext(width, height, srcFmt, dstWidth, dstHeight, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr,
+                             nullptr, nullptr);
     if (!_swsCtx) {
         throw std::runtime_error("Failed to create video scaler context");
     }
 
     _currentScaleSrcFmt = srcFmt;
+    _scaleSrcWidth = width;
+    _scaleSrcHeight = height;
+    _scaleDstWidth = dstWidth;
+    _scaleDstHeight = dstHeight;
 }
 
 void Decoder::recreateVideoScalerIfNeeded(AVPixelFormat srcFmt, int w, int h) {
-    if (_swsCtx && srcFmt == _currentScaleSrcFmt && w == _videoCtx->width && h == _videoCtx->height) {
-        return;
-    }
+    // 입력 크기/포맷이나 출력 크기 힌트가 바뀌면 다시 생성
+    int dstWidth = 0;
+    int dstHeight = 0;
+    fitOutputSize(w, h, dstWidth, dstHeight);
 
     std::lock_guard<std::mutex> lock(_swsCtxMutex);
-    if (_swsCtx && srcFmt == _currentScaleSrcFmt && w == _videoCtx->width && h == _videoCtx->height) {
+    if (_swsCtx && srcFmt == _currentScaleSrcFmt && w == _scaleSrcWidth && h == _scaleSrcHeight &&
+        dstWidth == _scaleDstWidth && dstHeight == _scaleDstHeight) {
         return;
     }
 
     SwsContext *oldCtx = _swsCtx;
-    _swsCtx = sws_getContext(w, h, srcFmt, w, h, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+    _swsCtx = sws_getContext(w, h, srcFmt, dstWidth, dstHeight, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr,
+                             nullptr);
     if (!_swsCtx) {
         _swsCtx = oldCtx;
         throw std::runtime_error("Failed to recreate video scaler context");
@@ -245,6 +328,118 @@ void Decoder::recreateVideoScalerIfNeeded(AVPixelFormat srcFmt, int w, int h) {
     }
 
     _currentScaleSrcFmt = srcFmt;
+    _scaleSrcWidth = w;
+    _scaleSrcHeight = h;
+    _scaleDstWidth = dstWidth;
+    _scaleDstHeight = dstHeight;
+}
+
+void Decoder::fitOutputSize(const int srcWidth, const int srcHeight, int &width, int &height) const {
+    width = srcWidth;
+    height = srcHeight;
+
+    const int maxWidth = _outputWidth.load();
+    const int maxHeight = _outputHeight.load();
+    if (maxWidth <= 0 || maxHeight <= 0 || srcWidth <= 0 || srcHeight <= 0 ||
+        (srcWidth <= maxWidth && srcHeight <= maxHeight)) {
+        return;
+    }
+
+    const double scale = std::min(static_cast<double>(maxWidth) / srcWidth, static_cast<double>(maxHeight) / srcHeight);
+    width = std::max(2, static_cast<int>(srcWidth * scale) & ~1);
+    height = std::max(2, static_cast<int>(srcHeight * scale) & ~1);
+}
+
+void Decoder::setOutputSize(const int width, const int height) {
+    _outputWidth = width;
+    _outputHeight = height;
+    _outputSizeChanged = true;
+    if (_decodeStrand) {
+        _decodeStrand->schedule();
+    }
+}
+
+int Decoder::chooseLowres(const AVCodec *codec) const {
+    // frame sink(녹화)는 원본 크기 프레임이 필요
+    if (_useHW || !codec || codec->max_lowres <= 0 || _videoStreamIndex < 0 || hasFrameSink()) {
+        return 0;
+    }
+
+    const auto *params = _fmtCtx->streams[_videoStreamIndex]->codecpar;
+    int width = 0;
+    int height = 0;
+    fitOutputSize(params->width, params->height, width, height);
+
+    int lowres = 0;
+    while (lowres < codec->max_lowres && (params->width >> (lowres + 1)) >= width &&
+           (params->height >> (lowres + 1)) >= height) {
+        ++lowres;
+    }
+    return lowres;
+}
+
+void Decoder::applyLowres() {
+    if (!_outputSizeChanged.exchange(false) || !_videoCtx) {
+        return;
+    }
+
+    const AVCodec *codec = _videoCtx->codec;
+    const int lowres = chooseLowres(codec);
+    if (lowres == _videoCtx->lowres) {
+        return;
+    }
+
+    // lowres 는 열 때만 지정할 수 있으므로 같은 설정으로 새 컨텍스트를 열어 교체
+    AVCodecContext *ctx = avcodec_alloc_context3(codec);
+    if (!ctx || avcodec_parameters_to_context(ctx, _fmtCtx->streams[_videoStreamIndex]->codecpar) < 0) {
+        avcodec_free_context(&ctx);
+        return;
+    }
+    ctx->flags = _videoCtx->flags;
+    ctx->flags2 = _videoCtx->flags2;
+    ctx->thread_type = _videoCtx->thread_type;
+    ctx->thread_count = _videoCtx->thread_count;
+    ctx->skip_frame = _videoCtx->skip_frame;
+    ctx->lowres = lowres;
+    if (avcodec_open2(ctx, codec, nullptr) < 0) {
+        spdlog::warn("Failed to reopen {} at lowres {}", codec->name, lowres);
+        avcodec_free_context(&ctx);
+        return;
+    }
+
+    avcodec_free_context(&_videoCtx);
+    _videoCtx = ctx;
+    _decodedWidth = ctx->width;
+    _decodedHeight = ctx->height;
+    spdlog::info("Reopened {} at lowres {} ({}x{})", codec->name, lowres, ctx->width, ctx->height);
+
+    // 새 코덱은 참조 프레임이 없으므로 마지막 출력 위치부터 다시 디코딩
+    if (!_seekRequest.requested.load()) {
+        const double lastPts = _lastPresentedPts.load();
+        _seekRequest.set(lastPts >= 0.0 ? lastPts : getStartTime() + _timeOffset);
+    }
+}
+
+int Decoder::getCodedWidth() const {
+    return _videoStreamIndex >= 0 ? _fmtCtx->streams[_videoStreamIndex]->codecpar->width : 0;
+}
+
+int Decoder::getCodedHeight() const {
+    return _videoStreamIndex >= 0 ? _fmtCtx->streams[_videoStreamIndex]->codecpar->height : 0;
+}
+
+int Decoder::getOutputWidth() const {
+    int width = 0;
+    int height = 0;
+    fitOutputSize(getVideoWidth(), getVideoHeight(), width, height);
+    return width;
+}
+
+int Decoder::getOutputHeight() const {
+    int width = 0;
+    int height = 0;
+    fitOutputSize(getVideoWidth(), getVideoHeight(), width, height);
+    return height;
 }
 
 void Decoder::initializeAudioDecoder() {
@@ -348,8 +543,8 @@ void Decoder::extractVideoInfo() {
         _codecInfo.videoCodec = normalizeVideoCodecName(_videoCtx->codec->name);
     }
 
-    if (_videoCtx->width > 0 && _videoCtx->height > 0) {
-        _codecInfo.videoResolution = std::to_string(_videoCtx->width) + "x" + std::to_string(_videoCtx->height);
+    if (getCodedWidth() > 0 && getCodedHeight() > 0) {
+        _codecInfo.videoResolution = std::to_string(getCodedWidth()) + "x" + std::to_string(getCodedHeight());
     }
 
     if (videoStream->codecpar->bit_rate > 0) {
@@ -478,8 +673,43 @@ void Decoder::start() {
         return;
     }
 
+    if (!_packet) {
+        _packet = av_packet_alloc();
+        _decodedVideoFrame = av_frame_alloc();
+        _decodedAudioFrame = av_frame_alloc();
+        if (!_packet || !_decodedVideoFrame || !_decodedAudioFrame) {
+            throw std::runtime_error("Failed to allocate decoding buffers");
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_stateMutex);
+        _state.reset();
+    }
+    _eof = false;
+    _drained = false;
+    _pacedFrame.reset();
+
+    if (_liveInput) {
+        _liveInput->resume();
+    }
+
     _decodeRunning = true;
-    _decodeThread = std::thread(&Decoder::startDecoding, this);
+
+    auto &executor = DecodeExecutor::instance();
+    // live/네트워크 입력은 read 가 데이터 도착까지 블로킹되므로 풀 워커 대신 전용 스레드에서 읽음
+    const bool blockingInput = _liveInput || (!_readAhead && !ReadAheadInput::isLocalFile(filename));
+    _decodeStrand = blockingInput ? executor.createDedicatedStrand([this] { return decodeStep(); })
+                                  : executor.createStrand([this] { return decodeStep(); });
+    _convertStrand = executor.createStrand([this] { return convertStep(); });
+    if (_readAhead) {
+        _readAhead->setDataCallback([strand = std::weak_ptr(_decodeStrand)] {
+            if (const auto decodeStrand = strand.lock()) {
+                decodeStrand->schedule();
+            }
+        });
+    }
+    _decodeStrand->schedule();
 }
 
 void Decoder::stop() {
@@ -488,19 +718,35 @@ void Decoder::stop() {
         return;
     }
 
+    // 출력을 다른 디코더 큐로 보내는 경우 해당 큐는 소유자가 관리
     _videoQueue.clear();
     _audioQueue.clear();
 
     _videoQueue.push(VideoFrame{});
     _audioQueue.push(AudioFrame{});
 
-    if (_decodeThread.joinable()) {
-        _decodeThread.join();
+    // live 입력은 파일이 커질 때까지 읽기가 대기하므로 먼저 깨움
+    if (_liveInput) {
+        _liveInput->interrupt();
+    }
+
+    // 실행 중인 작업이 끝날 때까지 대기
+    if (_decodeStrand) {
+        _decodeStrand->cancel();
+        _decodeStrand.reset();
+    }
+    if (_convertStrand) {
+        _convertStrand->cancel();
+        _convertStrand.reset();
     }
 
+    clearConvertQueue();
+    _pacedFrame.reset();
+    _converting = false;
+
     flush();
 
-    spdlog::info("Stopped decoder thread.");
+    spdlog::info("Stopped decoder tasks.");
 }
 
 double Decoder::getDuration() const {
@@ -508,6 +754,10 @@ double Decoder::getDuration() const {
         return 0.0;
     }
 
+    if (_liveInput) {
+        return _liveInput->getLiveEdge();
+    }
+
     if (_fmtCtx->duration != AV_NOPTS_VALUE) {
         return static_cast<double>(_fmtCtx->duration) / AV_TIME_BASE;
     }
@@ -528,6 +778,11 @@ bool Decoder::seek(double timeInSeconds) {
     }
 
     _seekRequest.set(timeInSeconds);
+
+    // EOF 이후 대기 중인 경우에도 seek 처리되도록 깨움
+    if (_decodeStrand) {
+        _decodeStrand->schedule();
+    }
     return true;
 }
 
@@ -542,95 +797,253 @@ std::vector<double> Decoder::getPFrameTimestamps() const {
 }
 
 int Decoder::getMaxQueueSize() const {
-    if (_videoCtx && _videoCtx->width >= 3840 /* 4K */) {
+    // 축소 출력이면 프레임이 작으므로 HD 기준 큐 크기
+    if (getOutputWidth() >= 3840 /* 4K */) {
         return MAX_QUEUE_SIZE_4K;
     }
     return MAX_QUEUE_SIZE_HD;
 }
 
-void Decoder::startDecoding() {
-    auto packet_deleter = [](AVPacket *p) { av_packet_free(&p); };
-    std::unique_ptr<AVPacket, decltype(packet_deleter)> packet(av_packet_alloc(), packet_deleter);
-    if (!packet) {
-        return;
+DecodeExecutor::Step Decoder::decodeStep() {
+    if (!_decodeRunning.load()) {
+        return DecodeExecutor::Step::idle();
+    }
+
+    applyPriority();
+    applyLowres();
+
+    if (handleSeekRequest()) {
+        return DecodeExecutor::Step::next();
+    }
+
+    // EOF 처리 완료 후에는 seek 요청이 올 때까지 대기
+    if (_drained) {
+        return DecodeExecutor::Step::idle();
+    }
+
+    if (!hasQueueSpace()) {
+        return DecodeExecutor::Step::after(QUEUE_FULL_RETRY_INTERVAL);
+    }
+
+    if (_eof) {
+        drainDecoders();
+        _drained = true;
+        return DecodeExecutor::Step::idle();
     }
 
-    auto frame_deleter = [](AVFrame *f) {
-        if (f) {
-            av_frame_unref(f);
-            av_frame_free(&f);
+    // read-ahead 버퍼가 비어 있으면 워커를 막지 않고 I/O 스레드가 채운 뒤 다시 실행
+    if (_readAhead && !_readAhead->isReadable()) {
+        return DecodeExecutor::Step::idle();
+    }
+
+    const auto ret = av_read_frame(_fmtCtx, _packet);
+    if (ret == AVERROR_EXIT && _liveInput) {
+        // stop 으로 live 대기가 중단됨 (EOF 아님)
+        return DecodeExecutor::Step::idle();
+    }
+    if (ret < 0) {
+        if (ret != AVERROR_EOF) {
+            spdlog::warn("Failed to read packet: {}", ret);
         }
-    };
-    std::unique_ptr<AVFrame, decltype(frame_deleter)> videoFrame(av_frame_alloc(), frame_deleter);
-    std::unique_ptr<AVFrame, decltype(frame_deleter)> audioFrame(av_frame_alloc(), frame_deleter);
+        _eof = true;
+        return DecodeExecutor::Step::next();
+    }
 
-    if (!videoFrame || !audioFrame) {
-        return;
+    // 녹화 tap 은 우선순위와 관계없이 모든 패킷을 받음
+    std::shared_ptr<IPacketSink> sink;
+    {
+        std::lock_guard<std::mutex> lock(_packetSinkMutex);
+        sink = _packetSink;
+    }
+    if (sink && (_packet->stream_index == _videoStreamIndex || _packet->stream_index == _audioStreamIndex)) {
+        sink->onPacket(_packet, _packet->stream_index == _videoStreamIndex);
+    }
+
+    if (_audioCtx && _packet->stream_index == _audioStreamIndex) {
+        decodeAudioPacket(_packet, _decodedAudioFrame);
+    } else if (_packet->stream_index == _videoStreamIndex) {
+        // keyframe-only: 비키프레임 패킷은 디코더에 전달하지 않음
+        const bool skip = _appliedPriority == DecodePriority::Disabled ||
+                          (_appliedPriority == DecodePriority::KeyframeOnly && !(_packet->flags & AV_PKT_FLAG_KEY));
+        if (!skip) {
+            decodeVideoPacket(_packet, _decodedVideoFrame);
+        }
     }
 
-    DecodingState state;
-    bool eof = false;
+    av_packet_unref(_packet);
+    return DecodeExecutor::Step::next();
+}
+
+DecodeExecutor::Step Decoder::convertStep() {
+    if (!_decodeRunning.load()) {
+        return DecodeExecutor::Step::idle();
+    }
 
-    while (_decodeRunning.load() && !eof) {
-        const auto ret = av_read_frame(_fmtCtx, packet.get());
-        if (ret < 0) {
-            if (ret == AVERROR_EOF) {
-                eof = true;
-                packet->data = nullptr;
-                packet->size = 0;
-            } else {
-                break;
+    const auto generation = _seekGeneration.load();
+    if (_pacedFrame && _pacedGeneration != generation) {
+        _pacedFrame.reset();
+        _converting = false;
+    }
+
+    if (!_pacedFrame) {
+        PendingFrame pending;
+        {
+            std::lock_guard<std::mutex> lock(_convertMutex);
+            if (_convertQueue.empty()) {
+                return DecodeExecutor::Step::idle();
             }
-        }
-        if (handleSeekRequest(state)) {
-            av_packet_unref(packet.get());
-            continue;
+            pending = _convertQueue.front();
+            _convertQueue.pop_front();
+            _converting = true;
         }
 
-        if (!waitForQueueSpace()) {
-            break;
+        if (pending.generation == generation) {
+            deliverToFrameSink(pending.frame, pending.scaleSrcFmt);
+            recreateVideoScalerIfNeeded(pending.scaleSrcFmt, pending.frame->width, pending.frame->height);
+            _pacedFrame = createVideoFrame(pending.frame);
+            _pacedGeneration = pending.generation;
         }
+        av_frame_free(&pending.frame);
 
-        if (_audioCtx && packet->stream_index == _audioStreamIndex) {
-            decodeAudioPacket(packet.get(), audioFrame.get(), state);
-        } else if (packet->stream_index == _videoStreamIndex) {
-            decodeVideoPacket(packet.get(), videoFrame.get(), state);
+        if (!_pacedFrame) {
+            _converting = false;
+            return DecodeExecutor::Step::next();
         }
+    }
 
-        av_packet_unref(packet.get());
+    // 오디오 기준 실시간 출력 (sleep 대신 재스케줄)
+    // 1초 이상 앞선 프레임은 대기하지 않음
+    const double delay = getPresentationDelay(*_pacedFrame);
+    if (delay > 0.0 && delay < 1.0) {
+        return DecodeExecutor::Step::after(std::chrono::microseconds(static_cast<int64_t>(delay * 1e6)));
+    }
+    if (delay < -LATE_FRAME_THRESHOLD) {
+        ++_lateFrames;
     }
 
-    if (_videoCtx) {
-        avcodec_send_packet(_videoCtx, nullptr);
-        while (avcodec_receive_frame(_videoCtx, videoFrame.get()) >= 0) {
-            auto videoFrameOpt = createVideoFrame(videoFrame.get(), state);
-            if (videoFrameOpt.has_value()) {
-                syncVideoFrame(*videoFrameOpt, state);
-                _videoQueue.push(std::move(*videoFrameOpt));
-            }
-            av_frame_unref(videoFrame.get());
-        }
+    if (_pacedGeneration == _seekGeneration.load()) {
+        _lastPresentedPts = _pacedFrame->pts;
+        _videoOutput->push(std::move(*_pacedFrame));
+    }
+    _pacedFrame.reset();
+    _converting = false;
+    return DecodeExecutor::Step::next();
+}
+
+void Decoder::setPacketSink(std::shared_ptr<IPacketSink> sink) {
+    std::lock_guard<std::mutex> lock(_packetSinkMutex);
+    _packetSink = std::move(sink);
+}
+
+void Decoder::setFrameSink(std::shared_ptr<IFrameSink> sink) {
+    {
+        std::lock_guard<std::mutex> lock(_frameSinkMutex);
+        _frameSink = std::move(sink);
+    }
+
+    // 원본 크기로 다시 열거나 표시 크기 lowres 로 되돌림 (decode strand 에서 적용)
+    _outputSizeChanged = true;
+    if (_decodeStrand) {
+        _decodeStrand->schedule();
+    }
+}
+
+bool Decoder::hasFrameSink() const {
+    std::lock_guard<std::mutex> lock(_frameSinkMutex);
+    return _frameSink != nullptr;
+}
+
+bool Decoder::isFinished() const {
+    if (!_drained.load()) {
+        return false;
+    }
+    // drain 후 남은 변환/출력 대기 프레임까지 모두 출력되었는지
+    std::lock_guard<std::mutex> lock(_convertMutex);
+    return _convertQueue.empty() && !_converting.load();
+}
+
+bool Decoder::rewind() {
+    if (!_fmtCtx || _decodeRunning.load()) {
+        return false;
+    }
+
+    const int64_t startTime = _fmtCtx->start_time != AV_NOPTS_VALUE ? _fmtCtx->start_time : 0;
+    if (av_seek_frame(_fmtCtx, -1, startTime, AVSEEK_FLAG_BACKWARD) < 0) {
+        return false;
     }
 
+    if (_videoCtx) {
+        avcodec_flush_buffers(_videoCtx);
+    }
     if (_audioCtx) {
-        avcodec_send_packet(_audioCtx, nullptr);
-        while (avcodec_receive_frame(_audioCtx, audioFrame.get()) >= 0) {
-            auto audioFrameOpt = createAudioFrame(audioFrame.get(), state);
-            if (audioFrameOpt.has_value()) {
-                _audioQueue.push(std::move(*audioFrameOpt));
-            }
-            av_frame_unref(audioFrame.get());
-        }
+        avcodec_flush_buffers(_audioCtx);
+    }
+    _seekGeneration.fetch_add(1);
+    clearConvertQueue();
+    _seekRequest.clear();
+    return true;
+}
+
+void Decoder::restartClock() {
+    std::lock_guard<std::mutex> lock(_stateMutex);
+    // 첫 오디오 프레임 전이면 그 시점에 기준이 잡힘
+    if (!_state.isFirstAudioFrame) {
+        _state.playbackStartTime = std::chrono::high_resolution_clock::now();
+    }
+    _state.paused = false;
+}
+
+void Decoder::setClockPaused(const bool paused) {
+    std::lock_guard<std::mutex> lock(_stateMutex);
+    if (paused == _state.paused) {
+        return;
+    }
+
+    const auto now = std::chrono::high_resolution_clock::now();
+    if (paused) {
+        _state.pausedAt = now;
+    } else {
+        _state.playbackStartTime += now - _state.pausedAt;
+    }
+    _state.paused = paused;
+}
+
+double Decoder::getStartTime() const {
+    if (!_fmtCtx || _videoStreamIndex < 0) {
+        return 0.0;
+    }
+
+    const auto *stream = _fmtCtx->streams[_videoStreamIndex];
+    if (stream->start_time == AV_NOPTS_VALUE) {
+        return 0.0;
     }
+    return static_cast<double>(stream->start_time) * av_q2d(stream->time_base);
 }
 
-bool Decoder::handleSeekRequest(DecodingState &state) {
+PacketStreamInfo Decoder::getPacketStreamInfo() const {
+    PacketStreamInfo info;
+    if (!_fmtCtx) {
+        return info;
+    }
+
+    if (_videoStreamIndex >= 0) {
+        info.videoParams = _fmtCtx->streams[_videoStreamIndex]->codecpar;
+        info.videoTimeBase = _fmtCtx->streams[_videoStreamIndex]->time_base;
+    }
+    if (_audioStreamIndex >= 0) {
+        info.audioParams = _fmtCtx->streams[_audioStreamIndex]->codecpar;
+        info.audioTimeBase = _fmtCtx->streams[_audioStreamIndex]->time_base;
+    }
+    return info;
+}
+
+bool Decoder::handleSeekRequest() {
     auto [requested, seekTime] = _seekRequest.get();
     if (!requested) {
         return false;
     }
 
-    const auto seekTimestamp = static_cast<int64_t>(seekTime * AV_TIME_BASE);
+    const auto seekTimestamp = static_cast<int64_t>((seekTime - _timeOffset) * AV_TIME_BASE);
 
     if (av_seek_frame(_fmtCtx, -1, seekTimestamp, AVSEEK_FLAG_BACKWARD) >= 0) {
         if (_videoCtx) {
@@ -641,27 +1054,89 @@ bool Decoder::handleSeekRequest(DecodingState &state) {
             avcodec_flush_buffers(_audioCtx);
         }
 
-        _videoQueue.clear();
-        _audioQueue.clear();
+        // 변환 대기/출력 대기 프레임 무효화
+        _seekGeneration.fetch_add(1);
+        clearConvertQueue();
+
+        // 비디오 비활성 중에는 공유 비디오 큐를 proxy 가 관리 (proxy seek 에서 비움)
+        if (_requestedPriority.load() != DecodePriority::Disabled) {
+            _videoOutput->clear();
+        }
+        _audioOutput->clear();
 
-        state.reset();
+        {
+            std::lock_guard<std::mutex> lock(_stateMutex);
+            _state.reset();
+        }
+        _eof = false;
+        _drained = false;
     }
 
     _seekRequest.clear();
     return true;
 }
 
-bool Decoder::waitForQueueSpace() const {
-    const int maxSize = getMaxQueueSize();
+void Decoder::setPriority(const DecodePriority priority) {
+    _requestedPriority.store(priority);
+}
+
+void Decoder::applyPriority() {
+    const auto priority = _requestedPriority.load();
+    if (priority == _appliedPriority) {
+        return;
+    }
+
+    // keyframe-only 에서 복귀 시 참조 프레임이 없으므로 마지막 출력 위치로 재동기화
+    const double lastPts = _lastPresentedPts.load();
+    if (_appliedPriority == DecodePriority::KeyframeOnly && lastPts >= 0.0 && !_seekRequest.requested.load()) {
+        _seekRequest.set(lastPts);
+    }
+
+    _appliedPriority = priority;
+    if (_videoCtx) {
+        _videoCtx->skip_frame = toDiscard(priority);
+    }
+}
+
+AVDiscard Decoder::toDiscard(const DecodePriority priority) {
+    switch (priority) {
+        case DecodePriority::ReducedFps:
+            return AVDISCARD_NONREF;
+        case DecodePriority::KeyframeOnly:
+            return AVDISCARD_NONKEY;
+        case DecodePriority::Disabled:
+            return AVDISCARD_ALL;
+        case DecodePriority::Full:
+        default:
+            return AVDISCARD_DEFAULT;
+    }
+}
+
+bool Decoder::hasQueueSpace() const {
+    const auto maxSize = static_cast<size_t>(getMaxQueueSize());
+
+    size_t pendingFrames = 0;
+    {
+        std::lock_guard<std::mutex> lock(_convertMutex);
+        pendingFrames = _convertQueue.size();
+    }
+
+    // 비디오를 디코딩하지 않는 동안 공유 비디오 큐는 proxy 출력이므로 대기 조건에서 제외
+    const bool videoFull = _appliedPriority != DecodePriority::Disabled && _videoOutput->size() + pendingFrames > maxSize;
+    return !videoFull && _audioOutput->size() <= maxSize;
+}
 
-    while (_decodeRunning.load() &&
-           (_videoQueue.size() > static_cast<size_t>(maxSize) || _audioQueue.size() > static_cast<size_t>(maxSize))) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+void Decoder::drainDecoders() {
+    if (_videoCtx) {
+        decodeVideoPacket(nullptr, _decodedVideoFrame);
+    }
+
+    if (_audioCtx) {
+        decodeAudioPacket(nullptr, _decodedAudioFrame);
     }
-    return _decodeRunning.load();
 }
 
-void Decoder::decodeAudioPacket(const AVPacket *packet, AVFrame *frame, DecodingState &state) {
+void Decoder::decodeAudioPacket(const AVPacket *packet, AVFrame *frame) {
     if (!_audioCtx) {
         return;
     }
@@ -671,73 +1146,80 @@ void Decoder::decodeAudioPacket(const AVPacket *packet, AVFrame *frame, Decoding
     }
 
     while (avcodec_receive_frame(_audioCtx, frame) >= 0) {
-        auto audioFrameOpt = createAudioFrame(frame, state);
+        auto audioFrameOpt = createAudioFrame(frame);
         if (audioFrameOpt.has_value()) {
-            _audioQueue.push(std::move(*audioFrameOpt));
+            _audioOutput->push(std::move(*audioFrameOpt));
         }
         av_frame_unref(frame);
     }
 }
 
-void Decoder::decodeVideoPacket(const AVPacket *packet, AVFrame *frame, const DecodingState &state) {
+void Decoder::decodeVideoPacket(const AVPacket *packet, AVFrame *frame) {
     int ret = avcodec_send_packet(_videoCtx, packet);
     if (ret < 0) {
         return;
     }
 
-    auto frame_deleter = [](AVFrame *f) { av_frame_free(&f); };
-    std::unique_ptr<AVFrame, decltype(frame_deleter)> swFrame(nullptr, frame_deleter);
-
     while (avcodec_receive_frame(_videoCtx, frame) >= 0) {
-        AVFrame *src = frame;
-        auto scaleSrcFmt = static_cast<AVPixelFormat>(frame->format);
-        int width = frame->width;
-        int height = frame->height;
-
         if (_useHW && frame->format == AV_PIX_FMT_CUDA) {
             std::lock_guard<std::mutex> cudaLock(_cudaMutex);
             spdlog::debug("Decoded CUDA frame - format: {}, width: {}, height: {}, pts: {}",
                           av_get_pix_fmt_name(static_cast<AVPixelFormat>(frame->format)),
                           frame->width, frame->height, frame->pts);
 
-            swFrame.reset(av_frame_alloc());
+            AVFrame *swFrame = av_frame_alloc();
             if (!swFrame) {
                 av_frame_unref(frame);
                 continue;
             }
 
-            int transferErr = av_hwframe_transfer_data(swFrame.get(), frame, 0);
+            int transferErr = av_hwframe_transfer_data(swFrame, frame, 0);
             if (transferErr < 0) {
+                av_frame_free(&swFrame);
                 av_frame_unref(frame);
                 continue;
             }
 
-            src = swFrame.get();
-            scaleSrcFmt = pickSWFormatForCuda(static_cast<AVPixelFormat>(swFrame->format));
-            width = swFrame->width;
-            height = swFrame->height;
+            // transfer 시 타임스탬프는 복사되지 않음
+            swFrame->best_effort_timestamp = frame->best_effort_timestamp;
+            swFrame->pts = frame->pts;
+            av_frame_unref(frame);
+
+            enqueueConvert(swFrame, pickSWFormatForCuda(static_cast<AVPixelFormat>(swFrame->format)));
         } else {
-            scaleSrcFmt = static_cast<AVPixelFormat>(frame->format);
-            width = frame->width;
-            height = frame->height;
+            AVFrame *decoded = av_frame_alloc();
+            if (!decoded) {
+                av_frame_unref(frame);
+                continue;
+            }
+
+            // 버퍼 참조만 넘김 (복사 없음)
+            av_frame_move_ref(decoded, frame);
+            enqueueConvert(decoded, static_cast<AVPixelFormat>(decoded->format));
         }
+    }
+}
 
-        recreateVideoScalerIfNeeded(scaleSrcFmt, width, height);
+void Decoder::enqueueConvert(AVFrame *frame, const AVPixelFormat scaleSrcFmt) {
+    {
+        std::lock_guard<std::mutex> lock(_convertMutex);
+        _convertQueue.push_back(PendingFrame{frame, scaleSrcFmt, _seekGeneration.load()});
+    }
 
-        auto videoFrameOpt = createVideoFrame(src, state);
-        if (videoFrameOpt.has_value()) {
-            syncVideoFrame(*videoFrameOpt, state);
-            _videoQueue.push(std::move(*videoFrameOpt));
-        }
+    if (_convertStrand) {
+        _convertStrand->schedule();
+    }
+}
 
-        av_frame_unref(frame);
-        if (swFrame) {
-            av_frame_unref(swFrame.get());
-        }
+void Decoder::clearConvertQueue() {
+    std::lock_guard<std::mutex> lock(_convertMutex);
+    for (auto &pending: _convertQueue) {
+        av_frame_free(&pending.frame);
     }
+    _convertQueue.clear();
 }
 
-std::optional<AudioFrame> Decoder::createAudioFrame(const AVFrame *frame, DecodingState &state) const {
+std::optional<AudioFrame> Decoder::createAudioFrame(const AVFrame *frame) {
     if (!frame || !_swrCtx) {
         return std::nullopt;
     }
@@ -754,11 +1236,16 @@ std::optional<AudioFrame> Decoder::createAudioFrame(const AVFrame *frame, Decodi
     audioFrame.pts = (frame->best_effort_timestamp == AV_NOPTS_VALUE)
                              ? 0.0
                              : static_cast<double>(frame->best_effort_timestamp) * av_q2d(_audioTimeBase);
+    audioFrame.pts += _timeOffset;
 
-    if (state.isFirstAudioFrame) {
-        state.audioStartPTS = audioFrame.pts;
-        state.isFirstAudioFrame = false;
-        state.playbackStartTime = std::chrono::high_resolution_clock::now();
+    {
+        std::lock_guard<std::mutex> stateLock(_stateMutex);
+        if (_state.isFirstAudioFrame) {
+            _state.audioStartPTS = audioFrame.pts;
+            _state.isFirstAudioFrame = false;
+            _state.playbackStartTime = std::chrono::high_resolution_clock::now();
+            _state.pausedAt = _state.playbackStartTime;
+        }
     }
 
     const int outSamples = swr_get_out_samples(_swrCtx, frame->nb_samples);
@@ -784,7 +1271,7 @@ std::optional<AudioFrame> Decoder::createAudioFrame(const AVFrame *frame, Decodi
     return audioFrame;
 }
 
-std::optional<VideoFrame> Decoder::createVideoFrame(const AVFrame *frame, const DecodingState &state) const {
+std::optional<VideoFrame> Decoder::createVideoFrame(const AVFrame *frame) const {
     if (!frame || !_swsCtx) {
         return std::nullopt;
     }
@@ -795,20 +1282,23 @@ std::optional<VideoFrame> Decoder::createVideoFrame(const AVFrame *frame, const
     }
 
     VideoFrame videoFrame;
-    videoFrame.width = frame->width;
-    videoFrame.height = frame->height;
-    videoFrame.pts = (frame->best_effort_timestamp == AV_NOPTS_VALUE)
-                             ? 0.0
-                             : static_cast<double>(frame->best_effort_timestamp) * av_q2d(_videoTimeBase);
+    videoFrame.width = _scaleDstWidth;
+    videoFrame.height = _scaleDstHeight;
+    videoFrame.pts = videoFramePts(frame);
 
     size_t dataSize = static_cast<size_t>(videoFrame.width) * videoFrame.height * 3;
-    size_t alignedSize = ((dataSize + 31) & ~31);
-    videoFrame.data.resize(alignedSize);
+    if (_frameAllocator) {
+        videoFrame.buffer = _frameAllocator->allocate(dataSize);
+    }
+    if (!videoFrame.buffer) {
+        size_t alignedSize = ((dataSize + 31) & ~31);
+        videoFrame.data.resize(alignedSize);
+    }
 
-    uint8_t *dest[1] = {videoFrame.data.data()};
+    uint8_t *dest[1] = {videoFrame.pixels()};
     int lines[1] = {3 * videoFrame.width};
 
-    const auto ret = sws_scale(_swsCtx, frame->data, frame->linesize, 0, videoFrame.height, dest, lines);
+    const auto ret = sws_scale(_swsCtx, frame->data, frame->linesize, 0, frame->height, dest, lines);
     if (ret < 0) {
         return std::nullopt;
     }
@@ -816,21 +1306,81 @@ std::optional<VideoFrame> Decoder::createVideoFrame(const AVFrame *frame, const
     return videoFrame;
 }
 
-void Decoder::syncVideoFrame(const VideoFrame &videoFrame, const DecodingState &state) {
-    if (state.isFirstAudioFrame) {
+double Decoder::videoFramePts(const AVFrame *frame) const {
+    const double pts = (frame->best_effort_timestamp == AV_NOPTS_VALUE)
+                               ? 0.0
+                               : static_cast<double>(frame->best_effort_timestamp) * av_q2d(_videoTimeBase);
+    return pts + _timeOffset;
+}
+
+void Decoder::deliverToFrameSink(const AVFrame *frame, const AVPixelFormat srcFmt) {
+    std::shared_ptr<IFrameSink> sink;
+    {
+        std::lock_guard<std::mutex> lock(_frameSinkMutex);
+        sink = _frameSink;
+    }
+    if (!sink) {
         return;
     }
 
-    const double relativeVideoPTS = videoFrame.pts - state.audioStartPTS;
-    const auto now = std::chrono::high_resolution_clock::now();
-    const double elapsed = std::chrono::duration<double>(now - state.playbackStartTime).count();
+    if (auto sinkFrame = createSinkFrame(frame, srcFmt)) {
+        sink->onFrame(std::move(sinkFrame));
+    }
+}
 
-    if (relativeVideoPTS > elapsed) {
-        const auto sleepDuration = std::chrono::duration<double>(relativeVideoPTS - elapsed);
-        if (sleepDuration.count() > 0 && sleepDuration.count() < 1.0) {
-            std::this_thread::sleep_for(sleepDuration);
-        }
+std::shared_ptr<const VideoFrame> Decoder::createSinkFrame(const AVFrame *frame, const AVPixelFormat srcFmt) {
+    // YUV420P 는 짝수 크기만 가능
+    const int width = frame->width & ~1;
+    const int height = frame->height & ~1;
+    if (width <= 0 || height <= 0) {
+        return nullptr;
+    }
+
+    auto sinkFrame = std::make_shared<VideoFrame>();
+    sinkFrame->width = width;
+    sinkFrame->height = height;
+    sinkFrame->pts = videoFramePts(frame);
+    sinkFrame->format = VideoFrame::PixelFormat::YUV420P;
+    sinkFrame->data.resize(sinkFrame->frameSize());
+
+    uint8_t *dstData[4] = {nullptr};
+    int dstLinesize[4] = {0};
+    av_image_fill_arrays(dstData, dstLinesize, sinkFrame->data.data(), AV_PIX_FMT_YUV420P, width, height, 1);
+
+    if (srcFmt == AV_PIX_FMT_YUV420P || srcFmt == AV_PIX_FMT_YUVJ420P) {
+        // 디코더 출력이 이미 YUV420P 면 평면 복사만 (색 변환 없음)
+        av_image_copy(dstData, dstLinesize, const_cast<const uint8_t **>(frame->data), frame->linesize,
+                      AV_PIX_FMT_YUV420P, width, height);
+        return sinkFrame;
+    }
+
+    _sinkSwsCtx = sws_getCachedContext(_sinkSwsCtx, width, height, srcFmt, width, height, AV_PIX_FMT_YUV420P,
+                                       SWS_BILINEAR, nullptr, nullptr, nullptr);
+    if (!_sinkSwsCtx || sws_scale(_sinkSwsCtx, frame->data, frame->linesize, 0, height, dstData, dstLinesize) <= 0) {
+        return nullptr;
     }
+    return sinkFrame;
+}
+
+double Decoder::getPresentationDelay(const VideoFrame &videoFrame) const {
+    return _clockSource ? _clockSource->presentationDelay(videoFrame.pts) : presentationDelay(videoFrame.pts);
+}
+
+double Decoder::presentationDelay(const double pts) const {
+    if (!_config.realtimePacing) {
+        return 0.0;
+    }
+
+    std::lock_guard<std::mutex> lock(_stateMutex);
+    if (_state.isFirstAudioFrame) {
+        return 0.0;
+    }
+
+    const double relativeVideoPTS = pts - _state.audioStartPTS;
+    const auto now = _state.paused ? _state.pausedAt : std::chrono::high_resolution_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - _state.playbackStartTime).count();
+
+    return relativeVideoPTS - elapsed;
 }
 
 void Decoder::flush() {
@@ -853,6 +1403,8 @@ void Decoder::cleanup() {
         avformat_close_input(&_fmtCtx);
         _fmtCtx = nullptr;
     }
+    _liveInput.reset();
+    _readAhead.reset();
 
     if (_videoCtx) {
         avcodec_free_context(&_videoCtx);
@@ -869,6 +1421,8 @@ void Decoder::cleanup() {
             _swsCtx = nullptr;
         }
     }
+    sws_freeContext(_sinkSwsCtx);
+    _sinkSwsCtx = nullptr;
 
     {
         std::lock_guard<std::mutex> lock(_swrCtxMutex);
@@ -895,5 +1449,15 @@ void Decoder::cleanup() {
     _videoQueue.clear();
     _audioQueue.clear();
 
+    if (_packet) {
+        av_packet_free(&_packet);
+    }
+    if (_decodedVideoFrame) {
+        av_frame_free(&_decodedVideoFrame);
+    }
+    if (_decodedAudioFrame) {
+        av_frame_free(&_decodedAudioFrame);
+    }
+
     avformat_network_deinit();
 }
@@ -2,9 +2,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <optional>
 #include <string>
-#include <thread>
 #include <mutex>
 #include <vector>
 #include <memory>
@@ -13,10 +13,16 @@
 #include "ThreadSafeQueue.h"
 #include "VideoFrame.h"
 #include "interface/IDecoderSource.h"
+#include "interface/IFrameAllocator.h"
+#include "interface/IFrameSink.h"
+#include "interface/IPacketSink.h"
+#include "threads/DecodeExecutor.h"
 #include "ui/OSDState.h"
 
 struct VideoFrame;
 struct AudioFrame;
+class LiveFileInput;
+class ReadAheadInput;
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -59,11 +65,78 @@ public:
     void stop() override;
     void flush() override;
 
+    // liveTail: 현재 기록된 live edge 까지 (계속 증가)
     double getDuration() const override;
     bool seek(double timeInSeconds) override;
+    bool isSeekPending() const { return _seekRequest.requested.load(); }
 
-    ThreadSafeQueue<VideoFrame> &getVideoQueue() override { return _videoQueue; }
-    ThreadSafeQueue<AudioFrame> &getAudioQueue() override { return _audioQueue; }
+    // 변환 결과를 기록할 버퍼 할당자 (start 전에 설정, 할당 실패 시 VideoFrame::data 사용)
+    void setFrameAllocator(std::shared_ptr<IFrameAllocator> allocator) { _frameAllocator = std::move(allocator); }
+
+    // 디먹스된 패킷을 디코딩 전에 전달 (nullptr 로 해제)
+    void setPacketSink(std::shared_ptr<IPacketSink> sink);
+    PacketStreamInfo getPacketStreamInfo() const;
+
+    // 디코딩된 프레임을 표시용 변환과 별도로 원본 크기 YUV420P 로 전달 (nullptr 로 해제)
+    // 설정된 동안은 표시 크기와 관계없이 lowres 를 사용하지 않음
+    void setFrameSink(std::shared_ptr<IFrameSink> sink);
+
+    // 비디오 프레임을 다른 디코더의 큐로 출력 (start 전에 설정, 대상 디코더보다 먼저 해제되어야 함)
+    void setVideoOutput(ThreadSafeQueue<VideoFrame> &queue) { _videoOutput = &queue; }
+
+    // 오디오 프레임 출력 큐 (setVideoOutput 과 같은 조건)
+    void setAudioOutput(ThreadSafeQueue<AudioFrame> &queue) { _audioOutput = &queue; }
+
+    // 비디오 출력 시점을 다른 디코더의 오디오 시계에 맞춤 (오디오 없는 proxy, 대상 디코더보다 먼저 해제되어야 함)
+    void setClockSource(const Decoder &source) { _clockSource = &source; }
+
+    // 다른 파일의 시간축에 맞추기 위한 offset (출력 비디오/오디오 PTS 에 더하고 seek 시각에서 뺌)
+    void setTimeOffset(const double offset) { _timeOffset = offset; }
+
+    // stream start_time 기준 시작 시각 (초)
+    double getStartTime() const;
+
+    double getLastPresentedPts() const { return _lastPresentedPts.load(); }
+
+    // 기록 중인 세그먼트를 따라 읽는 중인지 (DecoderConfig::liveTail)
+    bool isLive() const { return _liveInput != nullptr; }
+
+    // EOF 까지 디코딩한 프레임을 모두 출력했는지 (seek 하면 false)
+    bool isFinished() const;
+
+    // 정지 상태에서 파일 처음으로 되돌림 (열어 둔 디코더를 다시 재생할 때, 실행 중이면 false)
+    bool rewind();
+
+    // 이미 디코딩해 둔 출력의 재생 기준 시각을 지금으로 다시 맞춤 (pre-roll 후 재생 시작 시)
+    void restartClock();
+
+    // 일시정지 중에는 출력 시계를 멈춰 디코딩을 계속하지 않고 대기 (재개 시 멈춘 시간만큼 기준 이동)
+    void setClockPaused(bool paused);
+
+    // 오디오 시계보다 LATE_FRAME_THRESHOLD 이상 늦게 출력된 프레임 수 (디코딩 여유 부족 지표)
+    uint64_t getLateFrames() const { return _lateFrames.load(); }
+
+    // 디코딩 프레임 크기 (lowres 이면 축소된 크기)
+    int getVideoWidth() const { return _decodedWidth.load(); }
+    int getVideoHeight() const { return _decodedHeight.load(); }
+
+    // 스트림의 원본 크기 (lowres 와 무관, 녹화 해상도)
+    int getCodedWidth() const;
+    int getCodedHeight() const;
+
+    // 표시 크기 힌트 변경 (다음 변환 프레임부터 적용, 0 이면 원본 해상도)
+    // lowres 가 달라지면 decode strand 에서 코덱을 다시 열고 마지막 출력 위치로 seek
+    void setOutputSize(int width, int height);
+
+    // 힌트를 적용한 출력 프레임 크기
+    int getOutputWidth() const;
+    int getOutputHeight() const;
+
+    void setPriority(DecodePriority priority) override;
+    DecodePriority getPriority() const { return _requestedPriority.load(); }
+
+    ThreadSafeQueue<VideoFrame> &getVideoQueue() override { return *_videoOutput; }
+    ThreadSafeQueue<AudioFrame> &getAudioQueue() override { return *_audioOutput; }
 
     CodecInfo getCodecInfo() const override;
     std::vector<double> getIFrameTimestamps() const override;
@@ -74,11 +147,15 @@ private:
         bool isFirstAudioFrame = true;
         double audioStartPTS = 0.0;
         std::chrono::high_resolution_clock::time_point playbackStartTime;
+        // 일시정지 상태는 seek/start 후에도 유지
+        bool paused = false;
+        std::chrono::high_resolution_clock::time_point pausedAt;
 
         void reset() {
             isFirstAudioFrame = true;
             audioStartPTS = 0.0;
             playbackStartTime = std::chrono::high_resolution_clock::now();
+            pausedAt = playbackStartTime;
         }
     };
 
@@ -104,14 +181,32 @@ private:
     void addPFrameTimestamp(double pts);
     void sortFrameTimestamps();
 
-    void startDecoding();
-    bool handleSeekRequest(DecodingState &state);
-    bool waitForQueueSpace() const;
-    void decodeAudioPacket(const AVPacket *packet, AVFrame *frame, DecodingState &state);
-    void decodeVideoPacket(const AVPacket *packet, AVFrame *frame, const DecodingState &state);
-    std::optional<AudioFrame> createAudioFrame(const AVFrame *frame, DecodingState &state) const;
-    std::optional<VideoFrame> createVideoFrame(const AVFrame *frame, const DecodingState &state) const;
-    static void syncVideoFrame(const VideoFrame &videoFrame, const DecodingState &state);
+    // DecodeExecutor 작업 단위 (decode: 패킷 1개, convert: 프레임 1개)
+    DecodeExecutor::Step decodeStep();
+    DecodeExecutor::Step convertStep();
+
+    bool handleSeekRequest();
+    void applyPriority();
+    static AVDiscard toDiscard(DecodePriority priority);
+    bool hasQueueSpace() const;
+    void drainDecoders();
+    void decodeAudioPacket(const AVPacket *packet, AVFrame *frame);
+    void decodeVideoPacket(const AVPacket *packet, AVFrame *frame);
+    void enqueueConvert(AVFrame *frame, AVPixelFormat scaleSrcFmt);
+    void clearConvertQueue();
+    std::optional<AudioFrame> createAudioFrame(const AVFrame *frame);
+    std::optional<VideoFrame> createVideoFrame(const AVFrame *frame) const;
+    double videoFramePts(const AVFrame *frame) const;
+
+    // [Convert strand] frame sink 가 있으면 원본 크기 YUV420P 프레임을 만들어 전달
+    void deliverToFrameSink(const AVFrame *frame, AVPixelFormat srcFmt);
+    std::shared_ptr<const VideoFrame> createSinkFrame(const AVFrame *frame, AVPixelFormat srcFmt);
+    bool hasFrameSink() const;
+    // 출력 시각까지 남은 시간 (음수면 늦음, pacing 미사용 시 0)
+    double getPresentationDelay(const VideoFrame &videoFrame) const;
+
+    // 이 디코더의 오디오 시계 기준으로 pts 를 출력하기까지 남은 시간
+    double presentationDelay(double pts) const;
 
     void cleanup();
     int getMaxQueueSize() const;
@@ -123,10 +218,23 @@ private:
     static AVPixelFormat pickSWFormatForCuda(AVPixelFormat hw_mapped);
     void recreateVideoScalerIfNeeded(AVPixelFormat srcFmt, int w, int h);
 
+    // 원본 크기를 출력 크기 힌트 안으로 맞춤 (축소만, 짝수 크기)
+    void fitOutputSize(int srcWidth, int srcHeight, int &width, int &height) const;
+
+    // 출력 크기 힌트 이상을 유지하는 최대 lowres (지원하지 않으면 0)
+    int chooseLowres(const AVCodec *codec) const;
+
+    // [decode strand] 출력 크기 힌트에 맞춰 lowres 가 바뀌면 비디오 코덱을 다시 엶
+    void applyLowres();
+
 private:
     std::string filename;
     DecoderConfig _config;
+    std::optional<std::string> _probeKey;          // ProbeCache 키 (일반 파일만)
 
+    // _fmtCtx 의 custom IO (_fmtCtx 보다 나중에 해제)
+    std::unique_ptr<LiveFileInput> _liveInput;
+    std::unique_ptr<ReadAheadInput> _readAhead;
     AVFormatContext *_fmtCtx{nullptr};
     AVCodecContext *_videoCtx{nullptr};
     AVCodecContext *_audioCtx{nullptr};
@@ -140,11 +248,57 @@ private:
 
     ThreadSafeQueue<VideoFrame> _videoQueue;
     ThreadSafeQueue<AudioFrame> _audioQueue;
+    ThreadSafeQueue<VideoFrame> *_videoOutput{&_videoQueue};
+    ThreadSafeQueue<AudioFrame> *_audioOutput{&_audioQueue};
+    double _timeOffset{0.0};
+    const Decoder *_clockSource{nullptr};
+
+    // DecodeExecutor
+    struct PendingFrame {
+        AVFrame *frame{nullptr};
+        AVPixelFormat scaleSrcFmt{AV_PIX_FMT_NONE};
+        uint64_t generation{0};
+    };
 
-    std::thread _decodeThread;
+    std::shared_ptr<DecodeExecutor::Strand> _decodeStrand;
+    std::shared_ptr<DecodeExecutor::Strand> _convertStrand;
     std::atomic<bool> _decodeRunning{false};
 
+    AVPacket *_packet{nullptr};
+    AVFrame *_decodedVideoFrame{nullptr};
+    AVFrame *_decodedAudioFrame{nullptr};
+    bool _eof{false};
+    std::atomic<bool> _drained{false};
+
+    DecodingState _state;
+    mutable std::mutex _stateMutex;
+
+    // 디코딩된 프레임 -> RGB 변환 대기열 (seek 시 generation 증가로 무효화)
+    std::deque<PendingFrame> _convertQueue;
+    mutable std::mutex _convertMutex;
+    std::atomic<uint64_t> _seekGeneration{0};
+    std::optional<VideoFrame> _pacedFrame;
+    std::atomic<bool> _converting{false};      // 큐에서 꺼낸 프레임을 변환/출력 대기 중
+    uint64_t _pacedGeneration{0};
+
     SeekRequest _seekRequest;
+    std::shared_ptr<IFrameAllocator> _frameAllocator;
+    std::shared_ptr<IPacketSink> _packetSink;
+    mutable std::mutex _packetSinkMutex;
+    std::shared_ptr<IFrameSink> _frameSink;
+    mutable std::mutex _frameSinkMutex;
+    SwsContext *_sinkSwsCtx{nullptr};           // convert strand 전용 (YUV420P 가 아닌 디코딩 포맷)
+
+    // Priority (요청 값은 decode strand 에서 적용)
+    std::atomic<DecodePriority> _requestedPriority{DecodePriority::Full};
+    DecodePriority _appliedPriority{DecodePriority::Full};
+    std::atomic<double> _lastPresentedPts{-1.0};
+    std::atomic<uint64_t> _lateFrames{0};
+    std::atomic<int> _outputWidth{0};
+    std::atomic<int> _outputHeight{0};
+    std::atomic<bool> _outputSizeChanged{false};
+    std::atomic<int> _decodedWidth{0};
+    std::atomic<int> _decodedHeight{0};
 
     CodecInfo _codecInfo;
     std::vector<double> _iFrameTimestamps;
@@ -155,6 +309,11 @@ private:
     // CUDA
     AVBufferRef *_hwDeviceCtx{nullptr};
     AVPixelFormat _currentScaleSrcFmt{AV_PIX_FMT_NONE};
+    // 현재 scaler 의 입력/출력 크기 (_swsCtxMutex)
+    int _scaleSrcWidth{0};
+    int _scaleSrcHeight{0};
+    int _scaleDstWidth{0};
+    int _scaleDstHeight{0};
     bool _useHW{false};
 
     mutable std::mutex _swsCtxMutex;
@@ -163,4 +322,6 @@ private:
 
     static constexpr int8_t MAX_QUEUE_SIZE_HD = 50;
     static constexpr int8_t MAX_QUEUE_SIZE_4K = 20;
+    static constexpr std::chrono::milliseconds QUEUE_FULL_RETRY_INTERVAL{5};
+    static constexpr double LATE_FRAME_THRESHOLD = 0.1;
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Encoder.h"
+
+// 인코딩 지연과 녹화 큐 점유율로 x264 스레드 설정과 preset 을 단계적으로 조정 (실시간 유지 우선)
+// 느려지면 즉시 빠른 단계로, 여유가 오래 유지될 때만 설정 단계까지 되돌림
+class EncodeRateController {
+public:
+    static constexpr std::array<const char *, 9> PRESETS = {
+            "ultrafast", "superfast", "veryfast", "faster", "fast", "medium", "slow", "slower", "veryslow"
+    };
+
+    // 단계: fastestPreset ~ 설정 preset 을 자동 스레드 수 + 프레임 스레드로, 마지막에 설정 스레드 값 그대로
+    // 설정(마지막 단계)부터 시작해서 밀리면 먼저 스레드를 늘리고 그래도 부족하면 preset 을 낮춤
+    EncodeRateController(const EncoderConfig &config, const int fps)
+            : _frameInterval(1.0 / std::max(1, fps)),
+              _cooldownFrames(static_cast<size_t>(std::max(1, fps)) * COOLDOWN_SECONDS),
+              _recoverFrames(static_cast<size_t>(std::max(1, fps)) * RECOVER_SECONDS) {
+        const int fastest = presetIndex(config.fastestPreset);
+        const int slowest = std::max(fastest, presetIndex(config.preset));
+        for (int i = fastest; i <= slowest; ++i) {
+            _steps.push_back({PRESETS[i], BOOST_THREADS, false});
+        }
+        const EncodeStep configured{PRESETS[slowest], config.threads, config.slicedThreads};
+        if (configured != _steps.back()) {
+            _steps.push_back(configured);
+        }
+        _current = static_cast<int>(_steps.size()) - 1;
+    }
+
+    // 프레임 하나의 인코딩 시간과 인코딩 직후 큐 상태 반영
+    // 단계가 바뀌면 방향 반환 (-1: 빠른 쪽, +1: 느린 쪽), 그대로면 0
+    int update(const double encodeSeconds, const size_t queueSize, const size_t maxQueueSize) {
+        _avgEncodeSeconds = _avgEncodeSeconds <= 0.0
+                            ? encodeSeconds
+                            : _avgEncodeSeconds + SMOOTHING * (encodeSeconds - _avgEncodeSeconds);
+        if (++_framesSinceChange < _cooldownFrames) {
+            return 0;
+        }
+
+        const double load = _avgEncodeSeconds / _frameInterval;
+        const double queueFill = maxQueueSize > 0 ? double(queueSize) / double(maxQueueSize) : 0.0;
+
+        // 따라가지 못함: 큐가 차기 시작하거나 프레임 간격을 거의 다 사용
+        if ((load > OVERLOAD_RATIO || queueFill >= QUEUE_HIGH_WATERMARK) && _current > 0) {
+            return step(-1);
+        }
+
+        // 충분한 여유가 일정 시간 유지되면 한 단계 느린(고품질) 설정으로
+        if (load < UNDERLOAD_RATIO && queueSize == 0) {
+            if (++_calmFrames >= _recoverFrames && _current + 1 < static_cast<int>(_steps.size())) {
+                return step(+1);
+            }
+        } else {
+            _calmFrames = 0;
+        }
+        return 0;
+    }
+
+    const EncodeStep &getStep() const { return _steps[_current]; }
+
+    double getLoad() const { return _avgEncodeSeconds / _frameInterval; }
+
+    static int presetIndex(const std::string &preset) {
+        const auto it = std::find(PRESETS.begin(), PRESETS.end(), preset);
+        return it != PRESETS.end() ? static_cast<int>(it - PRESETS.begin()) : DEFAULT_PRESET_INDEX;
+    }
+
+private:
+    int step(const int direction) {
+        _current += direction;
+        _framesSinceChange = 0;
+        _calmFrames = 0;
+        // 단계별 인코딩 시간이 다르므로 새로 측정
+        _avgEncodeSeconds = 0.0;
+        return direction;
+    }
+
+    std::vector<EncodeStep> _steps;
+    int _current{0};
+
+    const double _frameInterval;
+    const size_t _cooldownFrames;
+    const size_t _recoverFrames;
+
+    double _avgEncodeSeconds{0.0};
+    size_t _framesSinceChange{0};
+    size_t _calmFrames{0};
+
+    static constexpr int DEFAULT_PRESET_INDEX = 5;              // medium
+    static constexpr int BOOST_THREADS = 0;                     // x264 자동 (코어 수 기준)
+    static constexpr double SMOOTHING = 0.1;
+    static constexpr double OVERLOAD_RATIO = 0.9;
+    static constexpr double UNDERLOAD_RATIO = 0.5;
+    static constexpr double QUEUE_HIGH_WATERMARK = 0.5;
+    static constexpr size_t COOLDOWN_SECONDS = 2;
+    static constexpr size_t RECOVER_SECONDS = 10;
+};
@@ -1,4 +1,5 @@
 #include "Encoder.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -7,6 +8,7 @@
 #include <cstring>
 #include <stdexcept>
 #include <utility>
+#include <future>
 
 namespace fs = std::filesystem;
 
@@ -22,31 +24,24 @@ Encoder::Encoder(std::string  outputDir, int segmentDuration, OutputFormat forma
     
     fs::create_directories(_outputDir);
     
-    _frame = av_frame_alloc();
     _pkt = av_packet_alloc();
-    if (!_frame || !_pkt) {
-        throw std::runtime_error("Could not allocate frame or packet");
+    if (!_pkt) {
+        throw std::runtime_error("Could not allocate packet");
     }
-    
-    _conversionBuffer.reserve(1920 * 1080 * 4 /* RGB+A */);
 }
 
 Encoder::~Encoder() {
     finalize();
-    if (_frame) {
-        av_frame_free(&_frame);
-    }
 
     if (_pkt) {
         av_packet_free(&_pkt);
     }
 
-    if (_swsCtx) {
-        sws_freeContext(_swsCtx);
-    }
+    releaseConversionContexts();
+    av_buffer_pool_uninit(&_framePool);
 }
 
-bool Encoder::initialize(int width, int height, int fps, AVPixelFormat inputFormat) {
+bool Encoder::initialize(int width, int height, int fps, const EncoderConfig& config) {
     std::lock_guard<std::mutex> lock(_mutex);
     
     if (width <= 0 || height <= 0 || fps <= 0) {
@@ -57,18 +52,71 @@ bool Encoder::initialize(int width, int height, int fps, AVPixelFormat inputForm
     _width = width;
     _height = height;
     _fps = fps;
-    _inputFormat = inputFormat;
+    _config = config;
+    _step = {config.preset, config.threads, config.slicedThreads};
+    _requestedStep = _step;
     
-    if (!setupCodec(width, height, fps, false, inputFormat)) {
+    if (!setupCodec(width, height, fps, false)) {
         std::cerr << "Failed to set up codec" << std::endl;
         return false;
     }
+
+    const int bufferSize = av_image_get_buffer_size(AV_PIX_FMT_YUV420P, width, height, FRAME_ALIGN);
+    _framePool = av_buffer_pool_init(bufferSize, nullptr);
+    if (!_framePool) {
+        std::cerr << "Could not allocate frame pool" << std::endl;
+        return false;
+    }
+
+    if (!updateVideoParams()) {
+        return false;
+    }
     
     _initialized = true;
+    prepareNextSegment();
+    return true;
+}
+
+bool Encoder::initializeRemux(const PacketStreamInfo& info) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!info.videoParams || info.videoTimeBase.num <= 0 || info.videoTimeBase.den <= 0) {
+        std::cerr << "Invalid stream parameters for remux" << std::endl;
+        return false;
+    }
+
+    // 디코더 수명과 분리하기 위해 파라미터 복사
+    _videoParams = avcodec_parameters_alloc();
+    if (!_videoParams || avcodec_parameters_copy(_videoParams, info.videoParams) < 0) {
+        avcodec_parameters_free(&_videoParams);
+        return false;
+    }
+    _videoTimeBase = info.videoTimeBase;
+
+    if (info.audioParams && info.audioTimeBase.num > 0 && info.audioTimeBase.den > 0) {
+        const AVOutputFormat* oformat = av_guess_format(formatName(), nullptr, nullptr);
+        if (oformat && avformat_query_codec(oformat, info.audioParams->codec_id, FF_COMPLIANCE_NORMAL) == 1) {
+            _audioParams = avcodec_parameters_alloc();
+            if (!_audioParams || avcodec_parameters_copy(_audioParams, info.audioParams) < 0) {
+                avcodec_parameters_free(&_audioParams);
+            }
+            _audioTimeBase = info.audioTimeBase;
+        } else {
+            std::cerr << "Audio codec not supported by output container, recording video only" << std::endl;
+        }
+    }
+
+    _width = _videoParams->width;
+    _height = _videoParams->height;
+    _waitForKeyframe = true;
+    _lastVideoDts = AV_NOPTS_VALUE;
+    _remux = true;
+    _initialized = true;
+    prepareNextSegment();
     return true;
 }
 
-bool Encoder::setupCodec(int width, int height, int fps, bool bframe, AVPixelFormat pixFmt) {
+bool Encoder::setupCodec(int width, int height, int fps, bool bframe) {
     const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_H264);
     if (!codec) {
         return false;
@@ -80,7 +128,8 @@ bool Encoder::setupCodec(int width, int height, int fps, bool bframe, AVPixelFor
     }
     
     _videoStream.enc->codec_id = AV_CODEC_ID_H264;
-    _videoStream.enc->bit_rate = 4000000;
+    _videoStream.enc->bit_rate = _config.bitRate;
+    _videoStream.enc->thread_count = _step.threads;
     _videoStream.enc->width = width;
     _videoStream.enc->height = height;
     _videoStream.enc->time_base = (AVRational){1, fps};
@@ -88,11 +137,23 @@ bool Encoder::setupCodec(int width, int height, int fps, bool bframe, AVPixelFor
     _videoStream.enc->gop_size = fps * 2;
     _videoStream.enc->max_b_frames = bframe ? 2 : 0;
     _videoStream.enc->pix_fmt = AV_PIX_FMT_YUV420P;
+
+    // mp4 는 SPS/PPS 를 avcC(extradata)에 기록하므로 전역 헤더로 출력
+    // (세그먼트 출력 컨텍스트는 코덱보다 나중에 열리므로 포맷으로 확인)
+    const AVOutputFormat* oformat = av_guess_format(formatName(), nullptr, nullptr);
+    if (oformat && (oformat->flags & AVFMT_GLOBALHEADER)) {
+        _videoStream.enc->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    }
     
-    av_opt_set(_videoStream.enc->priv_data, "preset", "slow", 0);
-    av_opt_set(_videoStream.enc->priv_data, "crf", "23", 0);
+    av_opt_set(_videoStream.enc->priv_data, "preset", _step.preset.c_str(), 0);
+    av_opt_set_int(_videoStream.enc->priv_data, "crf", _config.crf, 0);
     av_opt_set(_videoStream.enc->priv_data, "profile", "high", 0);
     av_opt_set(_videoStream.enc->priv_data, "level", "4.0", 0);
+    // 세그먼트 경계에서 I 로 지정한 프레임을 IDR 로 인코딩
+    av_opt_set(_videoStream.enc->priv_data, "forced-idr", "1", 0);
+    if (_step.slicedThreads) {
+        av_opt_set(_videoStream.enc->priv_data, "x264-params", "sliced-threads=1", 0);
+    }
 
     if (bframe) {
         av_opt_set(_videoStream.enc->priv_data, "bframes", "2", 0);
@@ -107,31 +168,97 @@ bool Encoder::setupCodec(int width, int height, int fps, bool bframe, AVPixelFor
 
     if (avcodec_open2(_videoStream.enc, codec, nullptr) < 0) {
         std::cerr << "Could not open codec" << std::endl;
+        avcodec_free_context(&_videoStream.enc);
         return false;
     }
     
-    if (pixFmt != AV_PIX_FMT_YUV420P) {
-        _swsCtx = sws_getContext(width, height, pixFmt, width, height, AV_PIX_FMT_YUV420P,
-                                SWS_BICUBIC, nullptr, nullptr, nullptr);
-        if (!_swsCtx) {
-            std::cerr << "Could not initialize the conversion context" << std::endl;
-            return false;
-        }
+    return true;
+}
+
+bool Encoder::updateVideoParams() {
+    // 세그먼트 파일은 백그라운드에서 열리므로 인코더 컨텍스트 대신 파라미터 사본 사용
+    if (!_videoParams) {
+        _videoParams = avcodec_parameters_alloc();
     }
-    
+    if (!_videoParams || avcodec_parameters_from_context(_videoParams, _videoStream.enc) < 0) {
+        avcodec_parameters_free(&_videoParams);
+        return false;
+    }
+    _videoTimeBase = _videoStream.enc->time_base;
     return true;
 }
 
-std::string Encoder::generateOutputFilename() const {
+void Encoder::requestStep(const EncodeStep& step, const bool immediate) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _requestedStep = step;
+    _requestedImmediate = immediate;
+}
+
+EncodeStep Encoder::getStep() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _step;
+}
+
+void Encoder::reconfigureCodec() {
+    // x264 는 열린 상태에서 preset/스레드 설정을 바꿀 수 없으므로 남은 패킷을 기록하고 다시 엶
+    avcodec_send_frame(_videoStream.enc, nullptr);
+    writeEncodedPackets();
+    avcodec_free_context(&_videoStream.enc);
+
+    const EncodeStep previous = _step;
+    _step = _requestedStep;
+    if (!setupCodec(_width, _height, _fps, false)) {
+        std::cerr << "Could not reopen encoder with preset " << _step.preset << std::endl;
+        _step = previous;
+        _requestedStep = previous;
+        if (!setupCodec(_width, _height, _fps, false)) {
+            return;
+        }
+    }
+    if (previous != _step) {
+        std::cout << "Encoder settings changed: " << previous.preset << " -> " << _step.preset
+                  << ", threads " << previous.threads << " -> " << _step.threads
+                  << ", sliced-threads " << previous.slicedThreads << " -> " << _step.slicedThreads
+                  << " (threads 0 = auto)" << std::endl;
+    }
+
+    // SPS/PPS 가 같으면 새 인코더의 첫 IDR 부터 현재 세그먼트에 이어서 기록
+    const auto *enc = _videoStream.enc;
+    if (_videoParams && enc->extradata_size == _videoParams->extradata_size &&
+        (enc->extradata_size == 0 ||
+         std::memcmp(enc->extradata, _videoParams->extradata, enc->extradata_size) == 0)) {
+        return;
+    }
+
+    // SPS/PPS 가 바뀌므로 미리 연 세그먼트를 버리고 새 파라미터로 다음 키프레임부터 새 세그먼트
+    if (_nextSegment.valid()) {
+        discardOutputFile(_nextSegment.get());
+        --_nextSegmentIndex;
+    }
+    if (!updateVideoParams()) {
+        avcodec_free_context(&_videoStream.enc);
+        return;
+    }
+    _rolloverPending = true;
+    prepareNextSegment();
+}
+
+std::string Encoder::generateOutputFilename(const int segment) const {
     auto now = system_clock::now();
     auto now_time = system_clock::to_time_t(now);
     std::tm tm = *std::localtime(&now_time);
     
     std::ostringstream ss;
-    ss << std::put_time(&tm, "%Y%m%d_%H%M%S") << "_part" << _currentSegment;
+    if (_schedule) {
+        // 같은 세션의 원본/rendition 은 같은 part 에 같은 파일명 사용
+        ss << _schedule->segmentName(segment);
+    } else {
+        ss << std::put_time(&tm, "%Y%m%d_%H%M%S") << "_part" << segment;
+    }
     
     switch (_outputFormat) {
-        case OutputFormat::MP4: ss << ".mp4"; break;
+        case OutputFormat::MP4:
+        case OutputFormat::FragmentedMP4: ss << ".mp4"; break;
         case OutputFormat::MKV: ss << ".mkv"; break;
         case OutputFormat::MOV: ss << ".mov"; break;
     }
@@ -139,251 +266,502 @@ std::string Encoder::generateOutputFilename() const {
     return _outputDir + ss.str();
 }
 
-bool Encoder::convertFrame(const VideoFrame& frame, AVFrame* dstFrame) {
-    if (!dstFrame || frame.data.empty()) {
-        return false;
+const char* Encoder::formatName() const {
+    switch (_outputFormat) {
+        case OutputFormat::MKV: return "matroska";
+        case OutputFormat::MOV: return "mov";
+        case OutputFormat::MP4:
+        case OutputFormat::FragmentedMP4:
+        default: return "mp4";
     }
+}
 
-    if (dstFrame->data[0] == nullptr) {
-        dstFrame->format = AV_PIX_FMT_YUV420P;
-        dstFrame->width = frame.width;
-        dstFrame->height = frame.height;
-
-        if (av_frame_get_buffer(dstFrame, 32) < 0) {
-            std::cerr << "Could not allocate frame data" << std::endl;
-            return false;
-        }
+AVPixelFormat Encoder::toAVPixelFormat(const VideoFrame::PixelFormat format) {
+    switch (format) {
+        case VideoFrame::PixelFormat::RGBA: return AV_PIX_FMT_RGBA;
+        case VideoFrame::PixelFormat::YUV420P: return AV_PIX_FMT_YUV420P;
+        case VideoFrame::PixelFormat::RGB24:
+        default: return AV_PIX_FMT_RGB24;
     }
+}
 
-    const auto rgb_size = frame.width * frame.height * 3;
-    const auto rgba_size = frame.width * frame.height * 4;
-    const auto yuv420p_size = frame.width * frame.height * 3 / 2;
-
-    if (frame.data.size() == rgba_size) {
-        if (!_swsCtx) {
-            _swsCtx = sws_getContext(frame.width, frame.height, AV_PIX_FMT_RGBA, dstFrame->width, dstFrame->height,
-                                     AV_PIX_FMT_YUV420P, SWS_BICUBIC, nullptr, nullptr, nullptr);
-
-            if (!_swsCtx) {
-                return false;
-            }
-        }
-
-        const uint8_t *srcData[1] = {frame.data.data()};
-        int srcLinesize[1] = {frame.width * 4}; // RGBA
+void Encoder::releaseFrameHandle(void* opaque, uint8_t* /*data*/) {
+    delete static_cast<std::shared_ptr<const VideoFrame>*>(opaque);
+}
 
-        sws_scale(_swsCtx, srcData, srcLinesize, 0, frame.height, dstFrame->data, dstFrame->linesize);
+AVFrame* Encoder::createInputFrame(const std::shared_ptr<const VideoFrame>& frame) {
+    if (!frame || frame->empty() || frame->pixelSize() < frame->frameSize()) {
+        return nullptr;
+    }
 
-        return true;
-    } else if (frame.data.size() == rgb_size) {
-        if (_swsCtx) {
-            sws_freeContext(_swsCtx);
-            _swsCtx = nullptr;
-        }
+    // 이미 인코더 포맷/크기이면 변환 없이 참조 (RenditionThread 가 변환한 원본 크기 프레임, ClipExporter)
+    // 재생 녹화의 디코더 출력은 RGB24 이므로 convertFrame 에서 한 번 변환
+    if (frame->format == VideoFrame::PixelFormat::YUV420P && frame->width == _width && frame->height == _height) {
+        return wrapFrame(frame);
+    }
+    return convertFrame(*frame);
+}
 
-        int flags = SWS_BICUBIC | SWS_ACCURATE_RND | SWS_FULL_CHR_H_INT;
-        _swsCtx = sws_getContext(frame.width, frame.height, AV_PIX_FMT_RGB24, frame.width, frame.height,
-                                 AV_PIX_FMT_YUV420P, flags, nullptr, nullptr, nullptr);
+AVFrame* Encoder::wrapFrame(const std::shared_ptr<const VideoFrame>& frame) const {
+    AVFrame* avFrame = av_frame_alloc();
+    if (!avFrame) {
+        return nullptr;
+    }
 
-        if (!_swsCtx) {
-            return false;
-        }
+    // AVBuffer 가 해제될 때 VideoFrame 핸들도 해제 (인코더 lookahead 동안 픽셀 유지)
+    auto* handle = new std::shared_ptr<const VideoFrame>(frame);
+    auto* pixels = const_cast<uint8_t*>(frame->pixels());
+    avFrame->buf[0] = av_buffer_create(pixels, frame->frameSize(), &Encoder::releaseFrameHandle, handle,
+                                       AV_BUFFER_FLAG_READONLY);
+    if (!avFrame->buf[0]) {
+        delete handle;
+        av_frame_free(&avFrame);
+        return nullptr;
+    }
 
-        av_frame_unref(dstFrame);
-        dstFrame->format = AV_PIX_FMT_YUV420P;
-        dstFrame->width = frame.width;
-        dstFrame->height = frame.height;
+    avFrame->format = AV_PIX_FMT_YUV420P;
+    avFrame->width = frame->width;
+    avFrame->height = frame->height;
+    av_image_fill_arrays(avFrame->data, avFrame->linesize, pixels, AV_PIX_FMT_YUV420P, frame->width, frame->height, 1);
+    return avFrame;
+}
 
-        if (av_frame_get_buffer(dstFrame, 32) < 0) {
-            return false;
-        }
+AVFrame* Encoder::convertFrame(const VideoFrame& frame) {
+    const AVPixelFormat srcFormat = toAVPixelFormat(frame.format);
+    SwsContext* swsCtx = getConversionContext(srcFormat, frame.width, frame.height);
+    if (!swsCtx || !_framePool) {
+        return nullptr;
+    }
 
-        const uint8_t *srcData[1] = {frame.data.data()};
-        int srcLinesize[1] = {static_cast<int>(frame.width * 3)};
+    AVFrame* avFrame = av_frame_alloc();
+    if (!avFrame) {
+        return nullptr;
+    }
 
-        int result = sws_scale(_swsCtx, srcData, srcLinesize, 0, frame.height, dstFrame->data, dstFrame->linesize);
+    // 풀 버퍼는 인코더가 프레임을 놓으면 자동으로 풀에 반환
+    avFrame->buf[0] = av_buffer_pool_get(_framePool);
+    if (!avFrame->buf[0]) {
+        av_frame_free(&avFrame);
+        return nullptr;
+    }
 
-        if (result <= 0) {
-            return false;
-        }
+    avFrame->format = AV_PIX_FMT_YUV420P;
+    avFrame->width = _width;
+    avFrame->height = _height;
+    av_image_fill_arrays(avFrame->data, avFrame->linesize, avFrame->buf[0]->data, AV_PIX_FMT_YUV420P,
+                         _width, _height, FRAME_ALIGN);
 
-        dstFrame->pts =
-                static_cast<int64_t>(frame.pts * _videoStream.enc->time_base.den / _videoStream.enc->time_base.num);
+    uint8_t* srcData[4] = {nullptr};
+    int srcLinesize[4] = {0};
+    av_image_fill_arrays(srcData, srcLinesize, frame.pixels(), srcFormat, frame.width, frame.height, 1);
 
-        return true;
-    } else if (frame.data.size() == yuv420p_size) {
-        size_t y_size = frame.width * frame.height;
-        size_t uv_size = y_size / 4;
+    const int result = sws_scale(swsCtx, srcData, srcLinesize, 0, frame.height, avFrame->data, avFrame->linesize);
+    if (result <= 0) {
+        av_frame_free(&avFrame);
+        return nullptr;
+    }
 
-        // Y
-        memcpy(dstFrame->data[0], frame.data.data(), y_size);
-        // UV
-        memcpy(dstFrame->data[1], frame.data.data() + y_size, uv_size);
-        memcpy(dstFrame->data[2], frame.data.data() + y_size + uv_size, uv_size);
+    return avFrame;
+}
 
-        return true;
+SwsContext* Encoder::getConversionContext(const AVPixelFormat srcFormat, const int width, const int height) {
+    // 같은 포맷/크기면 기존 컨텍스트를 그대로 반환
+    auto& swsCtx = _swsContexts[srcFormat];
+    swsCtx = sws_getCachedContext(swsCtx, width, height, srcFormat, _width, _height, AV_PIX_FMT_YUV420P,
+                                  SWS_BICUBIC, nullptr, nullptr, nullptr);
+    if (!swsCtx) {
+        std::cerr << "Could not initialize the conversion context" << std::endl;
     }
-
-    return false;
+    return swsCtx;
 }
 
-bool Encoder::openOutputFile() {
-    auto now = std::chrono::system_clock::now();
-    auto now_time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&now_time);
+void Encoder::releaseConversionContexts() {
+    for (auto& [format, swsCtx] : _swsContexts) {
+        sws_freeContext(swsCtx);
+    }
+    _swsContexts.clear();
+}
 
-    std::ostringstream ss;
-    ss << std::put_time(&tm, "%Y%m%d_%H%M%S") << "_part" << _currentSegment;
+AVFormatContext* Encoder::openOutputFile(const int segment) const {
+    const std::string outputPath = generateOutputFilename(segment);
 
-    // Record 파일 확장자 결정
-    switch (_outputFormat) {
-        case OutputFormat::MP4: ss << ".mp4"; break;
-        case OutputFormat::MKV: ss << ".mkv"; break;
-        case OutputFormat::MOV: ss << ".mov"; break;
-        default: ss << ".mp4"; break;
+    AVFormatContext* ctx = nullptr;
+    if (avformat_alloc_output_context2(&ctx, nullptr, formatName(), outputPath.c_str()) < 0 || !ctx) {
+        return nullptr;
     }
 
-    std::string outputPath = _outputDir + ss.str();
-
-    // 포맷 문자열 설정
-    const char* formatName = nullptr;
-    switch (_outputFormat) {
-        case OutputFormat::MP4: formatName = "mp4"; break;
-        case OutputFormat::MKV: formatName = "matroska"; break;
-        case OutputFormat::MOV: formatName = "mov"; break;
-        default: formatName = "mp4"; break;
+    if (!addStreams(ctx)) {
+        avformat_free_context(ctx);
+        return nullptr;
     }
 
-    if (avformat_alloc_output_context2(&_fmtCtx, nullptr, formatName, outputPath.c_str()) < 0) {
-        return false;
+    // 파일 열기 (사전 할당 + 백그라운드 쓰기, writer 는 ctx->opaque 로 보관)
+    if (!(ctx->oformat->flags & AVFMT_NOFILE)) {
+        try {
+            auto writer = std::make_unique<SegmentWriter>(outputPath, expectedSegmentBytes(), _writeMetrics);
+            ctx->pb = writer->context();
+            ctx->flags |= AVFMT_FLAG_CUSTOM_IO;
+            ctx->opaque = writer.release();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            avformat_free_context(ctx);
+            return nullptr;
+        }
     }
 
-    if (!_fmtCtx) {
-        return false;
+    // 조각화 MP4: moov 를 먼저 쓰고 키프레임마다 fragment 를 닫음 (기록 중 읽기 가능, 비정상 종료에도 재생 가능)
+    AVDictionary* options = nullptr;
+    if (_outputFormat == OutputFormat::FragmentedMP4) {
+        av_dict_set(&options, "movflags", "frag_keyframe+empty_moov+default_base_moof", 0);
     }
-    
-    AVStream* stream = avformat_new_stream(_fmtCtx, nullptr);
-    if (!stream) {
-        avformat_free_context(_fmtCtx);
-        _fmtCtx = nullptr;
-        return false;
+
+    // 헤더 쓰기
+    const int ret = avformat_write_header(ctx, &options);
+    av_dict_free(&options);
+    if (ret < 0) {
+        std::cerr << "Error writing header" << std::endl;
+        closeWriter(ctx);
+        avformat_free_context(ctx);
+        return nullptr;
     }
-    
-    if (avcodec_parameters_from_context(stream->codecpar, _videoStream.enc) < 0) {
-        avformat_free_context(_fmtCtx);
-        _fmtCtx = nullptr;
+
+    return ctx;
+}
+
+bool Encoder::addStreams(AVFormatContext* ctx) const {
+    AVStream* video = avformat_new_stream(ctx, nullptr);
+    if (!video || avcodec_parameters_copy(video->codecpar, _videoParams) < 0) {
         return false;
     }
+    // 입력 컨테이너의 tag 는 출력 컨테이너와 호환되지 않을 수 있음
+    video->codecpar->codec_tag = 0;
+    video->time_base = _videoTimeBase;
 
-    // 파일 열기
-    if (!(_fmtCtx->oformat->flags & AVFMT_NOFILE)) {
-        if (avio_open(&_fmtCtx->pb, outputPath.c_str(), AVIO_FLAG_WRITE) < 0) {
-            avformat_free_context(_fmtCtx);
-            _fmtCtx = nullptr;
+    if (_audioParams) {
+        AVStream* audio = avformat_new_stream(ctx, nullptr);
+        if (!audio || avcodec_parameters_copy(audio->codecpar, _audioParams) < 0) {
             return false;
         }
+        audio->codecpar->codec_tag = 0;
+        audio->time_base = _audioTimeBase;
     }
+    return true;
+}
 
-    // 헤더 쓰기
-    if (avformat_write_header(_fmtCtx, nullptr) < 0) {
-        std::cerr << "Error writing header" << std::endl;
-        if (!(_fmtCtx->oformat->flags & AVFMT_NOFILE)) {
-            avio_closep(&_fmtCtx->pb);
-        }
-        avformat_free_context(_fmtCtx);
-        _fmtCtx = nullptr;
-        return false;
+void Encoder::closeOutputFile(AVFormatContext* ctx) {
+    if (!ctx) {
+        return;
     }
     
-    _videoStream.stream = stream;
+    av_write_trailer(ctx);
+    
+    closeWriter(ctx);
+    
+    avformat_free_context(ctx);
+}
 
-    std::cout << "Started new segment: " << outputPath << std::endl;
-    return true;
+void Encoder::closeWriter(AVFormatContext* ctx) {
+    std::unique_ptr<SegmentWriter> writer(static_cast<SegmentWriter*>(ctx->opaque));
+    ctx->opaque = nullptr;
+    if (!writer) {
+        return;
+    }
+
+    avio_flush(ctx->pb);
+    ctx->pb = nullptr;
+    if (!writer->close()) {
+        std::cerr << "Segment was not fully written: " << writer->path() << std::endl;
+    }
 }
 
-void Encoder::closeOutputFile() {
-    if (!_fmtCtx) {
+int64_t Encoder::expectedSegmentBytes() const {
+    int64_t bitRate = _videoParams ? _videoParams->bit_rate : 0;
+    if (_audioParams) {
+        bitRate += _audioParams->bit_rate;
+    }
+    // remux 입력에 비트레이트 정보가 없으면 인코딩 목표값 기준
+    if (bitRate <= 0) {
+        bitRate = _config.bitRate;
+    }
+    // 25% 여유 (남는 블록은 닫을 때 반환)
+    const int64_t bytes = bitRate / 8 * _segmentDuration * 5 / 4;
+    return std::clamp(bytes, MIN_PREALLOCATE_BYTES, MAX_PREALLOCATE_BYTES);
+}
+
+void Encoder::discardOutputFile(AVFormatContext* ctx) {
+    if (!ctx) {
         return;
     }
-    
-    av_write_trailer(_fmtCtx);
-    
-    if (!(_fmtCtx->oformat->flags & AVFMT_NOFILE)) {
-        avio_closep(&_fmtCtx->pb);
+
+    // 사용되지 않은 미리 연 세그먼트는 헤더만 있으므로 삭제
+    const std::string path = ctx->url ? ctx->url : "";
+    closeWriter(ctx);
+    avformat_free_context(ctx);
+
+    std::error_code ec;
+    if (!path.empty()) {
+        fs::remove(path, ec);
     }
-    
-    avformat_free_context(_fmtCtx);
-    _fmtCtx = nullptr;
-    _videoStream.stream = nullptr;
-    
-    _currentSegment++;
+}
+
+void Encoder::prepareNextSegment() {
+    // 다음 세그먼트의 파일 생성/헤더 쓰기를 인코딩 경로 밖에서 미리 수행
+    const int segment = _nextSegmentIndex++;
+    _nextSegment = std::async(std::launch::async, [this, segment] { return openOutputFile(segment); });
+}
+
+AVFormatContext* Encoder::takeNextSegment() {
+    AVFormatContext* ctx = _nextSegment.valid() ? _nextSegment.get() : nullptr;
+    if (!ctx) {
+        // 미리 열기 실패 시 동기적으로 재시도
+        ctx = openOutputFile(_nextSegmentIndex++);
+    }
+    return ctx;
 }
 
 void Encoder::startNewSegment() {
+    AVFormatContext* next = takeNextSegment();
+
+    // trailer/moov 쓰기는 백그라운드에서 (인코딩 경로를 막지 않음)
     if (_fmtCtx) {
-        closeOutputFile();
+        AVFormatContext* previous = _fmtCtx;
+        _pendingCloses.push_back(std::async(std::launch::async, [previous, callback = _segmentClosed] {
+            const std::string path = previous->url ? previous->url : "";
+            closeOutputFile(previous);
+            if (callback && !path.empty()) {
+                callback(path);
+            }
+        }));
     }
+    std::erase_if(_pendingCloses, [](const std::future<void>& close) {
+        return close.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
 
-    const auto success = openOutputFile();
-    if (!success) {
+    _fmtCtx = next;
+    _videoStream.stream = nullptr;
+    _audioOutStream = nullptr;
+    if (!_fmtCtx) {
+        std::cerr << "Could not open output segment" << std::endl;
         return;
     }
 
-    _segmentStartPts = _videoStream.nextPts;
+    _videoStream.stream = _fmtCtx->streams[0];
+    _audioOutStream = _fmtCtx->nb_streams > 1 ? _fmtCtx->streams[1] : nullptr;
+    std::cout << "Started new segment: " << _fmtCtx->url << std::endl;
+
+    prepareNextSegment();
 }
 
-void Encoder::encodeFrame(const VideoFrame& frame) {
-    if (!_initialized) {
+void Encoder::setSegmentClosedCallback(SegmentClosedCallback callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _segmentClosed = std::move(callback);
+}
+
+void Encoder::setSegmentSchedule(std::shared_ptr<SegmentSchedule> schedule, const bool leader) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _schedule = std::move(schedule);
+    _scheduleLeader = leader;
+}
+
+void Encoder::waitPendingSegments() {
+    if (_nextSegment.valid()) {
+        discardOutputFile(_nextSegment.get());
+    }
+    for (auto& close : _pendingCloses) {
+        close.wait();
+    }
+    _pendingCloses.clear();
+}
+
+void Encoder::startRemuxSegment(const int64_t originUs) {
+    startNewSegment();
+    _segmentOriginUs = originUs;
+}
+
+void Encoder::markDiscontinuity() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _waitForKeyframe = true;
+}
+
+void Encoder::writePacket(const AVPacket* packet, const bool isVideo) {
+    if (!_initialized || !_remux || !packet) {
         return;
     }
-    
+
     std::lock_guard<std::mutex> lock(_mutex);
 
-    // 최초 프레임 또는 세그먼트 시간 초과
-    bool needNewSegment = !_fmtCtx || (_videoStream.nextPts - _segmentStartPts) >= _segmentDuration * _fps;
-    if (needNewSegment) {
-        std::cout << "Need new segment. Current PTS: " << _videoStream.nextPts
-                  << ", Segment start PTS: " << _segmentStartPts
-                  << ", Duration threshold: " << (_segmentDuration * _fps) << std::endl;
-        startNewSegment();
+    const AVRational srcTimeBase = isVideo ? _videoTimeBase : _audioTimeBase;
+    const int64_t dts = packet->dts != AV_NOPTS_VALUE ? packet->dts : packet->pts;
+    if (dts == AV_NOPTS_VALUE) {
+        return;
+    }
+    const int64_t dtsUs = av_rescale_q(dts, srcTimeBase, AV_TIME_BASE_Q);
+
+    if (isVideo) {
+        // 역방향 seek 등으로 dts 가 되돌아가면 다음 키프레임에서 새 세그먼트
+        if (_lastVideoDts != AV_NOPTS_VALUE && dts <= _lastVideoDts) {
+            _waitForKeyframe = true;
+        }
 
-        if (!_fmtCtx) {
+        const bool keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+        if (_waitForKeyframe && !keyframe) {
             return;
         }
 
-        if (!_videoStream.stream) {
-            return;
+        // 세그먼트는 키프레임에서만 분할 (각 파일이 독립적으로 재생 가능)
+        const bool segmentFull = _fmtCtx && (dtsUs - _segmentOriginUs) >= int64_t(_segmentDuration) * AV_TIME_BASE;
+        if (keyframe && (_waitForKeyframe || !_fmtCtx || segmentFull)) {
+            startRemuxSegment(dtsUs);
+            _waitForKeyframe = false;
         }
+        _lastVideoDts = dts;
     }
 
-    if (!_videoStream.enc) {
+    // 첫 키프레임 이전의 오디오는 버림
+    if (!_fmtCtx || _waitForKeyframe) {
         return;
     }
 
-    if (!_frame->data[0]) {
-        _frame->format = AV_PIX_FMT_YUV420P;
-        _frame->width = _width;
-        _frame->height = _height;
-        if (av_frame_get_buffer(_frame, 32) < 0) {
-            std::cerr << "Could not allocate frame data" << std::endl;
-            return;
+    AVStream* outStream = isVideo ? _videoStream.stream : _audioOutStream;
+    if (!outStream) {
+        return;
+    }
+
+    const int64_t offset = av_rescale_q(_segmentOriginUs, AV_TIME_BASE_Q, srcTimeBase);
+    if (!isVideo && dts - offset < 0) {
+        return;
+    }
+
+    if (av_packet_ref(_pkt, packet) < 0) {
+        return;
+    }
+
+    // 세그먼트 시작 키프레임 기준으로 timestamp 재정렬
+    if (_pkt->pts != AV_NOPTS_VALUE) {
+        _pkt->pts -= offset;
+    }
+    if (_pkt->dts != AV_NOPTS_VALUE) {
+        _pkt->dts -= offset;
+    }
+    av_packet_rescale_ts(_pkt, srcTimeBase, outStream->time_base);
+    _pkt->stream_index = outStream->index;
+    _pkt->pos = -1;
+
+    const int ret = av_interleaved_write_frame(_fmtCtx, _pkt);
+    if (ret < 0) {
+        char errbuf[AV_ERROR_MAX_STRING_SIZE];
+        av_strerror(ret, errbuf, AV_ERROR_MAX_STRING_SIZE);
+        std::cerr << "Error writing packet: " << errbuf << std::endl;
+    }
+    av_packet_unref(_pkt);
+
+    if (isVideo) {
+        _frameCounter++;
+    }
+}
+
+void Encoder::encodeFrame(const std::shared_ptr<const VideoFrame>& frame, const int64_t sequence) {
+    if (!_initialized || _remux) {
+        return;
+    }
+
+    // rendition 은 leader 가 이 프레임까지 경계를 정할 때까지 대기 (락 밖에서)
+    const bool following = _schedule && !_scheduleLeader && sequence >= 0;
+    const int schedulePart = following ? _schedule->waitPart(sequence) : -1;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        encodeFrameLocked(frame, sequence, schedulePart);
+    }
+
+    // 경계 기록 후 진행 알림 (대기 중인 rendition 이 이 프레임의 part 를 알 수 있도록)
+    if (_schedule && _scheduleLeader && sequence >= 0) {
+        _schedule->advance(sequence);
+    }
+}
+
+void Encoder::followSchedule(const int part) {
+    if (part <= _schedulePart) {
+        return;
+    }
+
+    // 미뤄 둔 설정 변경은 경계에서 적용, 이전 part 전환이 아직 대기 중이면 인코더를 비워 먼저 마무리
+    if (_videoStream.enc && (_requestedStep != _step || _rolloverPending)) {
+        reconfigureCodec();
+    }
+
+    // 프레임 유실로 part 를 건너뛰었으면 미리 연 파일 번호를 맞춤
+    if (_nextSegmentIndex - 1 != part) {
+        if (_nextSegment.valid()) {
+            discardOutputFile(_nextSegment.get());
         }
+        _nextSegmentIndex = part;
+        prepareNextSegment();
     }
-    
-    if (!convertFrame(frame, _frame)) {
+
+    // 첫 세그먼트 전이면 첫 키프레임이 시작
+    _rolloverPending = _fmtCtx != nullptr;
+    _forceKeyframe = true;
+    _schedulePart = part;
+}
+
+void Encoder::encodeFrameLocked(const std::shared_ptr<const VideoFrame>& frame, const int64_t sequence,
+                                const int schedulePart) {
+    const bool following = schedulePart >= 0;
+    if (following) {
+        followSchedule(schedulePart);
+    } else {
+        // 빠른 단계는 실시간 유지를 위해 바로 적용하고, 느린 단계는 세그먼트 경계까지 미뤄 짧은 세그먼트를 만들지 않음
+        const bool segmentDue = !_rolloverPending && _fmtCtx &&
+                                (_videoStream.nextPts - _segmentStartPts) >= int64_t(_segmentDuration) * _fps;
+        if (_videoStream.enc && _requestedStep != _step && (_requestedImmediate || segmentDue)) {
+            reconfigureCodec();
+        }
+    }
+
+    if (!_videoStream.enc) {
+        return;
+    }
+
+    AVFrame* inputFrame = createInputFrame(frame);
+    if (!inputFrame) {
         return;
     }
     
-    _frame->pts = _videoStream.nextPts++;
-    _frame->pkt_dts = _frame->pts;
+    inputFrame->pts = _videoStream.nextPts++;
+    inputFrame->pkt_dts = inputFrame->pts;
+
+    // 세그먼트 시간 초과 시 IDR 을 강제하고, 해당 키프레임 패킷이 나올 때 파일 전환
+    // (rendition 은 leader 의 경계에서만)
+    if (_forceKeyframe) {
+        inputFrame->pict_type = AV_PICTURE_TYPE_I;
+        _forceKeyframe = false;
+    } else if (!following && !_rolloverPending && _fmtCtx &&
+               (inputFrame->pts - _segmentStartPts) >= int64_t(_segmentDuration) * _fps) {
+        inputFrame->pict_type = AV_PICTURE_TYPE_I;
+        _rolloverPending = true;
+    }
+
+    // leader: 이 프레임부터 새 part (시간 초과 또는 SPS 변경)
+    if (_schedule && _scheduleLeader && sequence >= 0 && _rolloverPending && !_boundaryAnnounced) {
+        _schedule->addBoundary(sequence);
+        _boundaryAnnounced = true;
+    }
     
-    int ret = avcodec_send_frame(_videoStream.enc, _frame);
+    // 인코더가 버퍼 참조를 가져가므로 프레임 구조체만 해제
+    const int ret = avcodec_send_frame(_videoStream.enc, inputFrame);
+    av_frame_free(&inputFrame);
     if (ret < 0) {
         return;
     }
     
+    writeEncodedPackets();
+    _frameCounter++;
+}
+
+void Encoder::writeEncodedPackets() {
     while (true) {
-        ret = avcodec_receive_packet(_videoStream.enc, _pkt);
+        int ret = avcodec_receive_packet(_videoStream.enc, _pkt);
         if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
             break;
         } else if (ret < 0) {
@@ -391,12 +769,22 @@ void Encoder::encodeFrame(const VideoFrame& frame) {
             break;
         }
 
-        if (!_videoStream.stream) {
+        // 최초 키프레임 또는 강제 IDR 에서 새 세그먼트 시작 (각 세그먼트가 IDR 로 시작)
+        if ((_pkt->flags & AV_PKT_FLAG_KEY) && (!_fmtCtx || _rolloverPending)) {
+            startNewSegment();
+            _segmentStartPts = _pkt->pts;
+            _rolloverPending = false;
+            _boundaryAnnounced = false;
+        }
+
+        if (!_fmtCtx || !_videoStream.stream) {
             av_packet_unref(_pkt);
-            break;
+            continue;
         }
 
-        // PTS 조정
+        // 세그먼트 시작 기준으로 PTS 조정
+        _pkt->pts -= _segmentStartPts;
+        _pkt->dts -= _segmentStartPts;
         av_packet_rescale_ts(_pkt, _videoStream.enc->time_base, _videoStream.stream->time_base);
         _pkt->stream_index = _videoStream.stream->index;
 
@@ -410,8 +798,6 @@ void Encoder::encodeFrame(const VideoFrame& frame) {
         
         av_packet_unref(_pkt);
     }
-
-    _frameCounter++;
 }
 
 void Encoder::finalize() {
@@ -422,44 +808,30 @@ void Encoder::finalize() {
     std::lock_guard<std::mutex> lock(_mutex);
     
     try {
+        // Get remaining packets
         if (_videoStream.enc) {
             avcodec_send_frame(_videoStream.enc, nullptr);
-            
-            // Get remaining packets
-            while (true) {
-                int ret = avcodec_receive_packet(_videoStream.enc, _pkt);
-                if (ret == AVERROR_EOF || ret == AVERROR(EAGAIN)) {
-                    break;
-                } else if (ret < 0) {
-                    std::cerr << "Error flushing encoder" << std::endl;
-                    break;
-                }
-                
-                // Write remaining packets
-                if (_fmtCtx && _videoStream.stream) {
-                    av_packet_rescale_ts(_pkt, _videoStream.enc->time_base, _videoStream.stream->time_base);
-                    _pkt->stream_index = _videoStream.stream->index;
-                    
-                    if (av_interleaved_write_frame(_fmtCtx, _pkt) < 0) {
-                        std::cerr << "Error writing packet during finalize" << std::endl;
-                    }
-                }
-                
-                av_packet_unref(_pkt);
-            }
+            writeEncodedPackets();
         }
         
-        closeOutputFile();
+        const std::string lastSegment = _fmtCtx && _fmtCtx->url ? _fmtCtx->url : "";
+        closeOutputFile(_fmtCtx);
+        _fmtCtx = nullptr;
+        _videoStream.stream = nullptr;
+        _audioOutStream = nullptr;
+        waitPendingSegments();
+        if (_segmentClosed && !lastSegment.empty()) {
+            _segmentClosed(lastSegment);
+        }
         
         if (_videoStream.enc) {
             avcodec_free_context(&_videoStream.enc);
             _videoStream.enc = nullptr;
         }
         
-        if (_swsCtx) {
-            sws_freeContext(_swsCtx);
-            _swsCtx = nullptr;
-        }
+        releaseConversionContexts();
+        avcodec_parameters_free(&_videoParams);
+        avcodec_parameters_free(&_audioParams);
 
         _initialized = false;
         std::cout << "Encoder finalized. Total frames encoded: " << _frameCounter << std::endl;
@@ -4,10 +4,16 @@
 #include <filesystem>
 #include <memory>
 #include <atomic>
+#include <functional>
+#include <future>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
+#include "SegmentSchedule.h"
+#include "SegmentWriter.h"
 #include "ThreadSafeQueue.h"
 #include "VideoFrame.h"
+#include "interface/IPacketSink.h"
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -17,10 +23,34 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
+// x264 인코딩 설정
+struct EncoderConfig {
+    std::string preset{"slow"};
+    int crf{23};
+    int64_t bitRate{4000000};
+    int threads{0};                     // 0 이면 자동
+    bool slicedThreads{false};          // 프레임 대신 슬라이스 단위 스레드 (지연 감소, 압축률 약간 손해)
+
+    // 녹화가 실시간을 따라가지 못하면 먼저 자동 스레드 수/프레임 스레드로, 그래도 밀리면 preset 을 fastestPreset 까지 낮춤
+    // (여유가 생기면 역순으로 복귀, 빠른 단계는 바로, 느린 단계는 다음 세그먼트 경계에서 적용)
+    bool adaptivePreset{true};
+    std::string fastestPreset{"ultrafast"};
+};
+
+// 녹화 중 조정하는 인코더 설정 (EncodeRateController 단계)
+struct EncodeStep {
+    std::string preset;
+    int threads{0};
+    bool slicedThreads{false};
+
+    bool operator==(const EncodeStep &) const = default;
+};
+
 class Encoder {
 public:
     enum class OutputFormat {
         MP4,
+        FragmentedMP4,  // 기록 중에도 읽을 수 있고 비정상 종료 시에도 moov 재작성 불필요
         MKV,
         MOV
     };
@@ -31,14 +61,47 @@ public:
     
     ~Encoder();
 
-    bool initialize(int width, int height, int fps, AVPixelFormat inputFormat);
+    bool initialize(int width, int height, int fps, const EncoderConfig& config);
+
+    // stream copy 모드: 재인코딩 없이 입력 패킷을 세그먼트 파일로 remux (세그먼트는 키프레임에서 분할)
+    bool initializeRemux(const PacketStreamInfo& info);
+
+    void writePacket(const AVPacket* packet, bool isVideo);
+
+    // 입력 불연속(패킷 유실, 역방향 seek) 이후 다음 키프레임에서 새 세그먼트 시작
+    void markDiscontinuity();
     
-    void encodeFrame(const VideoFrame& frame);
+    // 프레임은 인코더(lookahead)가 참조를 놓을 때까지 공유될 수 있으므로 핸들로 전달
+    // sequence: 세그먼트 schedule 을 공유하는 Encoder 들에 같은 번호로 전달되는 입력 프레임 번호
+    void encodeFrame(const std::shared_ptr<const VideoFrame>& frame, int64_t sequence = -1);
+
+    // 같은 세션의 Encoder 끼리 세그먼트 경계와 파일명 공유 (initialize 전에 호출)
+    // leader 가 아니면 leader 가 나눈 입력 프레임에서만 세그먼트를 나누고, preset 변경도 그 경계에서 적용
+    void setSegmentSchedule(std::shared_ptr<SegmentSchedule> schedule, bool leader);
     
     void finalize();
     
     bool isInitialized() const { return _initialized; }
 
+    // [Encode thread] 인코더를 새 preset/스레드 설정으로 다시 엶 (immediate 면 다음 프레임, 아니면 다음 세그먼트 경계)
+    // SPS/PPS 가 같으면 현재 세그먼트를 이어서 기록, 다르면 새 세그먼트 시작
+    void requestStep(const EncodeStep& step, bool immediate);
+
+    const EncoderConfig& getConfig() const { return _config; }
+
+    EncodeStep getStep() const;
+
+    int getFps() const { return _fps; }
+
+    // 세그먼트 파일이 닫힌 뒤 경로 전달 (백그라운드 close 스레드에서 호출되므로 대기 없이 반환해야 함)
+    using SegmentClosedCallback = std::function<void(const std::string&)>;
+    void setSegmentClosedCallback(SegmentClosedCallback callback);
+
+    // 세그먼트 파일 쓰기 지연/대기 지표 (이 Encoder 의 모든 세그먼트 누적)
+    WriteStats getWriteStats() const { return _writeMetrics->snapshot(); }
+
+    static AVPixelFormat toAVPixelFormat(VideoFrame::PixelFormat format);
+
 private:
     struct OutputStream {
         AVStream* stream{nullptr};
@@ -46,36 +109,91 @@ private:
         int64_t nextPts{0};
     };
 
-    bool setupCodec(int width, int height, int fps, bool bframe, AVPixelFormat inputFormat);
-    bool openOutputFile();
-    void closeOutputFile();
+    bool setupCodec(int width, int height, int fps, bool bframe);
+    void reconfigureCodec();
+    bool updateVideoParams();
+    void writeEncodedPackets();
+    void encodeFrameLocked(const std::shared_ptr<const VideoFrame>& frame, int64_t sequence, int schedulePart);
+    // [rendition] leader 가 시작한 part 로 전환 준비
+    void followSchedule(int part);
+
+    // 세그먼트 파일 (다음 파일은 미리 열고, 이전 파일은 백그라운드에서 닫음)
+    AVFormatContext* openOutputFile(int segment) const;
+    bool addStreams(AVFormatContext* ctx) const;
+    static void closeOutputFile(AVFormatContext* ctx);
+    static void discardOutputFile(AVFormatContext* ctx);
+    // ctx->opaque 의 SegmentWriter 기록 완료 후 해제
+    static void closeWriter(AVFormatContext* ctx);
+    // 비트레이트 x 세그먼트 길이로 사전 할당 크기 추정
+    int64_t expectedSegmentBytes() const;
+    void prepareNextSegment();
+    AVFormatContext* takeNextSegment();
     void startNewSegment();
+    void startRemuxSegment(int64_t originUs);
+    void waitPendingSegments();
     
-    bool convertFrame(const VideoFrame& frame, AVFrame* dstFrame);
+    // 인코더 입력 AVFrame 생성 (YUV420P 동일 크기는 복사 없이 참조, 그 외는 풀 버퍼로 변환)
+    AVFrame* createInputFrame(const std::shared_ptr<const VideoFrame>& frame);
+    AVFrame* wrapFrame(const std::shared_ptr<const VideoFrame>& frame) const;
+    AVFrame* convertFrame(const VideoFrame& frame);
+    SwsContext* getConversionContext(AVPixelFormat srcFormat, int width, int height);
+    void releaseConversionContexts();
+    static void releaseFrameHandle(void* opaque, uint8_t* data);
     
-    std::string generateOutputFilename() const;
+    std::string generateOutputFilename(int segment) const;
+    const char* formatName() const;
     
     std::string _outputDir;
     int _segmentDuration;
     int64_t _segmentStartPts{0};
-    int64_t _nextSegmentPts{0};
+    bool _rolloverPending{false};
     OutputFormat _outputFormat;
     
     AVFormatContext* _fmtCtx{nullptr};
     OutputStream _videoStream;
-    SwsContext* _swsCtx{nullptr};
-    AVFrame* _frame{nullptr};
+    EncoderConfig _config;
+    EncodeStep _step;
+    EncodeStep _requestedStep;
+    bool _requestedImmediate{false};
+    // 입력 포맷별 변환 컨텍스트 (크기 변경 시 sws_getCachedContext 로 갱신)
+    std::unordered_map<int, SwsContext*> _swsContexts;
+    // 인코더가 참조 중인 프레임이 반환될 때까지 재사용되는 YUV420P 버퍼 풀
+    AVBufferPool* _framePool{nullptr};
     AVPacket* _pkt{nullptr};
+
+    // 출력 스트림 파라미터 (Transcode 는 인코더에서, Remux 는 입력 스트림에서 복사)
+    AVCodecParameters* _videoParams{nullptr};
+    AVCodecParameters* _audioParams{nullptr};
+    AVRational _videoTimeBase{0, 1};
+    AVRational _audioTimeBase{0, 1};
+
+    std::future<AVFormatContext*> _nextSegment;
+    std::vector<std::future<void>> _pendingCloses;
+    SegmentClosedCallback _segmentClosed;
+    int _nextSegmentIndex{0};
+    std::shared_ptr<SegmentSchedule> _schedule;
+    bool _scheduleLeader{false};
+    bool _boundaryAnnounced{false};     // [leader] 대기 중인 rollover 를 schedule 에 기록했는지
+    int _schedulePart{0};               // [rendition] 기록 중(또는 시작 대기 중)인 part
+    bool _forceKeyframe{false};
+    std::shared_ptr<WriteMetrics> _writeMetrics{std::make_shared<WriteMetrics>()};
+
+    // Remux (stream copy)
+    bool _remux{false};
+    AVStream* _audioOutStream{nullptr};
+    int64_t _segmentOriginUs{0};
+    int64_t _lastVideoDts{AV_NOPTS_VALUE};
+    bool _waitForKeyframe{true};
     
     std::atomic<bool> _initialized{false};
-    std::mutex _mutex;
+    mutable std::mutex _mutex;
     int _frameCounter{0};
-    int _currentSegment{0};
     
     int _width{0};
     int _height{0};
     int _fps{0};
-    AVPixelFormat _inputFormat{AV_PIX_FMT_NONE};
-    
-    std::vector<uint8_t> _conversionBuffer;
+
+    static constexpr int FRAME_ALIGN = 32;
+    static constexpr int64_t MIN_PREALLOCATE_BYTES = 8LL * 1024 * 1024;
+    static constexpr int64_t MAX_PREALLOCATE_BYTES = 1024LL * 1024 * 1024;
 };
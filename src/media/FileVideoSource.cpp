@@ -1,169 +1,284 @@
 #include "FileVideoSource.h"
-#include <cstring>
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <spdlog/spdlog.h>
 
 FileVideoSource::FileVideoSource(const std::string &filename, IDecoderSource::DecoderConfig config)
-    : _decoder(std::make_unique<Decoder>(filename, config)) {
-    _outputDir = "record";
-    std::filesystem::create_directories(_outputDir);
+    : _decoder(std::make_unique<Decoder>(filename, config)),
+      _recorder(std::make_unique<Recorder>(*_decoder, Recorder::DEFAULT_OUTPUT_DIR)) {
 }
 
-FileVideoSource::~FileVideoSource() = default;
+FileVideoSource::~FileVideoSource() {
+    // proxy 가 원본 큐에 쓰는 중일 수 있으므로 먼저 정지
+    if (_proxyDecoder) {
+        _proxyDecoder->stop();
+        _proxyDecoder.reset();
+    }
+}
 
 void FileVideoSource::start() {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _running = true;
     _decoder->start();
+    if (_usingProxy) {
+        _proxyDecoder->start();
+    }
 }
 
 void FileVideoSource::stop() {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _running = false;
+    if (_proxyDecoder) {
+        _proxyDecoder->stop();
+    }
     _decoder->stop();
 }
 
 void FileVideoSource::flush() {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    if (_proxyDecoder) {
+        _proxyDecoder->flush();
+    }
     _decoder->flush();
 }
 
 bool FileVideoSource::seek(double timeInSeconds) {
-    return _decoder->seek(timeInSeconds);
-}
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _lastSeekTarget = timeInSeconds;
+
+    if (_proxyDecoder) {
+        const auto now = ProxySwitchPolicy::Clock::now();
+        _proxyPolicy.onSeek(now);
+        // 스크러빙이 시작되면 다음 update 를 기다리지 않고 바로 proxy 로 seek
+        if (_proxyPolicy.shouldUseProxy(_playbackHint.playing, _playbackHint.speed, _usingProxy, now) &&
+            !_usingProxy && _running && !_recordingFrames) {
+            switchToProxy(timeInSeconds);
+            return _decoder->seek(timeInSeconds);
+        }
+    }
 
-double FileVideoSource::getDuration() const {
-    return _decoder->getDuration();
+    // 오디오는 항상 원본에서 디코딩하므로 원본도 함께 seek
+    const bool result = _decoder->seek(timeInSeconds);
+    if (_usingProxy) {
+        return _proxyDecoder->seek(timeInSeconds) && result;
+    }
+    return result;
 }
 
-CodecInfo FileVideoSource::getCodecInfo() const {
-    return _decoder->getCodecInfo();
-}
+void FileVideoSource::setPlaybackHint(const PlaybackHint &hint) {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _playbackHint = hint;
+    _decoder->setClockPaused(!hint.playing);
+    if (!_proxyDecoder || !_running) {
+        return;
+    }
 
-ThreadSafeQueue<VideoFrame> &FileVideoSource::getVideoQueue() {
-    return _decoder->getVideoQueue();
-}
+    const auto now = ProxySwitchPolicy::Clock::now();
+    if (!_usingProxy && hint.playing) {
+        _proxyPolicy.onLateFrames(_decoder->getLateFrames(), now);
+    }
 
-ThreadSafeQueue<AudioFrame> &FileVideoSource::getAudioQueue() {
-    return _decoder->getAudioQueue();
+    const bool useProxy = !_recordingFrames && _proxyPolicy.shouldUseProxy(hint.playing, hint.speed, _usingProxy, now);
+    if (useProxy && !_usingProxy) {
+        switchToProxy(currentPosition());
+    } else if (!useProxy && _usingProxy) {
+        switchToOriginal(currentPosition());
+    }
 }
 
-Decoder &FileVideoSource::decoder() {
-    return *_decoder;
+void FileVideoSource::setOutputSize(const int width, const int height) {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _decoder->setOutputSize(width, height);
+    if (_proxyDecoder) {
+        _proxyDecoder->setOutputSize(width, height);
+    }
 }
 
-void FileVideoSource::startRecord() {
-    if (_isRecording) {
-        return;
+bool FileVideoSource::setProxy(const std::string &proxyFilename) {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    if (_running) {
+        spdlog::warn("Proxy must be set before start: {}", proxyFilename);
+        return false;
     }
 
+    IDecoderSource::DecoderConfig config;
+    config.enableAudio = false;
+    std::unique_ptr<Decoder> proxy;
     try {
-        auto now = std::chrono::system_clock::now();
-        auto now_time = std::chrono::system_clock::to_time_t(now);
-        std::tm tm = *std::localtime(&now_time);
+        proxy = std::make_unique<Decoder>(proxyFilename, config);
+    } catch (const std::exception &e) {
+        spdlog::warn("Failed to open proxy {}: {}", proxyFilename, e.what());
+        return false;
+    }
 
-        std::ostringstream ss;
-        ss << _outputDir << "/recording_" << std::put_time(&tm, "%Y%m%d_%H%M%S");
-        std::string sessionDir = ss.str();
+    // 다른 내용의 파일이 등록되지 않도록 길이와 화면비 확인
+    const double durationDiff = std::abs(proxy->getDuration() - _decoder->getDuration());
+    const double aspect = _decoder->getVideoHeight() > 0
+                          ? double(_decoder->getVideoWidth()) / _decoder->getVideoHeight() : 0.0;
+    const double proxyAspect = proxy->getVideoHeight() > 0
+                               ? double(proxy->getVideoWidth()) / proxy->getVideoHeight() : 0.0;
+    if (durationDiff > PROXY_DURATION_TOLERANCE || std::abs(aspect - proxyAspect) > PROXY_ASPECT_TOLERANCE) {
+        spdlog::warn("Proxy {} does not match source (duration diff {:.2f}s, aspect {:.3f} vs {:.3f})",
+                     proxyFilename, durationDiff, proxyAspect, aspect);
+        return false;
+    }
 
-        if (!std::filesystem::create_directories(sessionDir)) {
-            throw std::runtime_error("Failed to create recording directory: " + sessionDir);
-        }
+    // 출력 PTS 를 원본 시간축으로 맞춤
+    proxy->setTimeOffset(_decoder->getStartTime() - proxy->getStartTime());
+    proxy->setVideoOutput(_decoder->getVideoQueue());
+    // 오디오가 없으므로 원본 디코더의 오디오 시계로 출력 시점 결정
+    proxy->setClockSource(*_decoder);
+
+    _proxyDecoder = std::move(proxy);
+    _usingProxy = false;
+    spdlog::info("Proxy registered: {} ({}x{})", proxyFilename,
+                 _proxyDecoder->getVideoWidth(), _proxyDecoder->getVideoHeight());
+    return true;
+}
 
-        auto codecInfo = _decoder->getCodecInfo();
-        if (!codecInfo.hasVideo) {
-            throw std::runtime_error("No video stream available for recording");
+std::string FileVideoSource::findProxyFile(const std::string &filename) {
+    namespace fs = std::filesystem;
+    const fs::path path(filename);
+    std::vector<fs::path> candidates{
+            path.parent_path() / (path.stem().string() + "_proxy" + path.extension().string()),
+            path.parent_path() / "proxy" / path.filename()
+    };
+
+    // 녹화 세션의 rendition 폴더 (<세션>/proxy_360p/<원본 세그먼트 파일명>)
+    std::error_code ec;
+    std::vector<fs::path> renditions;
+    const fs::path dir = path.parent_path().empty() ? fs::path(".") : path.parent_path();
+    for (const auto &entry: fs::directory_iterator(dir, ec)) {
+        if (entry.path().filename().string().rfind("proxy_", 0) == 0 && entry.is_directory(ec)) {
+            renditions.push_back(entry.path() / path.filename());
         }
+    }
+    std::sort(renditions.begin(), renditions.end());
+    candidates.insert(candidates.end(), renditions.begin(), renditions.end());
 
-        size_t xPos = codecInfo.videoResolution.find('x');
-        if (xPos == std::string::npos) {
-            throw std::runtime_error("Invalid video resolution format");
+    for (const auto &candidate: candidates) {
+        if (fs::is_regular_file(candidate, ec)) {
+            return candidate.string();
         }
+    }
+    return {};
+}
 
-        int width = std::stoi(codecInfo.videoResolution.substr(0, xPos));
-        int height = std::stoi(codecInfo.videoResolution.substr(xPos + 1));
+bool FileVideoSource::isUsingProxy() const {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    return _usingProxy;
+}
 
-        int fps = 30;
+void FileVideoSource::setPriority(const IDecoderSource::DecodePriority priority) {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _priority = priority;
+    if (_usingProxy) {
+        _proxyDecoder->setPriority(priority);
+    } else {
+        _decoder->setPriority(priority);
+    }
+}
 
-        _encoder = std::make_unique<Encoder>(sessionDir, 180, Encoder::OutputFormat::MP4);
-        if (!_encoder->initialize(
-                width,
-                height,
-                fps,
-                AV_PIX_FMT_RGBA)) {
-            throw std::runtime_error("Failed to initialize encoder");
-        }
+bool FileVideoSource::isSeekPending() const {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    return _decoder->isSeekPending() || (_usingProxy && _proxyDecoder->isSeekPending());
+}
 
-        _isRecording = true;
-        spdlog::info("Started recording to: {}", sessionDir);
-    } catch (const std::exception &e) {
-        _encoder.reset();
-        _isRecording = false;
-        spdlog::error("Failed to start recording: {}", e.what());
-        throw;
-    }
+bool FileVideoSource::isFinished() const {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    return _decoder->isFinished() && (!_usingProxy || _proxyDecoder->isFinished());
 }
 
-void FileVideoSource::stopRecord() {
-    if (!_isRecording) {
-        spdlog::warn("No active recording to stop");
-        return;
+bool FileVideoSource::rewind() {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    if (_running) {
+        return false;
     }
+    _lastSeekTarget = 0.0;
+    const bool result = _decoder->rewind();
+    return _proxyDecoder ? _proxyDecoder->rewind() && result : result;
+}
 
-    try {
-        _isRecording = false;
-
-        if (_encoder) {
-            try {
-                _encoder->finalize();
-            } catch (const std::exception& e) {
-                spdlog::warn("Error finalizing encoder: {}", e.what());
-            }
-            _encoder.reset();
-        }
+void FileVideoSource::restartClock() {
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    // proxy 는 원본 디코더 시계를 따름
+    _decoder->restartClock();
+}
 
-        spdlog::info("Recording stopped and saved");
-    } catch (const std::exception &e) {
-        spdlog::error("Error while stopping recording: {}", e.what());
-        _encoder.reset();
-        _isRecording = false;
-        throw;
-    }
+void FileVideoSource::switchToProxy(const double position) {
+    // proxy 를 먼저 위치시킨 뒤 원본 비디오 디코딩 중단 (seek 시 공유 큐는 proxy 가 비움)
+    _proxyDecoder->setPriority(_priority);
+    _proxyDecoder->seek(position);
+    _proxyDecoder->start();
+    _decoder->setPriority(IDecoderSource::DecodePriority::Disabled);
+    _usingProxy = true;
+    spdlog::info("Switched to proxy decoding at {:.3f}s", position);
 }
 
-void FileVideoSource::encodeFrame(const VideoFrame &frame) {
-    if (!_isRecording || !_encoder) {
-        return;
+void FileVideoSource::switchToOriginal(const double position) {
+    // 원본은 참조 프레임이 없으므로 현재 위치로 다시 seek (오디오도 함께 재동기화)
+    _proxyDecoder->stop();
+    _decoder->setPriority(_priority);
+    _decoder->seek(position);
+    _usingProxy = false;
+    spdlog::info("Switched to original decoding at {:.3f}s", position);
+}
+
+double FileVideoSource::currentPosition() const {
+    if (_decoder->isSeekPending() || (_usingProxy && _proxyDecoder->isSeekPending())) {
+        return _lastSeekTarget;
     }
+    const double pts = _usingProxy ? _proxyDecoder->getLastPresentedPts() : _decoder->getLastPresentedPts();
+    return pts >= 0.0 ? pts : _lastSeekTarget;
+}
 
-    try {
-        VideoFrame frameCopy = frame;
+double FileVideoSource::getDuration() const {
+    return _decoder->getDuration();
+}
 
-        if (frameCopy.width <= 0 || frameCopy.height <= 0) {
-            return;
-        }
+CodecInfo FileVideoSource::getCodecInfo() const {
+    return _decoder->getCodecInfo();
+}
 
-        if (frameCopy.data.empty()) {
-            return;
-        }
+ThreadSafeQueue<VideoFrame> &FileVideoSource::getVideoQueue() {
+    return _decoder->getVideoQueue();
+}
 
-        size_t rgb_size = frameCopy.width * frameCopy.height * 3;
-        size_t rgba_size = frameCopy.width * frameCopy.height * 4;
-        size_t yuv420p_size = frameCopy.width * frameCopy.height * 3 / 2;
+ThreadSafeQueue<AudioFrame> &FileVideoSource::getAudioQueue() {
+    return _decoder->getAudioQueue();
+}
 
-        if (frameCopy.data.size() != rgb_size && frameCopy.data.size() != rgba_size &&
-            frameCopy.data.size() != yuv420p_size) {
-            return;
-        }
+Decoder &FileVideoSource::decoder() {
+    return *_decoder;
+}
 
-        std::string formatName = "";
-        if (frameCopy.data.size() == rgba_size) {
-            formatName = "RGBA";
-        } else if (frameCopy.data.size() == rgb_size) {
-            formatName = "RGB";
-        } else if (frameCopy.data.size() == yuv420p_size) {
-            formatName = "YUV420P";
-        } else {
-            formatName = "UNKNOWN";
-        }
-        _encoder->encodeFrame(frameCopy);
-    } catch (const std::exception &e) {
+void FileVideoSource::startRecord(const RecordOptions &options) {
+    _recorder->start(options);
+    if (options.mode != RecordMode::Transcode) {
+        return;
     }
+
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _recordingFrames = true;
+    if (_usingProxy) {
+        switchToOriginal(currentPosition());
+    }
+}
+
+void FileVideoSource::stopRecord() {
+    _recorder->stop();
+
+    std::lock_guard<std::mutex> lock(_proxyMutex);
+    _recordingFrames = false;
+}
+
+void FileVideoSource::setPreRecord(const PreRecordConfig &config) {
+    _recorder->setPreRecord(config);
+}
+
+uint64_t FileVideoSource::getDroppedRecordFrames() const {
+    return _recorder->getDroppedFrames();
 }
 
 std::vector<double> FileVideoSource::getIFrameTimestamps() const {
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include "Decoder.h"
-#include "Encoder.h"
+#include "ProxySwitchPolicy.h"
+#include "Recorder.h"
 #include "media/interface/IVideoSource.h"
 
 class FileVideoSource final : public IVideoSource {
@@ -16,14 +18,42 @@ public:
 
     void stop() override;
 
-    void startRecord() override;
+    void startRecord(const RecordOptions &options) override;
 
     void stopRecord() override;
 
+    void setPreRecord(const PreRecordConfig &config) override;
+
     void flush() override;
 
     bool seek(double timeInSeconds) override;
 
+    void setPlaybackHint(const PlaybackHint &hint) override;
+
+    void setOutputSize(int width, int height) override;
+
+    // 같은 내용의 저해상도 파일 등록, 스크러빙/고배속/디코딩 여유 부족 시 비디오만 proxy 에서 디코딩
+    // (원본과 같은 시간축이어야 함, start 전에 호출)
+    bool setProxy(const std::string &proxyFilename);
+
+    bool isUsingProxy() const;
+
+    // "<이름>_proxy.<확장자>", 같은 폴더의 proxy/<파일명>, 녹화 rendition 의 proxy_*/<파일명> 순 (없으면 빈 문자열)
+    static std::string findProxyFile(const std::string &filename);
+
+    void setPriority(IDecoderSource::DecodePriority priority);
+
+    bool isSeekPending() const;
+
+    // EOF 까지 디코딩한 프레임을 모두 큐로 출력했는지 (proxy 사용 중이면 proxy 비디오 포함)
+    bool isFinished() const;
+
+    // 정지 상태에서 처음 위치로 되돌림 (warm pool 재사용)
+    bool rewind();
+
+    // 미리 디코딩해 둔 큐를 유지한 채 재생을 시작할 때 재생 기준 시각 재설정
+    void restartClock();
+
     double getDuration() const override;
 
     CodecInfo getCodecInfo() const override;
@@ -34,15 +64,31 @@ public:
 
     Decoder &decoder();
 
-    void encodeFrame(const VideoFrame &frame) override;
+    uint64_t getDroppedRecordFrames() const override;
 
     std::vector<double> getIFrameTimestamps() const override;
 
     std::vector<double> getPFrameTimestamps() const override;
 
 private:
+    void switchToProxy(double position);
+    void switchToOriginal(double position);
+    double currentPosition() const;
+
     std::unique_ptr<Decoder> _decoder;
-    std::unique_ptr<Encoder> _encoder;
-    std::string _outputDir;
-    bool _isRecording{false};
+    std::unique_ptr<Recorder> _recorder;
+
+    // proxy 는 원본 비디오 큐로 출력하므로 원본보다 먼저 해제
+    std::unique_ptr<Decoder> _proxyDecoder;
+    ProxySwitchPolicy _proxyPolicy;
+    PlaybackHint _playbackHint;
+    IDecoderSource::DecodePriority _priority{IDecoderSource::DecodePriority::Full};
+    bool _usingProxy{false};
+    bool _recordingFrames{false};       // Transcode 녹화는 원본 디코더 프레임을 받으므로 proxy 로 전환하지 않음
+    bool _running{false};
+    double _lastSeekTarget{0.0};
+    mutable std::mutex _proxyMutex;
+
+    static constexpr double PROXY_DURATION_TOLERANCE = 1.0;
+    static constexpr double PROXY_ASPECT_TOLERANCE = 0.02;
 };
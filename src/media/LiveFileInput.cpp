@@ -0,0 +1,432 @@
+#include "LiveFileInput.h"
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#endif
+
+#include "SegmentedVideoSource.h"
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+    uint32_t readU32(const uint8_t *p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    uint64_t readU64(const uint8_t *p) {
+        return (static_cast<uint64_t>(readU32(p)) << 32) | readU32(p + 4);
+    }
+
+    // 최상위 box 헤더 (size==0 인 box 는 크기 미정이라 완성 전으로 취급)
+    bool readBoxHeader(const int fd, const int64_t offset, const int64_t fileSize,
+                       uint64_t &boxSize, uint32_t &headerSize, std::string &type) {
+        uint8_t header[16];
+        if (offset + 8 > fileSize || pread(fd, header, 8, offset) != 8) {
+            return false;
+        }
+        boxSize = readU32(header);
+        headerSize = 8;
+        if (boxSize == 1) {
+            if (offset + 16 > fileSize || pread(fd, header + 8, 8, offset + 8) != 8) {
+                return false;
+            }
+            boxSize = readU64(header + 8);
+            headerSize = 16;
+        }
+        type.assign(reinterpret_cast<const char *>(header + 4), 4);
+        return boxSize >= headerSize;
+    }
+
+    template<typename Fn>
+    void forEachChild(const uint8_t *data, const size_t size, Fn &&fn) {
+        size_t pos = 0;
+        while (pos + 8 <= size) {
+            uint64_t boxSize = readU32(data + pos);
+            size_t headerSize = 8;
+            if (boxSize == 1) {
+                if (pos + 16 > size) {
+                    return;
+                }
+                boxSize = readU64(data + pos + 8);
+                headerSize = 16;
+            } else if (boxSize == 0) {
+                boxSize = size - pos;
+            }
+            if (boxSize < headerSize || boxSize > size - pos) {
+                return;
+            }
+            fn(std::string_view(reinterpret_cast<const char *>(data + pos + 4), 4),
+               data + pos + headerSize, static_cast<size_t>(boxSize - headerSize));
+            pos += boxSize;
+        }
+    }
+
+    // 최상위에 moof 가 하나라도 기록되었는지 (Encoder 가 미리 열어 둔 다음 세그먼트 구분)
+    bool hasFragment(const std::string &path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st{};
+        fstat(fd, &st);
+
+        bool found = false;
+        int64_t offset = 0;
+        uint64_t boxSize = 0;
+        uint32_t headerSize = 0;
+        std::string type;
+        while (!found && readBoxHeader(fd, offset, st.st_size, boxSize, headerSize, type)) {
+            found = type == "moof";
+            offset += static_cast<int64_t>(boxSize);
+        }
+        close(fd);
+        return found;
+    }
+}
+
+LiveFileInput::LiveFileInput(std::string path, const double latencySeconds) : _path(std::move(path)) {
+    _fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) {
+        throw std::runtime_error("Failed to open live segment " + _path);
+    }
+
+#ifdef __linux__
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotifyFd >= 0 &&
+        inotify_add_watch(_inotifyFd, _path.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF) < 0) {
+        close(_inotifyFd);
+        _inotifyFd = -1;
+    }
+    _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_inotifyFd < 0 || _wakeFd < 0) {
+        spdlog::warn("inotify unavailable for {}, falling back to polling", _path);
+    }
+#endif
+
+    {
+        std::lock_guard<std::mutex> lock(_scanMutex);
+        scanBoxes();
+    }
+    if (_initSize == 0 || _videoTrackId == 0 || _videoTimescale == 0) {
+        closeHandles();
+        throw std::runtime_error("No fragmented MP4 video track in " + _path);
+    }
+
+    // live edge 에서 latency 만큼 뒤의 fragment 부터 (fragment 가 아직 없으면 처음부터)
+    _spliceOffset = _initSize;
+    if (!_fragments.empty()) {
+        const double target = _fragments.back().time - latencySeconds;
+        auto it = std::upper_bound(_fragments.begin(), _fragments.end(), target,
+                                   [](const double t, const Fragment &fragment) { return t < fragment.time; });
+        if (it != _fragments.begin()) {
+            --it;
+        }
+        _spliceOffset = it->offset;
+        _startTime = it->time;
+    }
+
+    auto *buffer = static_cast<unsigned char *>(av_malloc(IO_BUFFER_SIZE));
+    _avio = buffer ? avio_alloc_context(buffer, IO_BUFFER_SIZE, 0, this, &LiveFileInput::readPacket, nullptr,
+                                        &LiveFileInput::seekPacket) : nullptr;
+    if (!_avio) {
+        av_free(buffer);
+        closeHandles();
+        throw std::runtime_error("Failed to allocate live input context");
+    }
+    // 비탐색 입력으로 두어 demuxer 가 열 때 파일 끝까지 fragment 를 훑지 않고 순서대로 읽게 함
+    _avio->seekable = 0;
+
+    spdlog::info("Live tail {}: edge {:.1f}s, starting at {:.1f}s ({} fragments)",
+                 _path, _fragments.empty() ? 0.0 : _fragments.back().time, _startTime, _fragments.size());
+}
+
+LiveFileInput::~LiveFileInput() {
+    if (_avio) {
+        av_freep(&_avio->buffer);
+        avio_context_free(&_avio);
+    }
+    closeHandles();
+}
+
+double LiveFileInput::getLiveEdge() {
+    std::lock_guard<std::mutex> lock(_scanMutex);
+    scanBoxes();
+    return _fragments.empty() ? _startTime : _fragments.back().time;
+}
+
+void LiveFileInput::interrupt() {
+    _interrupted = true;
+#ifdef __linux__
+    if (_wakeFd >= 0) {
+        const uint64_t one = 1;
+        [[maybe_unused]] const auto written = write(_wakeFd, &one, sizeof(one));
+    }
+#endif
+}
+
+void LiveFileInput::resume() {
+    _interrupted = false;
+    // 중단으로 남은 오류/EOF 상태 해제
+    if (_avio) {
+        _avio->eof_reached = 0;
+        _avio->error = 0;
+    }
+}
+
+std::string LiveFileInput::findActiveSegment(const std::string &recordDir) {
+    std::string sessionDir = recordDir;
+    if (!SegmentedVideoSource::isSessionDirectory(recordDir)) {
+        // 세션 디렉터리 이름은 시작 시각이므로 이름이 가장 큰 세션이 최신
+        std::error_code ec;
+        std::string latest;
+        for (const auto &entry: fs::directory_iterator(recordDir, ec)) {
+            const auto candidate = entry.path().string();
+            if (entry.is_directory(ec) && candidate > latest && SegmentedVideoSource::isSessionDirectory(candidate)) {
+                latest = candidate;
+            }
+        }
+        if (latest.empty()) {
+            return {};
+        }
+        sessionDir = latest;
+    }
+
+    // Encoder 가 다음 세그먼트를 미리 열어 두므로 fragment 가 기록된 마지막 세그먼트를 선택
+    const auto segments = SegmentedVideoSource::listSegmentFiles(sessionDir);
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        if (hasFragment(*it)) {
+            return *it;
+        }
+    }
+    return segments.empty() ? std::string{} : segments.back();
+}
+
+int LiveFileInput::readPacket(void *opaque, uint8_t *buf, const int size) {
+    return static_cast<LiveFileInput *>(opaque)->read(buf, size);
+}
+
+int64_t LiveFileInput::seekPacket(void *opaque, const int64_t offset, const int whence) {
+    return static_cast<LiveFileInput *>(opaque)->seek(offset, whence);
+}
+
+int LiveFileInput::read(uint8_t *buf, int size) {
+    // init 부분과 이어 붙인 fragment 는 파일에서 연속이 아니므로 경계에서 나눠 읽음
+    if (_position < _initSize) {
+        size = static_cast<int>(std::min<int64_t>(size, _initSize - _position));
+    }
+
+    while (!_interrupted) {
+        const ssize_t n = pread(_fd, buf, size, toFileOffset(_position));
+        if (n > 0) {
+            _position += n;
+            return static_cast<int>(n);
+        }
+        if (n < 0 && errno != EINTR) {
+            return AVERROR(errno);
+        }
+        if (n == 0 && !waitForData()) {
+            return _interrupted ? AVERROR_EXIT : AVERROR_EOF;
+        }
+    }
+    return AVERROR_EXIT;
+}
+
+int64_t LiveFileInput::seek(const int64_t offset, int whence) {
+    whence &= ~AVSEEK_FORCE;
+    if (whence == AVSEEK_SIZE) {
+        // 기록 중에는 계속 커짐
+        return virtualSize();
+    }
+
+    int64_t target = -1;
+    if (whence == SEEK_SET) {
+        target = offset;
+    } else if (whence == SEEK_CUR) {
+        target = _position + offset;
+    } else if (whence == SEEK_END) {
+        target = virtualSize() + offset;
+    }
+    if (target < 0) {
+        return AVERROR(EINVAL);
+    }
+    _position = target;
+    return target;
+}
+
+bool LiveFileInput::waitForData() {
+    const auto idleSince = std::chrono::steady_clock::now();
+    while (!_interrupted) {
+        // 대기 전에 다시 확인 (이벤트 사이에 기록된 내용 누락 방지)
+        if (fileSize() > toFileOffset(_position)) {
+            return true;
+        }
+        if (_writerClosed) {
+            return false;
+        }
+        if (std::chrono::steady_clock::now() - idleSince > WRITER_IDLE_TIMEOUT) {
+            spdlog::warn("Live segment {} stopped growing, treating as closed", _path);
+            _writerClosed = true;
+            return false;
+        }
+
+#ifdef __linux__
+        if (_inotifyFd >= 0 && _wakeFd >= 0) {
+            pollfd fds[2] = {{_inotifyFd, POLLIN, 0}, {_wakeFd, POLLIN, 0}};
+            const int timeoutMs = static_cast<int>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(WRITER_IDLE_TIMEOUT).count());
+            if (poll(fds, 2, timeoutMs) < 0 && errno != EINTR) {
+                return false;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                uint64_t value = 0;
+                [[maybe_unused]] const auto drained = ::read(_wakeFd, &value, sizeof(value));
+            }
+            if (fds[0].revents & POLLIN) {
+                alignas(inotify_event) char events[4096];
+                ssize_t length;
+                while ((length = ::read(_inotifyFd, events, sizeof(events))) > 0) {
+                    for (ssize_t i = 0; i < length;) {
+                        const auto *event = reinterpret_cast<const inotify_event *>(events + i);
+                        if (event->mask & (IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                            _writerClosed = true;
+                        }
+                        i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                    }
+                }
+            }
+            continue;
+        }
+#endif
+        std::this_thread::sleep_for(FALLBACK_POLL_INTERVAL);
+    }
+    return false;
+}
+
+void LiveFileInput::scanBoxes() {
+    const int64_t size = fileSize();
+    uint64_t boxSize = 0;
+    uint32_t headerSize = 0;
+    std::string type;
+
+    while (readBoxHeader(_fd, _scanOffset, size, boxSize, headerSize, type)) {
+        // 아직 끝까지 기록되지 않은 box 는 다음 scan 에서
+        if (boxSize > static_cast<uint64_t>(size - _scanOffset)) {
+            break;
+        }
+
+        if (type == "moov" || type == "moof") {
+            std::vector<uint8_t> payload(boxSize - headerSize);
+            if (pread(_fd, payload.data(), payload.size(), _scanOffset + headerSize) !=
+                static_cast<ssize_t>(payload.size())) {
+                break;
+            }
+            if (type == "moov") {
+                parseMoov(payload);
+                _initSize = _scanOffset + static_cast<int64_t>(boxSize);
+            } else {
+                parseMoof(_scanOffset, payload);
+            }
+        }
+        _scanOffset += static_cast<int64_t>(boxSize);
+    }
+}
+
+void LiveFileInput::parseMoov(const std::vector<uint8_t> &box) {
+    forEachChild(box.data(), box.size(), [this](const std::string_view type, const uint8_t *data, const size_t size) {
+        if (type != "trak" || _videoTrackId != 0) {
+            return;
+        }
+
+        uint32_t trackId = 0;
+        uint32_t timescale = 0;
+        bool video = false;
+        forEachChild(data, size, [&](const std::string_view trakChild, const uint8_t *trak, const size_t trakSize) {
+            if (trakChild == "tkhd" && trakSize >= 24) {
+                // version 1 은 creation/modification time 이 64비트
+                trackId = readU32(trak + (trak[0] == 1 ? 20 : 12));
+            } else if (trakChild == "mdia") {
+                forEachChild(trak, trakSize, [&](const std::string_view mdiaChild, const uint8_t *mdia,
+                                                 const size_t mdiaSize) {
+                    if (mdiaChild == "hdlr" && mdiaSize >= 12) {
+                        video = std::string_view(reinterpret_cast<const char *>(mdia + 8), 4) == "vide";
+                    } else if (mdiaChild == "mdhd" && mdiaSize >= 24) {
+                        timescale = readU32(mdia + (mdia[0] == 1 ? 20 : 12));
+                    }
+                });
+            }
+        });
+
+        if (video && trackId != 0 && timescale != 0) {
+            _videoTrackId = trackId;
+            _videoTimescale = timescale;
+        }
+    });
+}
+
+void LiveFileInput::parseMoof(const int64_t offset, const std::vector<uint8_t> &box) {
+    if (_videoTrackId == 0) {
+        return;
+    }
+
+    forEachChild(box.data(), box.size(), [&](const std::string_view type, const uint8_t *data, const size_t size) {
+        if (type != "traf") {
+            return;
+        }
+
+        uint32_t trackId = 0;
+        std::optional<uint64_t> decodeTime;
+        forEachChild(data, size, [&](const std::string_view trafChild, const uint8_t *traf, const size_t trafSize) {
+            if (trafChild == "tfhd" && trafSize >= 8) {
+                trackId = readU32(traf + 4);
+            } else if (trafChild == "tfdt" && trafSize >= 8) {
+                decodeTime = traf[0] == 1 && trafSize >= 12 ? readU64(traf + 4) : readU32(traf + 4);
+            }
+        });
+
+        if (trackId == _videoTrackId && decodeTime) {
+            _fragments.push_back({offset, static_cast<double>(*decodeTime) / _videoTimescale});
+        }
+    });
+}
+
+int64_t LiveFileInput::fileSize() const {
+    struct stat st{};
+    return fstat(_fd, &st) == 0 ? static_cast<int64_t>(st.st_size) : 0;
+}
+
+int64_t LiveFileInput::toFileOffset(const int64_t position) const {
+    return position < _initSize ? position : position - _initSize + _spliceOffset;
+}
+
+int64_t LiveFileInput::virtualSize() const {
+    return std::max<int64_t>(fileSize() - (_spliceOffset - _initSize), 0);
+}
+
+void LiveFileInput::closeHandles() {
+    for (int *fd: {&_fd, &_inotifyFd, &_wakeFd}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
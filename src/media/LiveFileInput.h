@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avio.h>
+}
+
+// Encoder 가 기록 중인 fragmented MP4 세그먼트를 따라가며 읽는 AVIO 입력
+// 파일 끝에 도달하면 inotify 로 파일이 커지거나 닫힐 때까지 대기 (고정 sleep 폴링 없음)
+// 열 때 live edge - latency 위치의 fragment 를 init 부분(ftyp+moov) 뒤에 이어 붙여 그 위치부터 읽음
+class LiveFileInput {
+public:
+    // moov 를 읽을 수 없으면 예외 (fragment 없이 moov 가 끝에 기록되는 일반 MP4 포함)
+    LiveFileInput(std::string path, double latencySeconds);
+
+    ~LiveFileInput();
+
+    LiveFileInput(const LiveFileInput &) = delete;
+
+    LiveFileInput &operator=(const LiveFileInput &) = delete;
+
+    AVIOContext *context() const { return _avio; }
+
+    // 기록된 마지막 fragment 의 비디오 시작 시각 (초, 새로 기록된 box 만 추가로 파싱)
+    double getLiveEdge();
+
+    // 읽기를 시작한 fragment 의 시각 (초)
+    double getStartTime() const { return _startTime; }
+
+    // 대기 중인 읽기를 깨워 AVERROR_EXIT 반환 (resume 전까지 유지)
+    void interrupt();
+
+    void resume();
+
+    // Encoder 가 파일을 닫음 (이후 파일 끝은 EOF)
+    bool isWriterClosed() const { return _writerClosed.load(); }
+
+    // 녹화 root 또는 세션 디렉터리에서 현재 기록 중인 세그먼트 (없으면 빈 문자열)
+    static std::string findActiveSegment(const std::string &recordDir);
+
+private:
+    struct Fragment {
+        int64_t offset{0};          // moof 위치
+        double time{0.0};           // 비디오 tfdt (초)
+    };
+
+    static int readPacket(void *opaque, uint8_t *buf, int size);
+
+    static int64_t seekPacket(void *opaque, int64_t offset, int whence);
+
+    int read(uint8_t *buf, int size);
+
+    int64_t seek(int64_t offset, int whence);
+
+    // 파일이 읽기 위치보다 커지면 true, writer 종료/중단이면 false
+    bool waitForData();
+
+    // _scanMutex 보유 상태에서 호출 (_scanOffset 이후 완성된 최상위 box 만 파싱)
+    void scanBoxes();
+
+    void parseMoov(const std::vector<uint8_t> &box);
+
+    void parseMoof(int64_t offset, const std::vector<uint8_t> &box);
+
+    int64_t fileSize() const;
+
+    // 가상 스트림 위치 -> 파일 위치 ([0, _initSize) 는 그대로, 이후는 _spliceOffset 부터)
+    int64_t toFileOffset(int64_t position) const;
+
+    int64_t virtualSize() const;
+
+    void closeHandles();
+
+    std::string _path;
+    int _fd{-1};
+    int _inotifyFd{-1};
+    int _wakeFd{-1};
+    AVIOContext *_avio{nullptr};
+
+    int64_t _position{0};
+    int64_t _initSize{0};
+    int64_t _spliceOffset{0};
+    double _startTime{0.0};
+
+    // box 파싱 상태 (reader 와 getLiveEdge 호출 스레드가 공유)
+    std::mutex _scanMutex;
+    int64_t _scanOffset{0};
+    uint32_t _videoTrackId{0};
+    uint32_t _videoTimescale{0};
+    std::vector<Fragment> _fragments;
+
+    std::atomic<bool> _interrupted{false};
+    std::atomic<bool> _writerClosed{false};
+
+    static constexpr int IO_BUFFER_SIZE = 64 * 1024;
+    // 이 시간 동안 파일 변화가 없으면 writer 가 비정상 종료된 것으로 보고 EOF
+    static constexpr auto WRITER_IDLE_TIMEOUT = std::chrono::seconds(30);
+    // inotify 를 쓸 수 없는 플랫폼의 크기 확인 간격
+    static constexpr auto FALLBACK_POLL_INTERVAL = std::chrono::milliseconds(100);
+};
@@ -1,8 +1,8 @@
 #include "NetworkStreamVideoSource.h"
 
 NetworkStreamVideoSource::NetworkStreamVideoSource(const std::string &uri)
-        : _decoder(std::make_unique<Decoder>(uri)) {
-
+        : _decoder(std::make_unique<Decoder>(uri)),
+          _recorder(std::make_unique<Recorder>(*_decoder, Recorder::DEFAULT_OUTPUT_DIR)) {
 }
 
 NetworkStreamVideoSource::~NetworkStreamVideoSource() = default;
@@ -15,6 +15,18 @@ void NetworkStreamVideoSource::stop() {
     _decoder->stop();
 }
 
+void NetworkStreamVideoSource::startRecord(const RecordOptions &options) {
+    _recorder->start(options);
+}
+
+void NetworkStreamVideoSource::stopRecord() {
+    _recorder->stop();
+}
+
+void NetworkStreamVideoSource::setPreRecord(const PreRecordConfig &config) {
+    _recorder->setPreRecord(config);
+}
+
 void NetworkStreamVideoSource::flush() {
     _decoder->flush();
 }
@@ -37,4 +49,16 @@ ThreadSafeQueue<VideoFrame> &NetworkStreamVideoSource::getVideoQueue() {
 
 ThreadSafeQueue<AudioFrame> &NetworkStreamVideoSource::getAudioQueue() {
     return _decoder->getAudioQueue();
+}
+
+uint64_t NetworkStreamVideoSource::getDroppedRecordFrames() const {
+    return _recorder->getDroppedFrames();
+}
+
+std::vector<double> NetworkStreamVideoSource::getIFrameTimestamps() const {
+    return _decoder->getIFrameTimestamps();
+}
+
+std::vector<double> NetworkStreamVideoSource::getPFrameTimestamps() const {
+    return _decoder->getPFrameTimestamps();
 }
\ No newline at end of file
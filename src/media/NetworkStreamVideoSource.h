@@ -2,6 +2,7 @@
 
 #include "media/interface/IVideoSource.h"
 #include "Decoder.h"
+#include "Recorder.h"
 #include <memory>
 
 class NetworkStreamVideoSource : public IVideoSource {
@@ -14,10 +15,20 @@ public:
 
     void stop() override;
 
+    void startRecord(const RecordOptions &options) override;
+
+    void stopRecord() override;
+
+    void setPreRecord(const PreRecordConfig &config) override;
+
     void flush() override;
 
     bool seek(double t) override;
 
+    void setPlaybackHint(const PlaybackHint &) override {}
+
+    void setOutputSize(int, int) override {}
+
     double getDuration() const override;
 
     CodecInfo getCodecInfo() const override;
@@ -26,6 +37,13 @@ public:
 
     ThreadSafeQueue<AudioFrame> &getAudioQueue() override;
 
+    uint64_t getDroppedRecordFrames() const override;
+
+    std::vector<double> getIFrameTimestamps() const override;
+
+    std::vector<double> getPFrameTimestamps() const override;
+
 private:
     std::unique_ptr<Decoder> _decoder;
+    std::unique_ptr<Recorder> _recorder;
 };
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "PacketRing.h"
+#include <spdlog/spdlog.h>
+
+PacketRing::PacketRing(const PacketStreamInfo &info, const PreRecordConfig &config)
+        : _videoTimeBase(info.videoTimeBase),
+          _audioTimeBase(info.audioTimeBase),
+          _durationUs(static_cast<int64_t>(config.seconds * AV_TIME_BASE)),
+          _maxBytes(config.maxBytes) {
+}
+
+PacketRing::~PacketRing() {
+    clearLocked();
+}
+
+void PacketRing::onPacket(const AVPacket *packet, const bool isVideo) {
+    if (!packet) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // 녹화 중이면 그대로 전달 (보관은 계속해서 다음 이벤트의 pre-roll 로 사용)
+    if (_sink) {
+        _sink->onPacket(packet, isVideo);
+    }
+
+    if (isVideo) {
+        const int64_t dts = packet->dts != AV_NOPTS_VALUE ? packet->dts : packet->pts;
+        if (dts == AV_NOPTS_VALUE) {
+            return;
+        }
+
+        // seek 등으로 시간이 되돌아가면 이전 구간은 의미가 없음
+        if (_lastVideoDts != AV_NOPTS_VALUE && dts <= _lastVideoDts) {
+            clearLocked();
+        }
+        _lastVideoDts = dts;
+        _lastVideoUs = av_rescale_q(dts, _videoTimeBase, AV_TIME_BASE_Q);
+
+        if (packet->flags & AV_PKT_FLAG_KEY) {
+            _gops.push_back({_lastVideoUs, {}});
+        }
+    }
+
+    // 첫 키프레임 이전 패킷은 단독으로 디코딩할 수 없으므로 버림
+    if (_gops.empty()) {
+        return;
+    }
+
+    AVPacket *clone = av_packet_clone(packet);
+    if (!clone) {
+        return;
+    }
+    _gops.back().packets.push_back({clone, isVideo});
+    _bytes += clone->size;
+
+    trim();
+}
+
+void PacketRing::trim() {
+    // 다음 GOP 만으로도 보관 시간을 채우거나 메모리 상한을 넘으면 가장 오래된 GOP 제거
+    while (_gops.size() > 1 &&
+           (_lastVideoUs - _gops[1].startUs >= _durationUs || _bytes > _maxBytes)) {
+        for (auto &entry : _gops.front().packets) {
+            _bytes -= entry.packet->size;
+            av_packet_free(&entry.packet);
+        }
+        _gops.pop_front();
+    }
+
+    // 단일 GOP 가 상한보다 크면 보관 포기 (다음 키프레임부터 다시 수집)
+    if (_bytes > _maxBytes) {
+        spdlog::warn("Pre-record GOP exceeds {} bytes, buffer reset", _maxBytes);
+        clearLocked();
+    }
+}
+
+void PacketRing::attach(std::shared_ptr<IPacketSink> sink) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (sink) {
+        size_t count = 0;
+        for (const auto &gop : _gops) {
+            for (const auto &entry : gop.packets) {
+                sink->onBufferedPacket(entry.packet, entry.isVideo);
+                ++count;
+            }
+        }
+        spdlog::info("Flushed {} pre-record packets ({:.1f}s)", count,
+                     _gops.empty() ? 0.0 : double(_lastVideoUs - _gops.front().startUs) / AV_TIME_BASE);
+    }
+    _sink = std::move(sink);
+}
+
+void PacketRing::detach() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sink.reset();
+}
+
+void PacketRing::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    clearLocked();
+}
+
+void PacketRing::clearLocked() {
+    for (auto &gop : _gops) {
+        for (auto &entry : gop.packets) {
+            av_packet_free(&entry.packet);
+        }
+    }
+    _gops.clear();
+    _bytes = 0;
+    _lastVideoDts = AV_NOPTS_VALUE;
+}
+
+size_t PacketRing::getBufferedBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bytes;
+}
+
+double PacketRing::getBufferedSeconds() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _gops.empty() ? 0.0 : double(_lastVideoUs - _gops.front().startUs) / AV_TIME_BASE;
+}
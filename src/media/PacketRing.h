@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "interface/IPacketSink.h"
+
+// 녹화 시작 전 구간(pre-roll)을 위한 압축 패킷 링 버퍼
+struct PreRecordConfig {
+    double seconds{0.0};                     // 0 이면 비활성
+    size_t maxBytes{DEFAULT_MAX_BYTES};      // 채널당 메모리 상한
+
+    static constexpr size_t DEFAULT_MAX_BYTES = 32 * 1024 * 1024;
+};
+
+// 최근 N 초의 패킷을 GOP 단위로 보관 (항상 비디오 키프레임에서 시작)
+// 녹화 시작 시 보관된 패킷을 sink 로 먼저 전달한 뒤 이후 패킷을 그대로 전달
+class PacketRing final : public IPacketSink {
+public:
+    PacketRing(const PacketStreamInfo &info, const PreRecordConfig &config);
+
+    ~PacketRing() override;
+
+    // [Decode thread]
+    void onPacket(const AVPacket *packet, bool isVideo) override;
+
+    // 보관 중인 패킷을 sink 로 flush 하고 이후 패킷을 전달 (순서 보장)
+    void attach(std::shared_ptr<IPacketSink> sink);
+
+    void detach();
+
+    void clear();
+
+    size_t getBufferedBytes() const;
+
+    double getBufferedSeconds() const;
+
+private:
+    struct Entry {
+        AVPacket *packet{nullptr};
+        bool isVideo{false};
+    };
+
+    struct Gop {
+        int64_t startUs{0};
+        std::vector<Entry> packets;
+    };
+
+    void trim();
+
+    void clearLocked();
+
+    const AVRational _videoTimeBase;
+    const AVRational _audioTimeBase;
+    const int64_t _durationUs;
+    const size_t _maxBytes;
+
+    std::deque<Gop> _gops;
+    size_t _bytes{0};
+    int64_t _lastVideoDts{AV_NOPTS_VALUE};
+    int64_t _lastVideoUs{0};
+
+    std::shared_ptr<IPacketSink> _sink;
+    mutable std::mutex _mutex;
+};
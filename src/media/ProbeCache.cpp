@@ -0,0 +1,157 @@
+#include "ProbeCache.h"
+#include <algorithm>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace {
+    struct ProbeLimits {
+        const char *formatPrefix;
+        int64_t probeSize;
+        int64_t analyzeDurationUs;
+    };
+
+    // 색인/헤더에 스트림 정보가 있는 컨테이너는 조금만 읽고, TS 는 PES 를 충분히 보되 기본값(5MB/5s) 보다 줄임
+    constexpr ProbeLimits PROBE_LIMITS[] = {
+            {"mov,mp4", 1 * 1024 * 1024, 500000},
+            {"matroska", 1 * 1024 * 1024, 500000},
+            {"mpegts", 2 * 1024 * 1024, 1000000},
+            {"flv", 1 * 1024 * 1024, 1000000},
+    };
+}
+
+ProbeCache &ProbeCache::instance() {
+    static ProbeCache cache;
+    return cache;
+}
+
+std::optional<std::string> ProbeCache::fileKey(const std::string &path) {
+    struct stat st{};
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return std::nullopt;
+    }
+#ifdef __APPLE__
+    const auto &modified = st.st_mtimespec;
+#else
+    const auto &modified = st.st_mtim;
+#endif
+    return path + '|' + std::to_string(st.st_size) + '|' + std::to_string(modified.tv_sec) + '.' +
+           std::to_string(modified.tv_nsec) + '|' + std::to_string(st.st_ino);
+}
+
+void ProbeCache::tuneProbeLimits(AVFormatContext *ctx) {
+    if (!ctx || !ctx->iformat || !ctx->iformat->name) {
+        return;
+    }
+    for (const auto &limits: PROBE_LIMITS) {
+        if (std::strncmp(ctx->iformat->name, limits.formatPrefix, std::strlen(limits.formatPrefix)) == 0) {
+            ctx->probesize = limits.probeSize;
+            ctx->max_analyze_duration = limits.analyzeDurationUs;
+            return;
+        }
+    }
+}
+
+bool ProbeCache::restore(const std::string &key, AVFormatContext *ctx) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Entry *entry = find(key);
+    if (!entry || entry->streams.size() != ctx->nb_streams) {
+        return false;
+    }
+
+    // 헤더에서 읽은 스트림 구성이 저장 시점과 같은지 먼저 확인
+    for (unsigned i = 0; i < ctx->nb_streams; ++i) {
+        const auto *cached = entry->streams[i].params.get();
+        const auto *current = ctx->streams[i]->codecpar;
+        if (cached->codec_type != current->codec_type || cached->codec_id != current->codec_id) {
+            return false;
+        }
+    }
+
+    for (unsigned i = 0; i < ctx->nb_streams; ++i) {
+        const StreamInfo &info = entry->streams[i];
+        AVStream *stream = ctx->streams[i];
+        if (avcodec_parameters_copy(stream->codecpar, info.params.get()) < 0) {
+            return false;
+        }
+        stream->avg_frame_rate = info.avgFrameRate;
+        stream->r_frame_rate = info.realFrameRate;
+        stream->start_time = info.startTime;
+        stream->duration = info.duration;
+    }
+    ctx->start_time = entry->startTime;
+    ctx->duration = entry->duration;
+    ctx->bit_rate = entry->bitRate;
+    return true;
+}
+
+void ProbeCache::store(const std::string &key, const AVFormatContext *ctx) {
+    Entry entry;
+    entry.streams.reserve(ctx->nb_streams);
+    for (unsigned i = 0; i < ctx->nb_streams; ++i) {
+        const AVStream *stream = ctx->streams[i];
+        StreamInfo info;
+        info.params.reset(avcodec_parameters_alloc());
+        if (!info.params || avcodec_parameters_copy(info.params.get(), stream->codecpar) < 0) {
+            return;
+        }
+        info.avgFrameRate = stream->avg_frame_rate;
+        info.realFrameRate = stream->r_frame_rate;
+        info.startTime = stream->start_time;
+        info.duration = stream->duration;
+        entry.streams.push_back(std::move(info));
+    }
+    entry.startTime = ctx->start_time;
+    entry.duration = ctx->duration;
+    entry.bitRate = ctx->bit_rate;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (Entry *existing = find(key)) {
+        // 이미 저장된 프레임 스캔 결과는 유지
+        entry.hasFrameTypes = existing->hasFrameTypes;
+        entry.iFrames = std::move(existing->iFrames);
+        entry.pFrames = std::move(existing->pFrames);
+        *existing = std::move(entry);
+        return;
+    }
+    _entries.emplace(key, std::move(entry));
+    _recent.push_front(key);
+    evict();
+}
+
+bool ProbeCache::getFrameTypes(const std::string &key, std::vector<double> &iFrames, std::vector<double> &pFrames) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Entry *entry = find(key);
+    if (!entry || !entry->hasFrameTypes) {
+        return false;
+    }
+    iFrames = entry->iFrames;
+    pFrames = entry->pFrames;
+    return true;
+}
+
+void ProbeCache::storeFrameTypes(const std::string &key, const std::vector<double> &iFrames,
+                                 const std::vector<double> &pFrames) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (Entry *entry = find(key)) {
+        entry->hasFrameTypes = true;
+        entry->iFrames = iFrames;
+        entry->pFrames = pFrames;
+    }
+}
+
+ProbeCache::Entry *ProbeCache::find(const std::string &key) {
+    const auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return nullptr;
+    }
+    _recent.remove(key);
+    _recent.push_front(key);
+    return &it->second;
+}
+
+void ProbeCache::evict() {
+    while (_entries.size() > MAX_ENTRIES && !_recent.empty()) {
+        _entries.erase(_recent.back());
+        _recent.pop_back();
+    }
+}
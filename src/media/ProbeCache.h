@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+// 파일별 probe 결과 캐시 (프로세스 내, 최근 사용 순으로 MAX_ENTRIES 유지)
+// 같은 파일을 다시 열 때 avformat_find_stream_info 와 I/P 프레임 스캔을 건너뜀
+class ProbeCache {
+public:
+    static ProbeCache &instance();
+
+    // 경로 + 크기 + 수정 시각 + inode (일반 파일이 아니면 nullopt)
+    static std::optional<std::string> fileKey(const std::string &path);
+
+    // 컨테이너별 probesize/analyzeduration 조정 (avformat_open_input 이후, find_stream_info 이전)
+    static void tuneProbeLimits(AVFormatContext *ctx);
+
+    // 헤더만 읽은 ctx 에 저장된 스트림 파라미터 복원 (스트림 구성이 다르면 false)
+    bool restore(const std::string &key, AVFormatContext *ctx);
+
+    // find_stream_info 결과 저장
+    void store(const std::string &key, const AVFormatContext *ctx);
+
+    bool getFrameTypes(const std::string &key, std::vector<double> &iFrames, std::vector<double> &pFrames);
+
+    void storeFrameTypes(const std::string &key, const std::vector<double> &iFrames, const std::vector<double> &pFrames);
+
+private:
+    struct ParamsDeleter {
+        void operator()(AVCodecParameters *params) const { avcodec_parameters_free(&params); }
+    };
+
+    struct StreamInfo {
+        std::unique_ptr<AVCodecParameters, ParamsDeleter> params;
+        AVRational avgFrameRate{0, 1};
+        AVRational realFrameRate{0, 1};
+        int64_t startTime{AV_NOPTS_VALUE};
+        int64_t duration{AV_NOPTS_VALUE};
+    };
+
+    struct Entry {
+        std::vector<StreamInfo> streams;
+        int64_t startTime{AV_NOPTS_VALUE};
+        int64_t duration{AV_NOPTS_VALUE};
+        int64_t bitRate{0};
+        bool hasFrameTypes{false};
+        std::vector<double> iFrames;
+        std::vector<double> pFrames;
+    };
+
+    ProbeCache() = default;
+
+    // _mutex 보유 상태에서 호출 (조회한 항목을 최근 사용으로 이동)
+    Entry *find(const std::string &key);
+
+    void evict();
+
+    std::unordered_map<std::string, Entry> _entries;
+    std::list<std::string> _recent;     // 앞쪽이 최근 사용
+    std::mutex _mutex;
+
+    static constexpr size_t MAX_ENTRIES = 64;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// 원본/저해상도 proxy 디코딩 전환 판단
+// 스크러빙(연속 seek), 고배속 재생, 디코딩 여유 부족(늦은 프레임 누적) 시 proxy 사용, 일시정지/정상 배속이면 원본 복귀
+class ProxySwitchPolicy {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // seek 요청마다 호출, 짧은 간격으로 이어지면 스크러빙으로 판단
+    void onSeek(const Clock::time_point now) {
+        if (_lastSeek != Clock::time_point{} && now - _lastSeek < SCRUB_SEEK_INTERVAL) {
+            _scrubbing = true;
+        }
+        _lastSeek = now;
+    }
+
+    // 원본 디코더의 누적 늦은 프레임 수 반영 (원본 디코딩 중에만 호출)
+    void onLateFrames(const uint64_t lateFrames, const Clock::time_point now) {
+        if (_lateSampleTime == Clock::time_point{} || lateFrames < _lateSampleCount) {
+            _lateSampleTime = now;
+            _lateSampleCount = lateFrames;
+            return;
+        }
+        if (now - _lateSampleTime < LATE_SAMPLE_WINDOW) {
+            return;
+        }
+        const auto elapsed = std::chrono::duration<double>(now - _lateSampleTime).count();
+        const auto rate = static_cast<double>(lateFrames - _lateSampleCount) / elapsed;
+        if (rate >= LOW_HEADROOM_LATE_FRAMES_PER_SEC) {
+            _lowHeadroomUntil = now + LOW_HEADROOM_HOLD;
+        }
+        _lateSampleTime = now;
+        _lateSampleCount = lateFrames;
+    }
+
+    // 현재 상태에서 proxy 를 사용해야 하는지 (usingProxy: 현재 상태, 잦은 전환 방지용)
+    bool shouldUseProxy(const bool playing, const double speed, const bool usingProxy, const Clock::time_point now) {
+        if (_scrubbing && now - _lastSeek >= SCRUB_END_DELAY) {
+            _scrubbing = false;
+        }
+
+        bool wanted = _scrubbing;
+        if (playing) {
+            wanted = wanted || speed >= TRICK_PLAY_SPEED || now < _lowHeadroomUntil;
+        }
+
+        // 스크러빙 진입은 즉시, 그 외 전환은 최소 간격 유지
+        if (wanted != usingProxy && !(wanted && _scrubbing) && now - _lastSwitch < MIN_SWITCH_INTERVAL) {
+            return usingProxy;
+        }
+        if (wanted != usingProxy) {
+            _lastSwitch = now;
+            // 원본으로 돌아가면 늦은 프레임 측정을 새로 시작
+            _lateSampleTime = {};
+        }
+        return wanted;
+    }
+
+    bool isScrubbing() const { return _scrubbing; }
+
+private:
+    Clock::time_point _lastSeek{};
+    Clock::time_point _lastSwitch{};
+    Clock::time_point _lowHeadroomUntil{};
+    Clock::time_point _lateSampleTime{};
+    uint64_t _lateSampleCount{0};
+    bool _scrubbing{false};
+
+    static constexpr auto SCRUB_SEEK_INTERVAL = std::chrono::milliseconds(500);
+    static constexpr auto SCRUB_END_DELAY = std::chrono::milliseconds(400);
+    static constexpr auto MIN_SWITCH_INTERVAL = std::chrono::seconds(1);
+    static constexpr auto LATE_SAMPLE_WINDOW = std::chrono::seconds(1);
+    static constexpr auto LOW_HEADROOM_HOLD = std::chrono::seconds(10);
+    static constexpr double TRICK_PLAY_SPEED = 2.0;
+    static constexpr double LOW_HEADROOM_LATE_FRAMES_PER_SEC = 5.0;
+};
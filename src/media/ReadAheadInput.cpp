@@ -0,0 +1,267 @@
+#include "ReadAheadInput.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+ReadAheadInput::ReadAheadInput(std::string path, const size_t bufferBytes) : _path(std::move(path)) {
+    _fd = open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) {
+        throw std::runtime_error("Failed to open " + _path);
+    }
+
+    struct stat st{};
+    if (fstat(_fd, &st) != 0) {
+        close(_fd);
+        throw std::runtime_error("Failed to stat " + _path);
+    }
+    _fileSize = st.st_size;
+
+#ifdef __linux__
+    // 커널 readahead 창을 키우고 순차 접근임을 알림
+    posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    _bufferSize = std::max<size_t>((bufferBytes + CHUNK_SIZE - 1) / CHUNK_SIZE, 2) * CHUNK_SIZE;
+    _buffer.reset(static_cast<uint8_t *>(std::aligned_alloc(BUFFER_ALIGNMENT, _bufferSize)));
+
+    auto *ioBuffer = static_cast<unsigned char *>(av_malloc(IO_BUFFER_SIZE));
+    _avio = _buffer && ioBuffer ? avio_alloc_context(ioBuffer, IO_BUFFER_SIZE, 0, this,
+                                                     &ReadAheadInput::readPacket, nullptr,
+                                                     &ReadAheadInput::seekPacket) : nullptr;
+    if (!_avio) {
+        av_free(ioBuffer);
+        close(_fd);
+        throw std::runtime_error("Failed to allocate read-ahead buffers");
+    }
+
+    setupUring();
+    _ioThread = std::thread(&ReadAheadInput::ioLoop, this);
+}
+
+ReadAheadInput::~ReadAheadInput() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _ioWake.notify_all();
+    _dataReady.notify_all();
+    if (_ioThread.joinable()) {
+        _ioThread.join();
+    }
+
+#ifdef LOKI_HAVE_IO_URING
+    if (_useUring) {
+        io_uring_queue_exit(&_uring);
+    }
+#endif
+
+    if (_avio) {
+        av_freep(&_avio->buffer);
+        avio_context_free(&_avio);
+    }
+    close(_fd);
+}
+
+bool ReadAheadInput::isLocalFile(const std::string &path) {
+    if (path.find("://") != std::string::npos) {
+        return false;
+    }
+    struct stat st{};
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+int ReadAheadInput::readPacket(void *opaque, uint8_t *buf, const int size) {
+    return static_cast<ReadAheadInput *>(opaque)->read(buf, size);
+}
+
+int64_t ReadAheadInput::seekPacket(void *opaque, const int64_t offset, const int whence) {
+    return static_cast<ReadAheadInput *>(opaque)->seek(offset, whence);
+}
+
+bool ReadAheadInput::isReadable() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _windowEnd - _position >= static_cast<int64_t>(CHUNK_SIZE) || _eof || _error != 0 || !_running;
+}
+
+void ReadAheadInput::setDataCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _dataCallback = std::move(callback);
+}
+
+int ReadAheadInput::read(uint8_t *buf, const int size) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _dataReady.wait(lock, [this] { return _position < _windowEnd || _eof || _error != 0 || !_running; });
+    if (_position >= _windowEnd) {
+        return _error != 0 ? _error : AVERROR_EOF;
+    }
+
+    // ring 끝에서 나눠 복사
+    const size_t ringOffset = static_cast<size_t>(_position % static_cast<int64_t>(_bufferSize));
+    const size_t count = std::min({static_cast<size_t>(size), static_cast<size_t>(_windowEnd - _position),
+                                   _bufferSize - ringOffset});
+    std::memcpy(buf, _buffer.get() + ringOffset, count);
+    _position += static_cast<int64_t>(count);
+
+    lock.unlock();
+    _ioWake.notify_one();
+    return static_cast<int>(count);
+}
+
+int64_t ReadAheadInput::seek(const int64_t offset, int whence) {
+    whence &= ~AVSEEK_FORCE;
+    if (whence == AVSEEK_SIZE) {
+        return _fileSize;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    int64_t target = -1;
+    if (whence == SEEK_SET) {
+        target = offset;
+    } else if (whence == SEEK_CUR) {
+        target = _position + offset;
+    } else if (whence == SEEK_END) {
+        target = _fileSize + offset;
+    }
+    if (target < 0) {
+        return AVERROR(EINVAL);
+    }
+
+    // 이미 읽어 둔 범위 안이면 위치만 이동
+    if (target >= _windowStart && target <= _windowEnd) {
+        _position = target;
+        return target;
+    }
+
+    // 진행 중인 read-ahead 는 완료되어도 버림
+    ++_generation;
+    _windowStart = _windowEnd = target - target % static_cast<int64_t>(CHUNK_SIZE);
+    _position = target;
+    _eof = false;
+    _error = 0;
+    _ioWake.notify_one();
+    return target;
+}
+
+bool ReadAheadInput::canFill() const {
+    // 버퍼가 가득 차면 읽기 위치가 속한 chunk 는 덮어쓰지 않음
+    const int64_t readChunkStart = _position - _position % static_cast<int64_t>(CHUNK_SIZE);
+    return !_eof && _error == 0 &&
+           _windowEnd + static_cast<int64_t>(CHUNK_SIZE) - readChunkStart <= static_cast<int64_t>(_bufferSize);
+}
+
+void ReadAheadInput::ioLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _ioWake.wait(lock, [this] { return !_running || canFill(); });
+        if (!_running) {
+            break;
+        }
+
+        const int64_t offset = _windowEnd;
+        const uint64_t generation = _generation;
+        const size_t ringOffset = static_cast<size_t>(offset % static_cast<int64_t>(_bufferSize));
+        const size_t size = std::min(CHUNK_SIZE, _bufferSize - ringOffset);
+        // 채울 영역은 더 이상 유효 범위가 아님
+        _windowStart = std::max(_windowStart, offset + static_cast<int64_t>(size) - static_cast<int64_t>(_bufferSize));
+        lock.unlock();
+
+#ifdef __linux__
+        // 다음 chunk 들도 page cache 로 미리 요청 (버퍼 크기만큼)
+        posix_fadvise(_fd, offset + static_cast<int64_t>(size), static_cast<off_t>(_bufferSize), POSIX_FADV_WILLNEED);
+#endif
+        const int64_t result = readChunk(_buffer.get() + ringOffset, size, offset);
+
+        lock.lock();
+        if (generation != _generation) {
+            continue;
+        }
+        if (result < 0) {
+            _error = static_cast<int>(result);
+            spdlog::warn("Read-ahead failed for {} at {}: {}", _path, offset, _error);
+        } else if (result == 0) {
+            _eof = true;
+        } else {
+            _windowEnd = offset + result;
+        }
+        _dataReady.notify_all();
+
+        // 소비자 재실행은 락 밖에서 (callback 이 executor 락을 잡음)
+        if (auto callback = _dataCallback) {
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+}
+
+int64_t ReadAheadInput::readChunk(uint8_t *dst, const size_t size, const int64_t offset) {
+#ifdef LOKI_HAVE_IO_URING
+    if (_useUring) {
+        // 네트워크 스토리지 지연을 겹치도록 chunk 를 나눠 동시에 요청
+        const size_t partSize = size / URING_PARTS;
+        for (unsigned i = 0; i < URING_PARTS; ++i) {
+            io_uring_sqe *sqe = io_uring_get_sqe(&_uring);
+            const size_t length = i + 1 == URING_PARTS ? size - partSize * i : partSize;
+            io_uring_prep_read(sqe, _fd, dst + partSize * i, static_cast<unsigned>(length),
+                               static_cast<uint64_t>(offset) + partSize * i);
+            io_uring_sqe_set_data64(sqe, i);
+        }
+        io_uring_submit(&_uring);
+
+        int results[URING_PARTS] = {};
+        for (unsigned i = 0; i < URING_PARTS; ++i) {
+            io_uring_cqe *cqe = nullptr;
+            if (io_uring_wait_cqe(&_uring, &cqe) < 0) {
+                return AVERROR(EIO);
+            }
+            results[io_uring_cqe_get_data64(cqe)] = cqe->res;
+            io_uring_cqe_seen(&_uring, cqe);
+        }
+
+        // 앞에서부터 연속으로 채워진 만큼만 유효 (짧은 읽기 뒤는 다음 요청에서 다시 읽음)
+        int64_t total = 0;
+        for (unsigned i = 0; i < URING_PARTS; ++i) {
+            if (results[i] < 0) {
+                return total > 0 ? total : AVERROR(-results[i]);
+            }
+            total += results[i];
+            const size_t length = i + 1 == URING_PARTS ? size - partSize * i : partSize;
+            if (static_cast<size_t>(results[i]) < length) {
+                break;
+            }
+        }
+        return total;
+    }
+#endif
+
+    while (true) {
+        const ssize_t n = pread(_fd, dst, size, offset);
+        if (n >= 0) {
+            return n;
+        }
+        if (errno != EINTR) {
+            return AVERROR(errno);
+        }
+    }
+}
+
+void ReadAheadInput::setupUring() {
+#ifdef LOKI_HAVE_IO_URING
+    // liburing 으로 빌드되었어도 커널이 지원하지 않으면 pread 사용
+    const int ret = io_uring_queue_init(URING_PARTS, &_uring, 0);
+    _useUring = ret == 0;
+    if (!_useUring) {
+        spdlog::info("io_uring unavailable ({}), using pread for read-ahead", ret);
+    }
+#endif
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <functional>
+#include <thread>
+
+#ifdef LOKI_HAVE_IO_URING
+#include <liburing.h>
+#endif
+
+extern "C" {
+#include <libavformat/avio.h>
+}
+
+// 로컬/마운트된 파일용 read-ahead AVIO 입력
+// 전용 I/O 스레드가 큰 정렬 단위로 미리 읽어 ring buffer 에 채우고, 디코딩 스레드는 버퍼에서 복사만 함
+// 버퍼 범위 밖으로 seek 하면 진행 중인 read-ahead 를 취소하고 새 위치부터 다시 채움
+class ReadAheadInput {
+public:
+    // bufferBytes 는 CHUNK_SIZE 배수로 올림, 파일을 열 수 없으면 예외
+    ReadAheadInput(std::string path, size_t bufferBytes);
+
+    ~ReadAheadInput();
+
+    ReadAheadInput(const ReadAheadInput &) = delete;
+
+    ReadAheadInput &operator=(const ReadAheadInput &) = delete;
+
+    AVIOContext *context() const { return _avio; }
+
+    // 다음 read 가 I/O 대기 없이 진행될 만큼 버퍼에 있는지 (CHUNK 이상, 또는 EOF/오류)
+    bool isReadable();
+
+    // [I/O thread] chunk 를 채울 때마다 호출 (isReadable 이 false 일 때 대기하던 소비자 재실행용)
+    void setDataCallback(std::function<void()> callback);
+
+    // URL 이 아닌 일반 파일 경로인지 (네트워크 스트림은 libavformat protocol 사용)
+    static bool isLocalFile(const std::string &path);
+
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+private:
+    struct AlignedFree {
+        void operator()(uint8_t *p) const { std::free(p); }
+    };
+
+    static int readPacket(void *opaque, uint8_t *buf, int size);
+
+    static int64_t seekPacket(void *opaque, int64_t offset, int whence);
+
+    int read(uint8_t *buf, int size);
+
+    int64_t seek(int64_t offset, int whence);
+
+    void ioLoop();
+
+    // _mutex 보유 상태에서 호출
+    bool canFill() const;
+
+    // io_uring 이 있으면 CHUNK 를 나눠 동시에 요청, 없으면 pread
+    int64_t readChunk(uint8_t *dst, size_t size, int64_t offset);
+
+    void setupUring();
+
+    std::string _path;
+    int _fd{-1};
+    int64_t _fileSize{0};
+    AVIOContext *_avio{nullptr};
+
+    // 파일 offset o 는 _buffer[o % _bufferSize] 에 저장
+    std::unique_ptr<uint8_t, AlignedFree> _buffer;
+    size_t _bufferSize{0};
+
+    // _mutex 보호: [_windowStart, _windowEnd) 가 버퍼에 유효한 범위
+    int64_t _windowStart{0};
+    int64_t _windowEnd{0};
+    int64_t _position{0};
+    uint64_t _generation{0};        // seek 로 read-ahead 를 취소할 때 증가
+    bool _eof{false};
+    int _error{0};
+    bool _running{true};
+
+    std::mutex _mutex;
+    std::condition_variable _dataReady;
+    std::condition_variable _ioWake;
+    std::thread _ioThread;
+    std::function<void()> _dataCallback;
+
+#ifdef LOKI_HAVE_IO_URING
+    io_uring _uring{};
+#endif
+    bool _useUring{false};
+
+    static constexpr size_t BUFFER_ALIGNMENT = 4096;
+    static constexpr int IO_BUFFER_SIZE = 64 * 1024;    // libavformat 이 한 번에 요청하는 크기
+    static constexpr unsigned URING_PARTS = 4;          // CHUNK 당 동시 요청 수
+};
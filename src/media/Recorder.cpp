@@ -0,0 +1,264 @@
+#include "Recorder.h"
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+
+Recorder::Recorder(Decoder &decoder, std::string outputDir)
+        : _decoder(decoder), _outputDir(std::move(outputDir)) {
+    std::filesystem::create_directories(_outputDir);
+}
+
+Recorder::~Recorder() {
+    if (_isRecording) {
+        stop();
+    }
+    if (_packetRing) {
+        _decoder.setPacketSink(nullptr);
+    }
+}
+
+void Recorder::setPreRecord(const PreRecordConfig &config) {
+    if (_isRecording) {
+        spdlog::warn("Pre-record settings cannot change while recording");
+        return;
+    }
+
+    _decoder.setPacketSink(nullptr);
+    _packetRing.reset();
+
+    if (config.seconds <= 0.0) {
+        return;
+    }
+
+    const PacketStreamInfo info = _decoder.getPacketStreamInfo();
+    if (!info.videoParams) {
+        spdlog::warn("Pre-record unavailable: no video stream");
+        return;
+    }
+
+    _packetRing = std::make_shared<PacketRing>(info, config);
+    _decoder.setPacketSink(_packetRing);
+}
+
+void Recorder::start(const RecordOptions &options) {
+    if (_isRecording) {
+        return;
+    }
+
+    try {
+        const std::string sessionDir = createSessionDir();
+
+        if (options.mode == RecordMode::Passthrough) {
+            startPassthrough(sessionDir, options);
+        } else {
+            startTranscode(sessionDir, options);
+        }
+
+        _droppedFrames = 0;
+        _isRecording = true;
+        spdlog::info("Started {} recording to: {}",
+                     options.mode == RecordMode::Passthrough ? "passthrough" : "transcode", sessionDir);
+    } catch (const std::exception &e) {
+        release();
+        spdlog::error("Failed to start recording: {}", e.what());
+        throw;
+    }
+}
+
+std::string Recorder::createSessionDir() const {
+    auto now = std::chrono::system_clock::now();
+    auto now_time = std::chrono::system_clock::to_time_t(now);
+    std::tm tm = *std::localtime(&now_time);
+
+    std::ostringstream ss;
+    ss << _outputDir << "/recording_" << std::put_time(&tm, "%Y%m%d_%H%M%S");
+    std::string sessionDir = ss.str();
+
+    if (!std::filesystem::create_directories(sessionDir)) {
+        throw std::runtime_error("Failed to create recording directory: " + sessionDir);
+    }
+    return sessionDir;
+}
+
+void Recorder::startTranscode(const std::string &sessionDir, const RecordOptions &options) {
+    // YUV420P 는 짝수 크기만 가능
+    // lowres/축소 변환 중이어도 스트림 원본 크기로 인코딩
+    const int width = _decoder.getCodedWidth() & ~1;
+    const int height = _decoder.getCodedHeight() & ~1;
+    if (width <= 0 || height <= 0) {
+        throw std::runtime_error("No video stream available for recording");
+    }
+
+    _encoder = std::make_unique<Encoder>(sessionDir, SEGMENT_DURATION, options.container);
+    _encoder->setSegmentClosedCallback(options.onSegmentClosed);
+    // rendition 은 원본 세그먼트와 같은 구간/파일명으로 기록 (<세션>/<rendition>/<원본 파일명>)
+    if (!options.renditions.empty()) {
+        _segmentSchedule = std::make_shared<SegmentSchedule>();
+        _encoder->setSegmentSchedule(_segmentSchedule, true);
+    }
+    if (!_encoder->initialize(width, height, TRANSCODE_FPS, options.encoder)) {
+        throw std::runtime_error("Failed to initialize encoder");
+    }
+
+    // 인코딩은 전용 스레드에서 수행 (렌더 스레드 영향 최소화)
+    _encodeThread = std::make_shared<EncodeThread>(*_encoder, options.encodeQueue);
+    _encodeThread->start();
+
+    if (!options.renditions.empty()) {
+        startRenditions(sessionDir, options, width, height);
+    }
+
+    // 표시용 RGB 변환과 별개로 디코딩 프레임을 원본 크기 YUV420P 로 받음
+    if (_renditionThread) {
+        _decoder.setFrameSink(_renditionThread);
+    } else {
+        _decoder.setFrameSink(_encodeThread);
+    }
+}
+
+void Recorder::startRenditions(const std::string &sessionDir, const RecordOptions &options,
+                               const int width, const int height) {
+    std::vector<RenditionThread::Output> outputs{{_encodeThread.get(), width, height}};
+
+    for (const auto &config : options.renditions) {
+        if (config.height <= 0 || config.height >= height) {
+            spdlog::warn("Skipping rendition {}: height {} not below source {}", config.name, config.height, height);
+            continue;
+        }
+
+        // 원본 비율 유지, 짝수 크기
+        const int renditionHeight = config.height & ~1;
+        const int renditionWidth = static_cast<int>(static_cast<int64_t>(width) * renditionHeight / height) & ~1;
+
+        Rendition rendition;
+        rendition.encoder = std::make_unique<Encoder>(sessionDir + "/" + config.name, SEGMENT_DURATION,
+                                                      options.container);
+        rendition.encoder->setSegmentClosedCallback(options.onSegmentClosed);
+        rendition.encoder->setSegmentSchedule(_segmentSchedule, false);
+        if (!rendition.encoder->initialize(renditionWidth, renditionHeight, TRANSCODE_FPS, config.encoder)) {
+            throw std::runtime_error("Failed to initialize encoder for rendition " + config.name);
+        }
+        rendition.encodeThread = std::make_unique<EncodeThread>(*rendition.encoder, options.encodeQueue);
+        rendition.encodeThread->start();
+
+        outputs.push_back({rendition.encodeThread.get(), renditionWidth, renditionHeight});
+        _renditions.push_back(std::move(rendition));
+        spdlog::info("Recording rendition {} at {}x{}", config.name, renditionWidth, renditionHeight);
+    }
+
+    if (outputs.size() > 1) {
+        _renditionThread = std::make_shared<RenditionThread>(std::move(outputs), options.encodeQueue.maxQueueSize);
+        _renditionThread->start();
+    }
+}
+
+void Recorder::startPassthrough(const std::string &sessionDir, const RecordOptions &options) {
+    const PacketStreamInfo info = _decoder.getPacketStreamInfo();
+    if (!info.videoParams) {
+        throw std::runtime_error("No video stream available for recording");
+    }
+
+    // 컨테이너가 받지 못하는 오디오 코덱은 Encoder 에서 제외됨
+    _encoder = std::make_unique<Encoder>(sessionDir, SEGMENT_DURATION, options.container);
+    _encoder->setSegmentClosedCallback(options.onSegmentClosed);
+    if (!_encoder->initializeRemux(info)) {
+        throw std::runtime_error("Failed to initialize remuxer");
+    }
+
+    _remuxThread = std::make_shared<RemuxThread>(*_encoder, RemuxThread::DEFAULT_QUEUE_SIZE);
+    _remuxThread->start();
+
+    // 보관된 pre-roll 을 먼저 기록한 뒤 이후 패킷을 이어서 전달
+    if (_packetRing) {
+        _packetRing->attach(_remuxThread);
+    } else {
+        _decoder.setPacketSink(_remuxThread);
+    }
+}
+
+void Recorder::stop() {
+    if (!_isRecording) {
+        spdlog::warn("No active recording to stop");
+        return;
+    }
+
+    _isRecording = false;
+    _droppedFrames = getDroppedFrames();
+    release();
+    spdlog::info("Recording stopped and saved");
+}
+
+void Recorder::release() {
+    // tap 을 먼저 끊어 디코드 스레드가 더 이상 패킷을 넣지 않게 함
+    if (_remuxThread) {
+        if (_packetRing) {
+            _packetRing->detach();
+        } else {
+            _decoder.setPacketSink(nullptr);
+        }
+        _remuxThread->stop();
+        _remuxThread.reset();
+    }
+
+    // frame tap 도 먼저 끊음
+    if (_encodeThread) {
+        _decoder.setFrameSink(nullptr);
+    }
+
+    // 분배 대기 프레임을 각 인코딩 큐로 넘긴 뒤 인코딩 스레드 종료
+    if (_renditionThread) {
+        _renditionThread->stop();
+        _renditionThread.reset();
+    }
+
+    // 큐에 남은 프레임을 모두 인코딩한 뒤 finalize
+    if (_encodeThread) {
+        _encodeThread->stop();
+        _encodeThread.reset();
+    }
+    // 원본 인코딩이 끝났으므로 경계를 기다리는 rendition 을 풀어 줌
+    if (_segmentSchedule) {
+        _segmentSchedule->finish();
+    }
+    for (auto &rendition : _renditions) {
+        rendition.encodeThread->stop();
+    }
+
+    finalizeEncoder(_encoder);
+    for (auto &rendition : _renditions) {
+        finalizeEncoder(rendition.encoder);
+    }
+    _renditions.clear();
+    _segmentSchedule.reset();
+}
+
+void Recorder::finalizeEncoder(std::unique_ptr<Encoder> &encoder) {
+    if (!encoder) {
+        return;
+    }
+
+    try {
+        encoder->finalize();
+    } catch (const std::exception &e) {
+        spdlog::warn("Error finalizing encoder: {}", e.what());
+    }
+    encoder.reset();
+}
+
+uint64_t Recorder::getDroppedFrames() const {
+    if (_encodeThread) {
+        uint64_t dropped = _encodeThread->getDroppedFrames();
+        if (_renditionThread) {
+            dropped += _renditionThread->getDroppedFrames();
+        }
+        return dropped;
+    }
+    if (_remuxThread) {
+        return _remuxThread->getDroppedPackets();
+    }
+    return _droppedFrames;
+}
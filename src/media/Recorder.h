@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Decoder.h"
+#include "Encoder.h"
+#include "PacketRing.h"
+#include "media/interface/IVideoSource.h"
+#include "threads/EncodeThread.h"
+#include "threads/RemuxThread.h"
+#include "threads/RenditionThread.h"
+
+// 소스별 녹화 세션 (재인코딩 또는 패킷 stream copy)
+class Recorder {
+public:
+    Recorder(Decoder &decoder, std::string outputDir);
+
+    ~Recorder();
+
+    // 실패 시 예외
+    void start(const RecordOptions &options);
+
+    void stop();
+
+    // 녹화 전 패킷 보관 시작/해제 (Passthrough 녹화 시작 시 보관분을 먼저 기록)
+    void setPreRecord(const PreRecordConfig &config);
+
+    bool isRecording() const { return _isRecording; }
+
+    uint64_t getDroppedFrames() const;
+
+    static constexpr const char *DEFAULT_OUTPUT_DIR = "record";
+
+private:
+    std::string createSessionDir() const;
+
+    void startTranscode(const std::string &sessionDir, const RecordOptions &options);
+
+    void startRenditions(const std::string &sessionDir, const RecordOptions &options, int width, int height);
+
+    void startPassthrough(const std::string &sessionDir, const RecordOptions &options);
+
+    void release();
+
+    static void finalizeEncoder(std::unique_ptr<Encoder> &encoder);
+
+    Decoder &_decoder;
+    std::string _outputDir;
+
+    std::unique_ptr<Encoder> _encoder;
+    // Transcode 는 디코더 frame tap 으로, Passthrough 는 패킷 tap 으로 기록
+    // (tap 이 해제 직후에도 호출 중일 수 있으므로 수신 스레드는 공유 소유)
+    std::shared_ptr<EncodeThread> _encodeThread;
+
+    // 추가 rendition (프레임 변환은 RenditionThread 에서 한 번만)
+    struct Rendition {
+        std::unique_ptr<Encoder> encoder;
+        std::unique_ptr<EncodeThread> encodeThread;
+    };
+    std::vector<Rendition> _renditions;
+    // 원본과 rendition 의 세그먼트 경계/파일명 공유
+    std::shared_ptr<SegmentSchedule> _segmentSchedule;
+    std::shared_ptr<RenditionThread> _renditionThread;
+    std::shared_ptr<RemuxThread> _remuxThread;
+    std::shared_ptr<PacketRing> _packetRing;
+    uint64_t _droppedFrames{0};
+    bool _isRecording{false};
+
+    static constexpr int SEGMENT_DURATION = 180;
+    static constexpr int TRANSCODE_FPS = 30;
+};
@@ -0,0 +1,293 @@
+#include "RetentionManager.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <spdlog/spdlog.h>
+
+namespace fs = std::filesystem;
+
+RetentionManager::RetentionManager(std::string rootDir, const RetentionConfig &config)
+        : _rootDir(std::move(rootDir)), _config(config) {
+    std::error_code ec;
+    fs::create_directories(_rootDir, ec);
+}
+
+RetentionManager::~RetentionManager() {
+    stop();
+}
+
+void RetentionManager::start() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_running) {
+        _running = true;
+        _thread = std::thread(&RetentionManager::run, this);
+    }
+}
+
+void RetentionManager::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _wake.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void RetentionManager::setConfig(const RetentionConfig &config) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _config = config;
+        _configChanged = true;
+    }
+    _wake.notify_one();
+}
+
+void RetentionManager::addSegment(const std::string &path) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.push_back(path);
+    }
+    _wake.notify_one();
+}
+
+void RetentionManager::run() {
+    // manifest 가 있으면 그대로 사용, 처음 한 번만 디렉터리 탐색
+    if (fs::exists(manifestPath())) {
+        loadManifest();
+    } else {
+        scanRoot();
+    }
+    auto lastRefresh = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        std::vector<std::string> pending = std::move(_pending);
+        _pending.clear();
+        _configChanged = false;
+        const RetentionConfig config = _config;
+        const bool running = _running;
+        lock.unlock();
+
+        // 파일 크기 확인과 삭제는 락 밖에서 (등록하는 쪽을 막지 않음)
+        registerSegments(pending);
+        if (running && std::chrono::steady_clock::now() - lastRefresh >= REFRESH_INTERVAL) {
+            refreshSegments();
+            lastRefresh = std::chrono::steady_clock::now();
+        }
+        enforce(config);
+
+        lock.lock();
+        if (!running) {
+            break;
+        }
+        _wake.wait_for(lock, CHECK_INTERVAL, [this] {
+            return !_running || !_pending.empty() || _configChanged;
+        });
+    }
+}
+
+void RetentionManager::loadManifest() {
+    std::ifstream in(manifestPath());
+    std::string line;
+    while (std::getline(in, line)) {
+        // bytes \t closedAt \t path
+        std::istringstream fields(line);
+        Segment segment;
+        if (!(fields >> segment.bytes >> segment.closedAt)) {
+            continue;
+        }
+        fields.ignore(1);
+        std::getline(fields, segment.path);
+        if (segment.path.empty()) {
+            continue;
+        }
+        _totalBytes += segment.bytes;
+        _segments.push_back(std::move(segment));
+    }
+
+    std::stable_sort(_segments.begin(), _segments.end(), [](const Segment &a, const Segment &b) {
+        return a.closedAt < b.closedAt;
+    });
+    _segmentCount = _segments.size();
+    spdlog::info("Retention manifest loaded: {} segments, {} bytes", _segments.size(), _totalBytes.load());
+}
+
+void RetentionManager::scanRoot() {
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(_rootDir, ec); !ec && it != fs::recursive_directory_iterator();
+         it.increment(ec)) {
+        if (!it->is_regular_file(ec)) {
+            continue;
+        }
+        const auto extension = it->path().extension().string();
+        if (extension != ".mp4" && extension != ".mkv" && extension != ".mov") {
+            continue;
+        }
+
+        Segment segment;
+        segment.path = it->path().string();
+        segment.bytes = it->file_size(ec);
+        const auto modified = std::chrono::file_clock::to_sys(it->last_write_time(ec));
+        segment.closedAt = std::chrono::duration_cast<std::chrono::seconds>(modified.time_since_epoch()).count();
+        _totalBytes += segment.bytes;
+        _segments.push_back(std::move(segment));
+    }
+
+    std::sort(_segments.begin(), _segments.end(), [](const Segment &a, const Segment &b) {
+        return a.closedAt < b.closedAt;
+    });
+    _segmentCount = _segments.size();
+    rewriteManifest();
+    spdlog::info("Retention scan of {}: {} segments, {} bytes", _rootDir, _segments.size(), _totalBytes.load());
+}
+
+void RetentionManager::refreshSegments() {
+    size_t missing = 0;
+    bool resized = false;
+    uint64_t totalBytes = 0;
+    std::deque<Segment> segments;
+    for (auto &segment: _segments) {
+        std::error_code ec;
+        const auto bytes = fs::file_size(segment.path, ec);
+        if (ec == std::errc::no_such_file_or_directory) {
+            ++missing;
+            continue;
+        }
+        if (!ec && bytes != segment.bytes) {
+            segment.bytes = bytes;
+            resized = true;
+        }
+        totalBytes += segment.bytes;
+        segments.push_back(std::move(segment));
+    }
+
+    _segments = std::move(segments);
+    _totalBytes = totalBytes;
+    _segmentCount = _segments.size();
+    if (missing > 0 || resized) {
+        rewriteManifest();
+        spdlog::info("Retention refreshed: {} missing, {} segments / {} bytes", missing, _segments.size(), totalBytes);
+    }
+}
+
+void RetentionManager::registerSegments(const std::vector<std::string> &paths) {
+    if (paths.empty()) {
+        return;
+    }
+
+    std::vector<Segment> added;
+    const int64_t now = nowSeconds();
+    for (const auto &path: paths) {
+        std::error_code ec;
+        const auto bytes = fs::file_size(path, ec);
+        if (ec) {
+            continue;
+        }
+        added.push_back({path, static_cast<uint64_t>(bytes), now});
+    }
+
+    for (const auto &segment: added) {
+        _totalBytes += segment.bytes;
+        _segments.push_back(segment);
+    }
+    _segmentCount = _segments.size();
+    appendManifest(added);
+}
+
+void RetentionManager::enforce(const RetentionConfig &config) {
+    const int64_t now = nowSeconds();
+    size_t removed = 0;
+    size_t missing = 0;
+
+    while (!_segments.empty()) {
+        const Segment &oldest = _segments.front();
+        const bool expired = config.maxAge.count() > 0 && now - oldest.closedAt > config.maxAge.count();
+        const bool overQuota = config.maxTotalBytes > 0 && _totalBytes.load() > config.maxTotalBytes;
+        if (!expired && !overQuota) {
+            break;
+        }
+
+        // 외부에서 지워진 파일은 항목만 제거하고 다음 세그먼트 확인
+        if (removeSegmentFile(oldest)) {
+            ++removed;
+        } else {
+            ++missing;
+        }
+        _totalBytes -= std::min(oldest.bytes, _totalBytes.load());
+        _segments.pop_front();
+    }
+
+    if (removed > 0 || missing > 0) {
+        _segmentCount = _segments.size();
+        rewriteManifest();
+        spdlog::info("Retention removed {} segments ({} already missing), {} segments / {} bytes kept",
+                     removed, missing, _segments.size(), _totalBytes.load());
+    }
+}
+
+bool RetentionManager::removeSegmentFile(const Segment &segment) const {
+    std::error_code ec;
+    if (!fs::remove(segment.path, ec)) {
+        // 외부에서 이미 지운 파일은 manifest 에서만 빼면 됨
+        if (ec) {
+            spdlog::warn("Failed to remove segment {}: {}", segment.path, ec.message());
+        }
+        return false;
+    }
+
+    // 비게 된 세션/rendition 디렉터리 정리 (root 는 유지)
+    const fs::path root = fs::weakly_canonical(_rootDir, ec);
+    for (fs::path dir = fs::path(segment.path).parent_path(); !dir.empty(); dir = dir.parent_path()) {
+        if (fs::weakly_canonical(dir, ec) == root || !fs::is_empty(dir, ec) || ec) {
+            break;
+        }
+        fs::remove(dir, ec);
+    }
+    return true;
+}
+
+void RetentionManager::appendManifest(const std::vector<Segment> &segments) const {
+    if (segments.empty()) {
+        return;
+    }
+
+    std::ofstream out(manifestPath(), std::ios::app);
+    for (const auto &segment: segments) {
+        out << segment.bytes << '\t' << segment.closedAt << '\t' << segment.path << '\n';
+    }
+}
+
+void RetentionManager::rewriteManifest() const {
+    // 임시 파일에 쓴 뒤 교체 (중간에 종료되어도 이전 manifest 유지)
+    const std::string path = manifestPath();
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::trunc);
+        for (const auto &segment: _segments) {
+            out << segment.bytes << '\t' << segment.closedAt << '\t' << segment.path << '\n';
+        }
+        if (!out) {
+            spdlog::warn("Failed to write retention manifest {}", tempPath);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        spdlog::warn("Failed to replace retention manifest {}: {}", path, ec.message());
+    }
+}
+
+std::string RetentionManager::manifestPath() const {
+    return (fs::path(_rootDir) / MANIFEST_NAME).string();
+}
+
+int64_t RetentionManager::nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct RetentionConfig {
+    uint64_t maxTotalBytes{0};              // 0 이면 용량 제한 없음
+    std::chrono::seconds maxAge{0};         // 0 이면 기간 제한 없음
+};
+
+// 녹화 세그먼트 보관 관리 (총 용량/보관 기간을 넘으면 오래된 세그먼트부터 백그라운드에서 삭제)
+// 세그먼트 목록은 manifest 파일에 유지해 시작 시 디렉터리 전체를 다시 탐색하지 않음
+// 외부에서 지워진 파일은 manifest 항목만 다시 확인해 정리
+class RetentionManager {
+public:
+    RetentionManager(std::string rootDir, const RetentionConfig &config);
+
+    ~RetentionManager();
+
+    RetentionManager(const RetentionManager &) = delete;
+
+    RetentionManager &operator=(const RetentionManager &) = delete;
+
+    void start();
+
+    void stop();
+
+    void setConfig(const RetentionConfig &config);
+
+    // [Any thread] 닫힌 세그먼트 등록 (큐에 추가만 하고 바로 반환)
+    void addSegment(const std::string &path);
+
+    uint64_t getTotalBytes() const { return _totalBytes.load(); }
+
+    size_t getSegmentCount() const { return _segmentCount.load(); }
+
+private:
+    struct Segment {
+        std::string path;
+        uint64_t bytes{0};
+        int64_t closedAt{0};    // unix time (초)
+    };
+
+    void run();
+
+    void loadManifest();
+
+    // manifest 가 없을 때 한 번만 수행 (기존 녹화 파일 등록)
+    void scanRoot();
+
+    // manifest 항목만 다시 stat (없어진 파일 제거, 크기 갱신)
+    void refreshSegments();
+
+    void registerSegments(const std::vector<std::string> &paths);
+
+    void enforce(const RetentionConfig &config);
+
+    // 이미 없거나 지우지 못했으면 false
+    bool removeSegmentFile(const Segment &segment) const;
+
+    void appendManifest(const std::vector<Segment> &segments) const;
+
+    // 삭제된 항목을 제외하고 manifest 다시 쓰기
+    void rewriteManifest() const;
+
+    std::string manifestPath() const;
+
+    static int64_t nowSeconds();
+
+    std::string _rootDir;
+    RetentionConfig _config;
+
+    // 작업 스레드 전용 (오래된 순)
+    std::deque<Segment> _segments;
+    std::atomic<uint64_t> _totalBytes{0};
+    std::atomic<size_t> _segmentCount{0};
+
+    std::vector<std::string> _pending;
+    bool _configChanged{false};
+    bool _running{false};
+    std::thread _thread;
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+
+    static constexpr auto CHECK_INTERVAL = std::chrono::seconds(60);
+    static constexpr auto REFRESH_INTERVAL = std::chrono::minutes(10);
+    static constexpr const char *MANIFEST_NAME = ".retention_manifest";
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 한 녹화 세션의 원본 Encoder 와 rendition Encoder 가 공유하는 세그먼트 경계/파일명
+// 원본이 세그먼트를 나눈 입력 프레임 번호를 기록하고, rendition 은 같은 프레임에서 나누어
+// 같은 part 가 같은 구간, 같은 파일명("<시각>_part<N>")이 되게 함 (proxy 를 파일명으로 찾을 수 있도록)
+class SegmentSchedule {
+public:
+    // part 의 파일명 (확장자 제외) - 처음 요청될 때의 시각으로 고정
+    std::string segmentName(const int segment) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _names.find(segment);
+        if (it == _names.end()) {
+            const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            const std::tm tm = *std::localtime(&now);
+            std::ostringstream ss;
+            ss << std::put_time(&tm, "%Y%m%d_%H%M%S") << "_part" << segment;
+            it = _names.emplace(segment, ss.str()).first;
+        }
+        return it->second;
+    }
+
+    // [원본] sequence 번째 입력 프레임부터 다음 part 시작
+    void addBoundary(const int64_t sequence) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _boundaries.push_back(sequence);
+    }
+
+    // [원본] sequence 까지 처리 (경계 기록 후 호출)
+    void advance(const int64_t sequence) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _progress = std::max(_progress, sequence);
+        }
+        _advanced.notify_all();
+    }
+
+    // [원본] 더 이상 경계를 기록하지 않음 (대기 중인 rendition 을 깨움)
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finished = true;
+        }
+        _advanced.notify_all();
+    }
+
+    // [rendition] 원본이 sequence 까지 처리할 때까지 대기한 뒤 해당 프레임이 속한 part 번호
+    int waitPart(const int64_t sequence) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _advanced.wait(lock, [this, sequence] { return _finished || _progress >= sequence; });
+        int part = 0;
+        while (part < static_cast<int>(_boundaries.size()) && _boundaries[part] <= sequence) {
+            ++part;
+        }
+        return part;
+    }
+
+private:
+    std::map<int, std::string> _names;
+    std::vector<int64_t> _boundaries;       // part 1, 2, ... 의 첫 입력 프레임 번호
+    int64_t _progress{-1};
+    bool _finished{false};
+    std::mutex _mutex;
+    std::condition_variable _advanced;
+};
@@ -0,0 +1,433 @@
+#include "SegmentWriter.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+#ifdef LOKI_HAVE_IO_URING
+#include <liburing.h>
+#endif
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+namespace {
+    WriteMetrics &globalMetrics() {
+        static WriteMetrics metrics;
+        return metrics;
+    }
+
+    // 짧은 쓰기는 나머지를 이어서 기록
+    int64_t writeFully(const int fd, const uint8_t *data, const size_t size, const int64_t offset) {
+        size_t written = 0;
+        while (written < size) {
+            const ssize_t n = pwrite(fd, data + written, size - written, offset + static_cast<int64_t>(written));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return -errno;
+            }
+            written += static_cast<size_t>(n);
+        }
+        return static_cast<int64_t>(written);
+    }
+}
+
+// 모든 SegmentWriter 가 공유하는 백그라운드 writer (채널 수와 관계없이 스레드 하나)
+class SegmentWriteQueue {
+public:
+    static SegmentWriteQueue &instance() {
+        static SegmentWriteQueue queue;
+        return queue;
+    }
+
+    void submit(SegmentWriter *owner, SegmentWriter::Buffer *buffer) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _requests.push_back({owner, buffer});
+        }
+        _wake.notify_one();
+    }
+
+private:
+    struct Request {
+        SegmentWriter *owner{nullptr};
+        SegmentWriter::Buffer *buffer{nullptr};
+    };
+
+    SegmentWriteQueue() {
+#ifdef LOKI_HAVE_IO_URING
+        const int ret = io_uring_queue_init(URING_DEPTH, &_uring, 0);
+        _useUring = ret == 0;
+        if (!_useUring) {
+            spdlog::info("io_uring unavailable ({}), using pwrite for segment output", ret);
+        }
+#endif
+        _thread = std::thread(&SegmentWriteQueue::run, this);
+    }
+
+    ~SegmentWriteQueue() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running = false;
+        }
+        _wake.notify_all();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+#ifdef LOKI_HAVE_IO_URING
+        if (_useUring) {
+            io_uring_queue_exit(&_uring);
+        }
+#endif
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _wake.wait(lock, [this] { return !_running || !_requests.empty(); });
+            if (_requests.empty()) {
+                break;
+            }
+
+            // 그동안 쌓인 요청을 한 번에 처리
+            std::vector<Request> batch(_requests.begin(), _requests.end());
+            _requests.clear();
+            lock.unlock();
+
+            writeBatch(batch);
+
+            lock.lock();
+        }
+    }
+
+    void writeBatch(const std::vector<Request> &batch) {
+#ifdef LOKI_HAVE_IO_URING
+        if (_useUring) {
+            // 같은 파일의 요청은 제출 순서대로 이어 붙여 IOSQE_IO_LINK 로 연결
+            // (기록 중 읽는 쪽이 파일 크기를 믿으므로 뒤 범위가 앞 범위보다 먼저 기록되면 안 됨)
+            std::vector<Request> ordered(batch);
+            std::stable_sort(ordered.begin(), ordered.end(),
+                             [](const Request &a, const Request &b) { return a.owner < b.owner; });
+
+            for (size_t begin = 0; begin < ordered.size(); begin += URING_DEPTH) {
+                const size_t end = std::min(ordered.size(), begin + URING_DEPTH);
+                for (size_t i = begin; i < end; ++i) {
+                    const auto *buffer = ordered[i].buffer;
+                    io_uring_sqe *sqe = io_uring_get_sqe(&_uring);
+                    io_uring_prep_write(sqe, ordered[i].owner->_fd, buffer->data.get(),
+                                        static_cast<unsigned>(buffer->size), static_cast<uint64_t>(buffer->offset));
+                    io_uring_sqe_set_data64(sqe, i);
+                    // 묶음 경계에서는 끊어도 됨 (다음 묶음은 이번 묶음이 모두 끝난 뒤 제출)
+                    if (i + 1 < end && ordered[i + 1].owner == ordered[i].owner) {
+                        io_uring_sqe_set_flags(sqe, IOSQE_IO_LINK);
+                    }
+                }
+                io_uring_submit(&_uring);
+
+                std::vector<int64_t> results(end - begin, -EIO);
+                for (size_t i = begin; i < end; ++i) {
+                    io_uring_cqe *cqe = nullptr;
+                    if (io_uring_wait_cqe(&_uring, &cqe) < 0) {
+                        break;
+                    }
+                    results[io_uring_cqe_get_data64(cqe) - begin] = cqe->res;
+                    io_uring_cqe_seen(&_uring, cqe);
+                }
+
+                // 순서대로 마무리: 짧은 쓰기나 실패로 링크가 끊겨 취소된 뒤 요청은 앞 요청을 마친 뒤 동기적으로 기록
+                for (size_t i = begin; i < end; ++i) {
+                    const auto &request = ordered[i];
+                    int64_t result = results[i - begin];
+                    if (result == -ECANCELED) {
+                        result = writeFully(request.owner->_fd, request.buffer->data.get(), request.buffer->size,
+                                            request.buffer->offset);
+                    } else if (result >= 0 && static_cast<size_t>(result) < request.buffer->size) {
+                        const int64_t rest = writeFully(request.owner->_fd, request.buffer->data.get() + result,
+                                                        request.buffer->size - result, request.buffer->offset + result);
+                        result = rest < 0 ? rest : result + rest;
+                    }
+                    request.owner->onWriteComplete(request.buffer, result);
+                }
+            }
+            return;
+        }
+#endif
+        for (const auto &request: batch) {
+            const auto *buffer = request.buffer;
+            request.owner->onWriteComplete(request.buffer,
+                                           writeFully(request.owner->_fd, buffer->data.get(), buffer->size,
+                                                      buffer->offset));
+        }
+    }
+
+    std::deque<Request> _requests;
+    bool _running{true};
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::thread _thread;
+
+#ifdef LOKI_HAVE_IO_URING
+    io_uring _uring{};
+#endif
+    bool _useUring{false};
+
+    static constexpr unsigned URING_DEPTH = 64;
+};
+
+void WriteMetrics::recordWrite(const uint64_t bytes, const uint64_t latencyUs, const bool failed) {
+    if (failed) {
+        ++_errors;
+        return;
+    }
+    _bytes += bytes;
+    ++_writes;
+    _totalLatencyUs += latencyUs;
+    uint64_t max = _maxLatencyUs.load();
+    while (latencyUs > max && !_maxLatencyUs.compare_exchange_weak(max, latencyUs)) {
+    }
+}
+
+void WriteMetrics::recordStall(const uint64_t waitedUs) {
+    ++_stalls;
+    _stallUs += waitedUs;
+}
+
+WriteStats WriteMetrics::snapshot() const {
+    WriteStats stats;
+    stats.bytes = _bytes.load();
+    stats.writes = _writes.load();
+    stats.avgLatencyMs = stats.writes > 0 ? static_cast<double>(_totalLatencyUs.load()) / stats.writes / 1000.0 : 0.0;
+    stats.maxLatencyMs = static_cast<double>(_maxLatencyUs.load()) / 1000.0;
+    stats.stalls = _stalls.load();
+    stats.stallMs = static_cast<double>(_stallUs.load()) / 1000.0;
+    stats.errors = _errors.load();
+    return stats;
+}
+
+SegmentWriter::SegmentWriter(std::string path, const int64_t preallocateBytes, std::shared_ptr<WriteMetrics> metrics)
+        : _path(std::move(path)), _metrics(std::move(metrics)) {
+    _fd = open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (_fd < 0) {
+        throw std::runtime_error("Failed to create " + _path + ": " + std::strerror(errno));
+    }
+
+#ifdef __linux__
+    // 파일 크기는 그대로 두고 블록만 예약 (기록 중 읽는 쪽은 실제 기록된 크기만 봄)
+    if (preallocateBytes > 0 && fallocate(_fd, FALLOC_FL_KEEP_SIZE, 0, preallocateBytes) != 0 &&
+        errno != EOPNOTSUPP) {
+        spdlog::warn("Failed to preallocate {} bytes for {}: {}", preallocateBytes, _path, std::strerror(errno));
+    }
+#endif
+
+    auto *ioBuffer = static_cast<unsigned char *>(av_malloc(IO_BUFFER_SIZE));
+    _avio = ioBuffer ? avio_alloc_context(ioBuffer, IO_BUFFER_SIZE, 1, this, nullptr, &SegmentWriter::writePacket,
+                                          &SegmentWriter::seekPacket) : nullptr;
+    if (!_avio) {
+        av_free(ioBuffer);
+        ::close(_fd);
+        throw std::runtime_error("Failed to allocate output context for " + _path);
+    }
+    _avio->write_data_type = &SegmentWriter::writeDataType;
+}
+
+SegmentWriter::~SegmentWriter() {
+    close();
+    if (_avio) {
+        av_freep(&_avio->buffer);
+        avio_context_free(&_avio);
+    }
+}
+
+bool SegmentWriter::close() {
+    if (_closed) {
+        return !_failed;
+    }
+    _closed = true;
+
+    if (_current && _current->size > 0) {
+        submitCurrent();
+    }
+    waitInflight();
+
+    // 사전 할당했지만 쓰지 않은 블록 반환
+    if (ftruncate(_fd, _size) != 0) {
+        spdlog::warn("Failed to trim {}: {}", _path, std::strerror(errno));
+    }
+    ::close(_fd);
+    _fd = -1;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_failed) {
+        spdlog::error("Write errors while recording {}", _path);
+    }
+    return !_failed;
+}
+
+WriteStats SegmentWriter::getGlobalStats() {
+    return globalMetrics().snapshot();
+}
+
+int SegmentWriter::writePacket(void *opaque, PacketData buf, const int size) {
+    return static_cast<SegmentWriter *>(opaque)->write(buf, size);
+}
+
+int SegmentWriter::writeDataType(void *opaque, PacketData buf, const int size, const AVIODataMarkerType type,
+                                 int64_t /*time*/) {
+    auto *writer = static_cast<SegmentWriter *>(opaque);
+    const int result = writer->write(buf, size);
+    // 헤더(moov)와 fragment 는 경계까지 모이면 바로 기록 (기록 중 읽기, 비정상 종료 시 보존)
+    if (result >= 0 && type != AVIO_DATA_MARKER_UNKNOWN) {
+        writer->submitCurrent();
+    }
+    return result;
+}
+
+int64_t SegmentWriter::seekPacket(void *opaque, const int64_t offset, const int whence) {
+    return static_cast<SegmentWriter *>(opaque)->seek(offset, whence);
+}
+
+int SegmentWriter::write(const uint8_t *buf, const int size) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_failed) {
+            return AVERROR(EIO);
+        }
+    }
+
+    size_t remaining = static_cast<size_t>(size);
+    while (remaining > 0) {
+        // seek 후 이어지지 않는 위치면 모은 버퍼를 먼저 제출
+        if (_current && (_current->offset + static_cast<int64_t>(_current->size) != _position ||
+                         _current->size == BUFFER_SIZE)) {
+            submitCurrent();
+        }
+        if (!_current) {
+            _current = acquireBuffer();
+            _current->offset = _position;
+            _current->size = 0;
+            _currentSince = std::chrono::steady_clock::now();
+        }
+
+        const size_t count = std::min(remaining, BUFFER_SIZE - _current->size);
+        std::memcpy(_current->data.get() + _current->size, buf, count);
+        _current->size += count;
+        buf += count;
+        remaining -= count;
+        _position += static_cast<int64_t>(count);
+        _size = std::max(_size, _position);
+    }
+
+    if (_current && std::chrono::steady_clock::now() - _currentSince >= MAX_BUFFERED_TIME) {
+        submitCurrent();
+    }
+    return size;
+}
+
+int64_t SegmentWriter::seek(const int64_t offset, int whence) {
+    whence &= ~AVSEEK_FORCE;
+    if (whence == AVSEEK_SIZE) {
+        return _size;
+    }
+
+    int64_t target = -1;
+    if (whence == SEEK_SET) {
+        target = offset;
+    } else if (whence == SEEK_CUR) {
+        target = _position + offset;
+    } else if (whence == SEEK_END) {
+        target = _size + offset;
+    }
+    if (target < 0) {
+        return AVERROR(EINVAL);
+    }
+    _position = target;
+    return target;
+}
+
+void SegmentWriter::submitCurrent() {
+    Buffer *buffer = _current;
+    _current = nullptr;
+    if (!buffer || buffer->size == 0) {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _free.push_back(buffer);
+        }
+        return;
+    }
+
+    // 헤더/크기 갱신처럼 이미 제출한 범위를 다시 쓰는 경우 순서 보장 (드묾)
+    if (buffer->offset < _submittedEnd) {
+        waitInflight();
+    }
+    _submittedEnd = std::max(_submittedEnd, buffer->offset + static_cast<int64_t>(buffer->size));
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_inflight;
+    }
+    buffer->queuedAt = std::chrono::steady_clock::now();
+    SegmentWriteQueue::instance().submit(this, buffer);
+}
+
+SegmentWriter::Buffer *SegmentWriter::acquireBuffer() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_free.empty() && _buffers.size() < MAX_BUFFERS) {
+        auto buffer = std::make_unique<Buffer>();
+        buffer->data.reset(static_cast<uint8_t *>(std::aligned_alloc(BUFFER_ALIGNMENT, BUFFER_SIZE)));
+        if (buffer->data) {
+            _free.push_back(buffer.get());
+            _buffers.push_back(std::move(buffer));
+        }
+    }
+
+    if (_free.empty()) {
+        // 모든 버퍼가 기록 대기 중: 파일 시스템이 따라오지 못함
+        const auto waitStart = std::chrono::steady_clock::now();
+        _released.wait(lock, [this] { return !_free.empty(); });
+        const auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - waitStart).count();
+        if (_metrics) {
+            _metrics->recordStall(static_cast<uint64_t>(waited));
+        }
+        globalMetrics().recordStall(static_cast<uint64_t>(waited));
+    }
+
+    Buffer *buffer = _free.back();
+    _free.pop_back();
+    return buffer;
+}
+
+void SegmentWriter::waitInflight() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _released.wait(lock, [this] { return _inflight == 0; });
+}
+
+void SegmentWriter::onWriteComplete(Buffer *buffer, const int64_t result) {
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - buffer->queuedAt).count();
+    const bool failed = result < 0;
+    if (failed) {
+        spdlog::warn("Segment write failed for {} at {}: {}", _path, buffer->offset, std::strerror(static_cast<int>(-result)));
+    }
+    if (_metrics) {
+        _metrics->recordWrite(buffer->size, static_cast<uint64_t>(latency), failed);
+    }
+    globalMetrics().recordWrite(buffer->size, static_cast<uint64_t>(latency), failed);
+
+    // close() 가 깨어나면 writer 가 해제되므로 락을 놓은 뒤에는 접근하지 않음
+    std::lock_guard<std::mutex> lock(_mutex);
+    _failed = _failed || failed;
+    buffer->size = 0;
+    _free.push_back(buffer);
+    --_inflight;
+    _released.notify_all();
+}
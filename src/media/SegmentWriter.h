@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avio.h>
+#include <libavformat/version.h>
+}
+
+// 세그먼트 파일 쓰기 지표 스냅샷
+struct WriteStats {
+    uint64_t bytes{0};
+    uint64_t writes{0};             // 완료된 백그라운드 쓰기 요청 수
+    double avgLatencyMs{0.0};       // 버퍼 제출부터 쓰기 완료까지
+    double maxLatencyMs{0.0};
+    uint64_t stalls{0};             // 빈 버퍼가 없어 muxer 스레드가 대기한 횟수
+    double stallMs{0.0};
+    uint64_t errors{0};
+};
+
+// 여러 writer 가 누적하는 지표 (Encoder 단위 / 전체)
+class WriteMetrics {
+public:
+    void recordWrite(uint64_t bytes, uint64_t latencyUs, bool failed);
+
+    void recordStall(uint64_t waitedUs);
+
+    WriteStats snapshot() const;
+
+private:
+    std::atomic<uint64_t> _bytes{0};
+    std::atomic<uint64_t> _writes{0};
+    std::atomic<uint64_t> _totalLatencyUs{0};
+    std::atomic<uint64_t> _maxLatencyUs{0};
+    std::atomic<uint64_t> _stalls{0};
+    std::atomic<uint64_t> _stallUs{0};
+    std::atomic<uint64_t> _errors{0};
+};
+
+// 세그먼트 파일 출력용 AVIO
+// 파일을 예상 크기만큼 미리 할당하고, muxer 쓰기를 큰 정렬 버퍼에 모아 공유 백그라운드 writer 가 기록
+// (io_uring 이 있으면 대기 중인 버퍼를 한 번에 제출, 같은 파일은 순서대로) 파일 시스템 지연이 인코딩 스레드로 전달되지 않게 함
+class SegmentWriter {
+public:
+    // 파일을 만들 수 없으면 예외
+    SegmentWriter(std::string path, int64_t preallocateBytes, std::shared_ptr<WriteMetrics> metrics);
+
+    ~SegmentWriter();
+
+    SegmentWriter(const SegmentWriter &) = delete;
+
+    SegmentWriter &operator=(const SegmentWriter &) = delete;
+
+    AVIOContext *context() const { return _avio; }
+
+    // avio_flush 이후 호출: 남은 버퍼 기록과 완료 대기, 쓰지 않은 사전 할당 해제 (쓰기 오류가 있었으면 false)
+    bool close();
+
+    const std::string &path() const { return _path; }
+
+    // 모든 세그먼트 writer 의 누적 지표
+    static WriteStats getGlobalStats();
+
+    static constexpr size_t BUFFER_SIZE = 1024 * 1024;
+
+private:
+    friend class SegmentWriteQueue;
+
+    struct AlignedFree {
+        void operator()(uint8_t *p) const { std::free(p); }
+    };
+
+    struct Buffer {
+        std::unique_ptr<uint8_t, AlignedFree> data;
+        size_t size{0};
+        int64_t offset{0};
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+#if LIBAVFORMAT_VERSION_MAJOR >= 61
+    using PacketData = const uint8_t *;
+#else
+    using PacketData = uint8_t *;
+#endif
+
+    static int writePacket(void *opaque, PacketData buf, int size);
+
+    // muxer 가 표시한 데이터 경계 (헤더/fragment 단위로 바로 제출)
+    static int writeDataType(void *opaque, PacketData buf, int size, AVIODataMarkerType type, int64_t time);
+
+    static int64_t seekPacket(void *opaque, int64_t offset, int whence);
+
+    int write(const uint8_t *buf, int size);
+
+    int64_t seek(int64_t offset, int whence);
+
+    // 채워진 버퍼를 백그라운드 writer 로 (앞서 쓴 범위를 다시 쓰면 이전 요청 완료 후 제출)
+    void submitCurrent();
+
+    Buffer *acquireBuffer();
+
+    void waitInflight();
+
+    // [writer thread] 쓰기 완료 (result: 쓴 바이트 또는 음수 errno)
+    void onWriteComplete(Buffer *buffer, int64_t result);
+
+    std::string _path;
+    int _fd{-1};
+    AVIOContext *_avio{nullptr};
+    std::shared_ptr<WriteMetrics> _metrics;
+
+    // muxer 스레드 전용
+    Buffer *_current{nullptr};
+    std::chrono::steady_clock::time_point _currentSince;
+    int64_t _position{0};
+    int64_t _size{0};
+    int64_t _submittedEnd{0};
+    bool _closed{false};
+
+    // _mutex 보호 (writer thread 와 공유)
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+    std::vector<Buffer *> _free;
+    size_t _inflight{0};
+    bool _failed{false};
+    std::mutex _mutex;
+    std::condition_variable _released;
+
+    static constexpr size_t MAX_BUFFERS = 8;            // writer 당 최대 8 MiB 까지 쓰기 지연 흡수
+    static constexpr size_t BUFFER_ALIGNMENT = 4096;
+    static constexpr int IO_BUFFER_SIZE = 256 * 1024;
+    // 경계 표시가 없는 컨테이너도 이 시간 이상 메모리에만 두지 않음
+    static constexpr std::chrono::milliseconds MAX_BUFFERED_TIME{500};
+};
@@ -0,0 +1,455 @@
+#include "SegmentedVideoSource.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
+#include <spdlog/spdlog.h>
+#include "FileVideoSource.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    // "<timestamp>_part<N>.<ext>" 의 N (없으면 -1)
+    int segmentNumber(const fs::path &path) {
+        const std::string stem = path.stem().string();
+        const auto pos = stem.rfind("_part");
+        if (pos == std::string::npos) {
+            return -1;
+        }
+        try {
+            return std::stoi(stem.substr(pos + 5));
+        } catch (const std::exception &) {
+            return -1;
+        }
+    }
+}
+
+SegmentedVideoSource::SegmentedVideoSource(const std::string &sessionDir, IDecoderSource::DecoderConfig config)
+        : _config(std::move(config)) {
+    // 키프레임은 컨테이너 색인으로 구성하므로 세그먼트마다 전체 패킷을 스캔하지 않음
+    _config.scanFrameTypes = false;
+    _outputWidth = _config.outputWidth;
+    _outputHeight = _config.outputHeight;
+
+    for (const auto &path: listSegmentFiles(sessionDir)) {
+        Segment segment;
+        segment.path = path;
+        segment.start = _duration;
+
+        std::vector<double> keyframes;
+        if (!probeSegment(path, segment, keyframes)) {
+            spdlog::warn("Skipping unreadable segment: {}", path);
+            continue;
+        }
+        for (const double keyframe: keyframes) {
+            _keyframes.push_back(segment.start + keyframe);
+        }
+        findProxy(segment);
+        _hasProxy = _hasProxy || !segment.proxyPath.empty();
+        _duration += segment.duration;
+        _segments.push_back(std::move(segment));
+    }
+
+    if (_segments.empty()) {
+        throw std::runtime_error("No recorded segments in " + sessionDir);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _current = takeSegment(0, false, takePrepared(0));
+    if (!_current) {
+        throw std::runtime_error("Failed to open first segment of " + sessionDir);
+    }
+    prepareNextSegment();
+
+    spdlog::info("Opened session {}: {} segments, {:.1f}s, {} keyframes{}",
+                 sessionDir, _segments.size(), _duration, _keyframes.size(), _hasProxy ? ", with proxy" : "");
+}
+
+SegmentedVideoSource::~SegmentedVideoSource() {
+    stop();
+}
+
+void SegmentedVideoSource::start() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _running = true;
+    if (_current) {
+        _current->start();
+    }
+    if (!_monitorRunning) {
+        _monitorRunning = true;
+        _monitor = std::thread(&SegmentedVideoSource::monitorLoop, this);
+    }
+}
+
+void SegmentedVideoSource::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+        _monitorRunning = false;
+        if (_current) {
+            _current->stop();
+        }
+    }
+    _wake.notify_all();
+
+    if (_monitor.joinable()) {
+        _monitor.join();
+    }
+
+    // 디코더 정지와 같이 대기 중인 소비자를 깨움
+    _videoQueue.clear();
+    _audioQueue.clear();
+    _videoQueue.push(VideoFrame{});
+    _audioQueue.push(AudioFrame{});
+}
+
+void SegmentedVideoSource::startRecord(const RecordOptions &) {
+    throw std::runtime_error("Recording is not supported while playing a recorded session");
+}
+
+void SegmentedVideoSource::flush() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_current) {
+        _current->flush();
+    }
+    _videoQueue.clear();
+    _audioQueue.clear();
+}
+
+void SegmentedVideoSource::setPlaybackHint(const PlaybackHint &hint) {
+    std::unique_ptr<Decoder> previous;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _playbackHint = hint;
+        _paused = !hint.playing;
+        if (_current) {
+            _current->setClockPaused(_paused);
+        }
+        if (!_hasProxy || !_running || !_current) {
+            return;
+        }
+
+        const auto now = ProxySwitchPolicy::Clock::now();
+        if (!_currentProxy && hint.playing) {
+            _proxyPolicy.onLateFrames(_current->getLateFrames(), now);
+        }
+        _usingProxy = _proxyPolicy.shouldUseProxy(hint.playing, hint.speed, _usingProxy, now);
+
+        // 현재 세그먼트에 rendition 이 없으면 다음 세그먼트부터 적용
+        if (useProxyFor(_currentIndex) != _currentProxy) {
+            const double position = currentPosition();
+            _lastSeekTarget = position;
+            seekLocked(position, previous);
+            spdlog::info("Switched to {} decoding at {:.3f}s", _currentProxy ? "proxy" : "original", position);
+        } else {
+            prepareNextSegment();
+        }
+    }
+
+    // 이전 디코더 해제는 락 밖에서
+    previous.reset();
+}
+
+void SegmentedVideoSource::setOutputSize(const int width, const int height) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _outputWidth = width;
+    _outputHeight = height;
+    if (_current) {
+        _current->setOutputSize(width, height);
+    }
+}
+
+bool SegmentedVideoSource::seek(double timeInSeconds) {
+    std::unique_ptr<Decoder> previous;
+    bool result = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        timeInSeconds = std::clamp(timeInSeconds, 0.0, _duration);
+        _lastSeekTarget = timeInSeconds;
+
+        if (_hasProxy) {
+            const auto now = ProxySwitchPolicy::Clock::now();
+            _proxyPolicy.onSeek(now);
+            // 스크러빙이 시작되면 다음 update 를 기다리지 않고 바로 rendition 에서 seek
+            if (_proxyPolicy.shouldUseProxy(_playbackHint.playing, _playbackHint.speed, _usingProxy, now)) {
+                _usingProxy = true;
+            }
+        }
+        result = seekLocked(timeInSeconds, previous);
+    }
+
+    // 이전 디코더 해제는 락 밖에서
+    previous.reset();
+    return result;
+}
+
+bool SegmentedVideoSource::seekLocked(const double timeInSeconds, std::unique_ptr<Decoder> &previous) {
+    const size_t index = segmentAt(timeInSeconds);
+    const bool proxy = useProxyFor(index);
+
+    if (!_current || index != _currentIndex || proxy != _currentProxy) {
+        auto decoder = takeSegment(index, proxy, takePrepared(index));
+        if (!decoder) {
+            return false;
+        }
+
+        // 이전 세그먼트 출력 중단 후 공유 큐 비움
+        if (_current) {
+            _current->stop();
+        }
+        _videoQueue.clear();
+        _audioQueue.clear();
+
+        previous = std::move(_current);
+        _current = std::move(decoder);
+        _currentIndex = index;
+        _currentProxy = proxy;
+        _exhausted = false;
+        prepareNextSegment();
+    }
+
+    const bool result = _current->seek(timeInSeconds);
+    ++_seekGeneration;
+    _current->setClockPaused(_paused);
+    _current->setOutputSize(_outputWidth, _outputHeight);
+    if (_running) {
+        _current->start();
+    }
+    return result;
+}
+
+double SegmentedVideoSource::currentPosition() const {
+    if (_current->isSeekPending()) {
+        return _lastSeekTarget;
+    }
+    const double pts = _current->getLastPresentedPts();
+    return pts >= 0.0 ? pts : _lastSeekTarget;
+}
+
+bool SegmentedVideoSource::isUsingProxy() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _currentProxy;
+}
+
+CodecInfo SegmentedVideoSource::getCodecInfo() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _current ? _current->getCodecInfo() : CodecInfo{};
+}
+
+void SegmentedVideoSource::setFrameAllocator(std::shared_ptr<IFrameAllocator> allocator) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _frameAllocator = std::move(allocator);
+    if (_current && !_running) {
+        _current->setFrameAllocator(_frameAllocator);
+    }
+}
+
+bool SegmentedVideoSource::isSessionDirectory(const std::string &path) {
+    std::error_code ec;
+    return fs::is_directory(path, ec) && !listSegmentFiles(path).empty();
+}
+
+std::vector<std::string> SegmentedVideoSource::listSegmentFiles(const std::string &sessionDir) {
+    std::vector<fs::path> files;
+    std::error_code ec;
+    // rendition 하위 폴더는 제외 (세션 디렉터리 바로 아래 세그먼트만)
+    for (const auto &entry: fs::directory_iterator(sessionDir, ec)) {
+        if (!entry.is_regular_file(ec) || segmentNumber(entry.path()) < 0) {
+            continue;
+        }
+        const auto extension = entry.path().extension().string();
+        if (extension == ".mp4" || extension == ".mkv" || extension == ".mov") {
+            files.push_back(entry.path());
+        }
+    }
+
+    // 파일명 앞의 시각은 세그먼트를 연 시각이므로 part 번호 순으로 정렬
+    std::sort(files.begin(), files.end(), [](const fs::path &a, const fs::path &b) {
+        const int partA = segmentNumber(a);
+        const int partB = segmentNumber(b);
+        return partA != partB ? partA < partB : a.filename() < b.filename();
+    });
+
+    std::vector<std::string> paths;
+    paths.reserve(files.size());
+    for (const auto &file: files) {
+        paths.push_back(file.string());
+    }
+    return paths;
+}
+
+void SegmentedVideoSource::findProxy(Segment &segment) {
+    const std::string proxyPath = FileVideoSource::findProxyFile(segment.path);
+    if (proxyPath.empty()) {
+        return;
+    }
+
+    // 기록이 끊긴 rendition 등 다른 구간의 파일은 사용하지 않음
+    Segment proxy;
+    std::vector<double> keyframes;
+    if (!probeSegment(proxyPath, proxy, keyframes) ||
+        std::abs(proxy.duration - segment.duration) > PROXY_DURATION_TOLERANCE) {
+        spdlog::warn("Ignoring proxy {} (duration {:.2f}s vs {:.2f}s)", proxyPath, proxy.duration, segment.duration);
+        return;
+    }
+    segment.proxyPath = proxyPath;
+    segment.proxyLocalStart = proxy.localStart;
+}
+
+bool SegmentedVideoSource::probeSegment(const std::string &path, Segment &segment, std::vector<double> &keyframes) {
+    AVFormatContext *ctx = nullptr;
+    if (avformat_open_input(&ctx, path.c_str(), nullptr, nullptr) < 0) {
+        return false;
+    }
+
+    const int videoIndex = av_find_best_stream(ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (videoIndex < 0) {
+        avformat_close_input(&ctx);
+        return false;
+    }
+
+    AVStream *stream = ctx->streams[videoIndex];
+    const double timeBase = av_q2d(stream->time_base);
+    segment.localStart = stream->start_time != AV_NOPTS_VALUE ? static_cast<double>(stream->start_time) * timeBase
+                                                               : 0.0;
+    if (stream->duration > 0) {
+        segment.duration = static_cast<double>(stream->duration) * timeBase;
+    } else if (ctx->duration > 0) {
+        segment.duration = static_cast<double>(ctx->duration) / AV_TIME_BASE;
+    }
+
+    if (_videoWidth == 0) {
+        _videoWidth = stream->codecpar->width;
+        _videoHeight = stream->codecpar->height;
+    }
+
+    const int entries = avformat_index_get_entries_count(stream);
+    for (int i = 0; i < entries; ++i) {
+        const AVIndexEntry *entry = avformat_index_get_entry(stream, i);
+        if (entry && (entry->flags & AVINDEX_KEYFRAME)) {
+            keyframes.push_back(static_cast<double>(entry->timestamp) * timeBase - segment.localStart);
+        }
+    }
+
+    avformat_close_input(&ctx);
+    return segment.duration > 0.0;
+}
+
+size_t SegmentedVideoSource::segmentAt(const double time) const {
+    const auto it = std::upper_bound(_segments.begin(), _segments.end(), time,
+                                     [](const double t, const Segment &segment) { return t < segment.start; });
+    return it == _segments.begin() ? 0 : static_cast<size_t>(it - _segments.begin() - 1);
+}
+
+std::unique_ptr<Decoder> SegmentedVideoSource::openSegment(const size_t index, const bool proxy) {
+    const Segment &segment = _segments[index];
+    auto config = _config;
+    config.outputWidth = _outputWidth;
+    config.outputHeight = _outputHeight;
+    auto decoder = std::make_unique<Decoder>(proxy ? segment.proxyPath : segment.path, config);
+    decoder->setVideoOutput(_videoQueue);
+    decoder->setAudioOutput(_audioQueue);
+    // 세그먼트 로컬 PTS -> 세션 시간축
+    decoder->setTimeOffset(segment.start - (proxy ? segment.proxyLocalStart : segment.localStart));
+    return decoder;
+}
+
+std::future<std::unique_ptr<Decoder>> SegmentedVideoSource::takePrepared(const size_t index) {
+    if (_next.valid() && _nextIndex == index && _nextProxy == useProxyFor(index)) {
+        return std::move(_next);
+    }
+    return {};
+}
+
+std::unique_ptr<Decoder> SegmentedVideoSource::takeSegment(const size_t index, const bool proxy,
+                                                           std::future<std::unique_ptr<Decoder>> prepared) {
+    std::unique_ptr<Decoder> decoder;
+    try {
+        if (prepared.valid()) {
+            decoder = prepared.get();
+        } else {
+            decoder = openSegment(index, proxy);
+        }
+    } catch (const std::exception &e) {
+        spdlog::error("Failed to open segment {}: {}", _segments[index].path, e.what());
+        return nullptr;
+    }
+
+    if (decoder && _frameAllocator) {
+        decoder->setFrameAllocator(_frameAllocator);
+    }
+    return decoder;
+}
+
+void SegmentedVideoSource::prepareNextSegment() {
+    const size_t next = _currentIndex + 1;
+    if (next >= _segments.size()) {
+        return;
+    }
+    const bool proxy = useProxyFor(next);
+    if (_next.valid() && _nextIndex == next && _nextProxy == proxy) {
+        return;
+    }
+
+    // 파일 열기/코덱 초기화를 경계 도달 전에 백그라운드에서 수행
+    _nextIndex = next;
+    _nextProxy = proxy;
+    _next = std::async(std::launch::async, [this, next, proxy] { return openSegment(next, proxy); });
+}
+
+void SegmentedVideoSource::monitorLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_monitorRunning) {
+        _wake.wait_for(lock, BOUNDARY_POLL_INTERVAL, [this] { return !_monitorRunning; });
+        if (!_monitorRunning || !_running || _exhausted || !_current || !_current->isFinished()) {
+            continue;
+        }
+
+        // 현재 세그먼트 출력이 끝나면 미리 열어 둔 다음 세그먼트를 같은 큐로 이어서 출력
+        const uint64_t generation = _seekGeneration;
+        size_t index = _currentIndex + 1;
+        std::unique_ptr<Decoder> next;
+        bool proxy = false;
+        while (index < _segments.size()) {
+            auto prepared = takePrepared(index);
+            proxy = useProxyFor(index);
+            // 열기 완료 대기/직접 열기는 락 밖에서 (매 update 의 setPlaybackHint 가 막히지 않도록)
+            lock.unlock();
+            next = takeSegment(index, proxy, std::move(prepared));
+            lock.lock();
+            if (next || _seekGeneration != generation) {
+                break;
+            }
+            ++index;
+        }
+
+        // 기다리는 동안 seek/stop 으로 현재 세그먼트가 바뀌었으면 버림
+        if (_seekGeneration != generation || !_monitorRunning || !_running) {
+            lock.unlock();
+            next.reset();
+            lock.lock();
+            continue;
+        }
+        if (!next) {
+            _exhausted = true;
+            continue;
+        }
+
+        next->setClockPaused(_paused);
+        next->setOutputSize(_outputWidth, _outputHeight);
+        next->start();
+        auto previous = std::move(_current);
+        _current = std::move(next);
+        _currentIndex = index;
+        _currentProxy = proxy;
+        // 새 세그먼트가 첫 프레임을 출력하기 전 위치는 세그먼트 시작
+        _lastSeekTarget = _segments[index].start;
+        prepareNextSegment();
+        spdlog::info("Continuing session with segment {}/{}", _currentIndex + 1, _segments.size());
+
+        lock.unlock();
+        previous->stop();
+        previous.reset();
+        lock.lock();
+    }
+}
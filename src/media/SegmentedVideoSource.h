@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Decoder.h"
+#include "ProxySwitchPolicy.h"
+#include "media/interface/IVideoSource.h"
+
+// 녹화 세션 디렉터리의 *_partN 세그먼트를 하나의 연속된 시간축으로 재생
+// 다음 세그먼트 디코더를 미리 열어 두고 현재 세그먼트 출력이 끝나면 같은 큐로 이어서 출력
+// 세그먼트마다 같은 이름의 rendition(proxy_*/<파일명>)이 있으면 스크러빙/고배속 시 그 파일에서 디코딩
+class SegmentedVideoSource final : public IVideoSource {
+public:
+    // 세그먼트가 없으면 예외
+    SegmentedVideoSource(const std::string &sessionDir, IDecoderSource::DecoderConfig config);
+
+    ~SegmentedVideoSource() override;
+
+    void start() override;
+
+    void stop() override;
+
+    // 세션 재생 중 녹화는 지원하지 않음 (예외)
+    void startRecord(const RecordOptions &options) override;
+
+    void stopRecord() override {}
+
+    void setPreRecord(const PreRecordConfig &) override {}
+
+    void flush() override;
+
+    bool seek(double timeInSeconds) override;
+
+    void setPlaybackHint(const PlaybackHint &hint) override;
+
+    void setOutputSize(int width, int height) override;
+
+    double getDuration() const override { return _duration; }
+
+    CodecInfo getCodecInfo() const override;
+
+    ThreadSafeQueue<VideoFrame> &getVideoQueue() override { return _videoQueue; }
+
+    ThreadSafeQueue<AudioFrame> &getAudioQueue() override { return _audioQueue; }
+
+    uint64_t getDroppedRecordFrames() const override { return 0; }
+
+    // 전체 세션 시간축의 키프레임 (세그먼트 컨테이너 색인에서 구성)
+    std::vector<double> getIFrameTimestamps() const override { return _keyframes; }
+
+    // P 프레임 위치는 패킷 스캔이 필요하므로 제공하지 않음
+    std::vector<double> getPFrameTimestamps() const override { return {}; }
+
+    bool isUsingProxy() const;
+
+    void setFrameAllocator(std::shared_ptr<IFrameAllocator> allocator);
+
+    int getVideoWidth() const { return _videoWidth; }
+
+    int getVideoHeight() const { return _videoHeight; }
+
+    // 디렉터리에 녹화 세그먼트가 있는지
+    static bool isSessionDirectory(const std::string &path);
+
+    // 세션 디렉터리 바로 아래의 세그먼트 파일 (part 번호 순)
+    static std::vector<std::string> listSegmentFiles(const std::string &sessionDir);
+
+private:
+    struct Segment {
+        std::string path;
+        double start{0.0};          // 세션 시간축 시작 (이전 세그먼트 길이의 합)
+        double duration{0.0};
+        double localStart{0.0};     // 파일 내 비디오 start_time
+        std::string proxyPath;      // 같은 구간의 rendition (없으면 빈 문자열)
+        double proxyLocalStart{0.0};
+    };
+
+    // 컨테이너 헤더/색인만 읽어 길이와 키프레임 수집 (패킷은 읽지 않음)
+    bool probeSegment(const std::string &path, Segment &segment, std::vector<double> &keyframes);
+
+    // rendition 이 길이가 같으면 등록
+    void findProxy(Segment &segment);
+
+    size_t segmentAt(double time) const;
+
+    // _mutex 보유 상태에서 호출 - 현재 모드에서 index 세그먼트를 proxy 로 열지
+    bool useProxyFor(size_t index) const { return _usingProxy && !_segments[index].proxyPath.empty(); }
+
+    // 공유 출력 큐와 세션 시간 offset 을 설정한 디코더 (백그라운드에서도 호출)
+    std::unique_ptr<Decoder> openSegment(size_t index, bool proxy);
+
+    // _mutex 보유 상태에서 호출 - index 를 같은 종류(원본/proxy)로 미리 열고 있으면 그 future 를 넘겨받음
+    std::future<std::unique_ptr<Decoder>> takePrepared(size_t index);
+
+    // 락 없이 호출 가능 - prepared 가 있으면 완료를 기다리고 없으면 직접 엶
+    std::unique_ptr<Decoder> takeSegment(size_t index, bool proxy, std::future<std::unique_ptr<Decoder>> prepared);
+
+    // _mutex 보유 상태에서 호출 - 현재 디코더를 세션 시각 위치의 세그먼트(현재 모드)로 교체, 이전 디코더는 previous 로
+    bool seekLocked(double timeInSeconds, std::unique_ptr<Decoder> &previous);
+
+    double currentPosition() const;
+
+    void prepareNextSegment();
+
+    void monitorLoop();
+
+    IDecoderSource::DecoderConfig _config;
+    std::vector<Segment> _segments;
+    std::vector<double> _keyframes;
+    double _duration{0.0};
+    int _videoWidth{0};
+    int _videoHeight{0};
+
+    // 모든 세그먼트 디코더가 이 큐로 출력 (디코더보다 먼저 선언)
+    ThreadSafeQueue<VideoFrame> _videoQueue;
+    ThreadSafeQueue<AudioFrame> _audioQueue;
+    std::shared_ptr<IFrameAllocator> _frameAllocator;
+
+    std::unique_ptr<Decoder> _current;
+    size_t _currentIndex{0};
+    bool _currentProxy{false};
+    std::future<std::unique_ptr<Decoder>> _next;
+    size_t _nextIndex{0};
+    bool _nextProxy{false};
+
+    // rendition 전환 (세그먼트 중 하나라도 rendition 이 있을 때)
+    bool _hasProxy{false};
+    bool _usingProxy{false};
+    ProxySwitchPolicy _proxyPolicy;
+    PlaybackHint _playbackHint;
+    double _lastSeekTarget{0.0};
+    uint64_t _seekGeneration{0};    // seek 마다 증가 (경계 전환 중 seek 감지)
+
+    bool _running{false};
+    bool _paused{false};            // 출력 시계 정지 (이어지는 세그먼트 디코더에도 적용)
+    // 출력 크기 힌트 (미리 여는 세그먼트에도 적용)
+    std::atomic<int> _outputWidth{0};
+    std::atomic<int> _outputHeight{0};
+    bool _exhausted{false};         // 다음에 열 수 있는 세그먼트 없음 (seek 하면 해제)
+    bool _monitorRunning{false};
+    std::thread _monitor;
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+
+    static constexpr auto BOUNDARY_POLL_INTERVAL = std::chrono::milliseconds(5);
+    static constexpr double PROXY_DURATION_TOLERANCE = 1.0;
+};
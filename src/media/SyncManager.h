@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ClockDriftEstimator.h"
 #include "VideoFrame.h"
 #include <atomic>
 #include <thread>
@@ -12,10 +13,14 @@
 #include <deque>
 #include <limits>
 #include <iomanip>
+#include <cmath>
 
-constexpr double MAX_INTER_CHANNEL_SYNC_MS = 0.002;
+// 채널간 매칭 허용 오차 (초) - 최소값, 실제 값은 채널별 추정 잔차와 프레임 간격으로 조정
+constexpr double MIN_INTER_CHANNEL_SYNC_WINDOW_SEC = 0.002;
+constexpr double SYNC_WINDOW_RESIDUAL_SCALE = 3.0;
 constexpr double MAX_AUDIO_VIDEO_SYNC_MS = 0.01;
 constexpr size_t MAX_FRAME_QUEUE_SIZE = 3;
+constexpr size_t MAX_SYNCED_SET_QUEUE_SIZE = 2;
 
 class SyncManager {
 public:
@@ -39,6 +44,9 @@ public:
               _running(true),
               _syncThread(&SyncManager::syncLoop, this) {
         _frameQueues.resize(numChannels);
+        _relaxedChannels.resize(numChannels, false);
+        _finishedChannels.resize(numChannels, false);
+        _estimators.resize(numChannels);
     }
 
     ~SyncManager() {
@@ -100,76 +108,92 @@ public:
     }
 
     std::vector<VideoFrame> getSynchronizedFrames() {
-        std::vector<VideoFrame> frames(_numChannels);
         std::unique_lock<std::mutex> lock(_mutex);
 
-        _cv.wait(lock, [this] {
-            if (!_running) {
-                return true;
-            }
-            if (!_initialized || _paused) {
-                return false;
-            }
-
-            for (const auto &queue: _frameQueues) {
-                if (queue.empty()) {
-                    return false;
-                }
-            }
-            return true;
-        });
+        _cv.wait(lock, [this] { return !_running || isReadyLocked(); });
 
         if (!_running) return {};
         if (_paused) return {};
 
-        // 마스터 채널의 PTS 획득
-        if (_frameQueues[_masterChannel].empty()) return {};
-        const double refPts = _frameQueues[_masterChannel].front().pts;
+        return collectSynchronizedFramesLocked();
+    }
 
-        // 각 채널에서 마스터 채널의 PTS에 가장 가까운 프레임 획득
-        for (size_t i = 0; i < _numChannels; ++i) {
-            if (i == _masterChannel) {
-                frames[i] = std::move(_frameQueues[i].front().frame);
-                _frameQueues[i].pop_front();
-                continue;
-            }
+    // 동기화 스레드가 만든 프레임 세트 획득 (non-blocking)
+    bool popSynchronizedFrames(std::vector<VideoFrame> &frames) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_syncedSets.empty()) {
+            return false;
+        }
 
-            auto &queue = _frameQueues[i];
-            if (queue.empty()) {
-                continue;
-            }
+        frames = std::move(_syncedSets.front());
+        _syncedSets.pop_front();
+        _cv.notify_all();
+        return true;
+    }
 
-            // 가장 가까운 PTS에 있는 프레임 찾기
-            auto bestMatch = queue.begin();
-            double minDiff = std::abs(bestMatch->pts - refPts);
-            for (auto it = queue.begin(); it != queue.end(); ++it) {
-                double diff = std::abs(it->pts - refPts);
-                if (diff < minDiff) {
-                    minDiff = diff;
-                    bestMatch = it;
-                }
-            }
+    void setMasterChannel(ChannelId channelId) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (channelId < _numChannels && channelId != _masterChannel) {
+            _masterChannel = channelId;
 
-            // 허용 오차 내에서 최적 매치 탐색
-            if (minDiff <= MAX_INTER_CHANNEL_SYNC_MS) {
-                // 최적 매치 된 프레임 설정하고 그 외 프레임은 제거
-                frames[i] = std::move(bestMatch->frame);
-                queue.erase(queue.begin(), std::next(bestMatch));
-            } else if (minDiff > MAX_INTER_CHANNEL_SYNC_MS * 2) {
-                // 동기화 실패하면 프레임 드랍 처리
-                if (!queue.empty()) {
-                    queue.pop_front();
-                }
-                _dropCount++;
-                if (_dropCount % 10 == 0) {
-                    std::cerr << "[Sync] Dropped frame from channel " << i
-                              << " (out of sync: " << (minDiff * 1000.0) << "ms > "
-                              << (MAX_INTER_CHANNEL_SYNC_MS * 1000.0) << "ms)" << std::endl;
-                }
+            // offset/skew 는 마스터 기준이므로 재추정
+            for (auto &estimator: _estimators) {
+                estimator.reset();
             }
         }
+    }
 
-        return frames;
+    ChannelId getMasterChannel() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _masterChannel;
+    }
+
+    // relaxed 채널: 저우선순위(저 fps) 채널로 동기화 대기 대상에서 제외하고 마스터 PTS 이전의 최신 프레임만 사용
+    void setChannelRelaxed(ChannelId channelId, bool relaxed) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (channelId < _numChannels) {
+            _relaxedChannels[channelId] = relaxed;
+            _cv.notify_all();
+        }
+    }
+
+    // finished 채널: 끝까지 출력한 채널로 동기화 대기 대상에서 제외 (타일은 마지막 프레임 유지)
+    void setChannelFinished(ChannelId channelId, bool finished) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (channelId < _numChannels && _finishedChannels[channelId] != finished) {
+            _finishedChannels[channelId] = finished;
+            _cv.notify_all();
+        }
+    }
+
+    bool isChannelRelaxed(ChannelId channelId) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return channelId < _numChannels && _relaxedChannels[channelId];
+    }
+
+    size_t getNumChannels() const { return _numChannels; }
+
+    struct ClockEstimate {
+        double offset;      // 마스터 대비 PTS offset (초)
+        double skew;        // 마스터 대비 클럭 속도 차이 (초/초)
+        double window;      // 현재 매칭 허용 오차 (초)
+        bool converged;
+    };
+
+    std::vector<ClockEstimate> getClockEstimates() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<ClockEstimate> estimates(_numChannels);
+        for (size_t i = 0; i < _numChannels; ++i) {
+            const auto &estimator = _estimators[i];
+            const bool isMaster = (i == _masterChannel);
+            estimates[i] = ClockEstimate{
+                    .offset = isMaster ? 0.0 : estimator.getOffset(),
+                    .skew = isMaster ? 0.0 : estimator.getSkew(),
+                    .window = getSyncWindowLocked(i),
+                    .converged = isMaster || estimator.isConverged()
+            };
+        }
+        return estimates;
     }
 
     size_t getQueueSize(ChannelId channelId) const {
@@ -213,20 +237,166 @@ public:
         _initialized = false;
         _paused = false;
         _audioClock = 0.0;
+        _lastMasterPts = -1.0;
 
+        // offset/skew 추정치는 seek/재시작 후에도 유효하므로 유지
         for (auto &queue: _frameQueues) {
             queue.clear();
         }
+        std::fill(_finishedChannels.begin(), _finishedChannels.end(), false);
+        _syncedSets.clear();
 
         _cv.notify_all();
     }
 
 private:
+    bool isReadyLocked() const {
+        if (!_initialized || _paused) {
+            return false;
+        }
+
+        for (size_t i = 0; i < _numChannels; ++i) {
+            if (_frameQueues[i].empty() &&
+                (i == _masterChannel || (!_relaxedChannels[i] && !_finishedChannels[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<VideoFrame> collectSynchronizedFramesLocked() {
+        std::vector<VideoFrame> frames(_numChannels);
+
+        // 마스터 채널의 PTS 획득
+        if (_frameQueues[_masterChannel].empty()) return {};
+        const double refPts = _frameQueues[_masterChannel].front().pts;
+        updateMasterFrameIntervalLocked(refPts);
+
+        // 각 채널에서 (offset/skew 보정된) 마스터 채널의 PTS에 가장 가까운 프레임 획득
+        for (size_t i = 0; i < _numChannels; ++i) {
+            if (i == _masterChannel) {
+                frames[i] = std::move(_frameQueues[i].front().frame);
+                _frameQueues[i].pop_front();
+                continue;
+            }
+
+            auto &queue = _frameQueues[i];
+            if (queue.empty()) {
+                continue;
+            }
+
+            auto &estimator = _estimators[i];
+            if (_relaxedChannels[i]) {
+                collectRelaxedFrameLocked(queue, estimator, refPts, frames[i]);
+                continue;
+            }
+
+            // 가장 가까운 PTS에 있는 프레임 찾기
+            auto bestMatch = queue.end();
+            double minDiff = std::numeric_limits<double>::max();
+            for (auto it = queue.begin(); it != queue.end(); ++it) {
+                const double diff = std::abs(estimator.correct(it->pts) - refPts);
+                if (diff < minDiff) {
+                    minDiff = diff;
+                    bestMatch = it;
+                }
+            }
+
+            // 허용 오차 내에서 최적 매치 탐색
+            const double window = getSyncWindowLocked(i);
+            if (minDiff <= window) {
+                estimator.addSample(refPts, bestMatch->pts);
+
+                // 최적 매치 된 프레임 설정하고 그 이전 프레임은 제거
+                frames[i] = std::move(bestMatch->frame);
+                queue.erase(queue.begin(), std::next(bestMatch));
+                continue;
+            }
+
+            // offset 이 window 보다 크면 매칭이 안 되므로 추정기가 가장 가까운 프레임으로 offset 을 다시 맞춤
+            if (estimator.addUnmatched(refPts, bestMatch->pts)) {
+                frames[i] = std::move(bestMatch->frame);
+                queue.erase(queue.begin(), std::next(bestMatch));
+                continue;
+            }
+
+            // 매칭 실패 시 마스터보다 뒤처진 프레임만 드랍하고, 앞선 프레임은 이후 매칭을 위해 유지 (타일은 이전 프레임 유지)
+            dropStaleFramesLocked(i, refPts - window);
+        }
+
+        return frames;
+    }
+
+    // 마스터 PTS 이전(허용 오차 포함)의 최신 프레임 사용, 없으면 이전 타일 유지
+    static void collectRelaxedFrameLocked(std::deque<SyncedFrame> &queue, const ClockDriftEstimator &estimator,
+                                          double refPts, VideoFrame &out) {
+        auto latest = queue.end();
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if (estimator.correct(it->pts) > refPts + MIN_INTER_CHANNEL_SYNC_WINDOW_SEC) {
+                break;
+            }
+            latest = it;
+        }
+
+        if (latest != queue.end()) {
+            out = std::move(latest->frame);
+            queue.erase(queue.begin(), std::next(latest));
+        }
+    }
+
+    void dropStaleFramesLocked(ChannelId channelId, double minPts) {
+        auto &queue = _frameQueues[channelId];
+        const auto &estimator = _estimators[channelId];
+
+        while (!queue.empty() && estimator.correct(queue.front().pts) < minPts) {
+            queue.pop_front();
+            _dropCount++;
+            if (_dropCount % 10 == 0) {
+                std::cerr << "[Sync] Dropped frame from channel " << channelId
+                          << " (behind master, offset: " << (estimator.getOffset() * 1000.0) << "ms, window: "
+                          << (getSyncWindowLocked(channelId) * 1000.0) << "ms)" << std::endl;
+            }
+        }
+    }
+
+    // 채널별 매칭 허용 오차: 추정 잔차 기반, 최대 마스터 프레임 간격의 절반 (수렴 전에는 최대값으로 탐색)
+    double getSyncWindowLocked(ChannelId channelId) const {
+        const double maxWindow = std::max(MIN_INTER_CHANNEL_SYNC_WINDOW_SEC, _masterFrameInterval * 0.5);
+        const auto &estimator = _estimators[channelId];
+        if (!estimator.isConverged()) {
+            return maxWindow;
+        }
+
+        const double window = MIN_INTER_CHANNEL_SYNC_WINDOW_SEC + SYNC_WINDOW_RESIDUAL_SCALE * estimator.getResidual();
+        return std::clamp(window, MIN_INTER_CHANNEL_SYNC_WINDOW_SEC, maxWindow);
+    }
+
+    void updateMasterFrameIntervalLocked(double refPts) {
+        if (_lastMasterPts >= 0.0) {
+            const double interval = refPts - _lastMasterPts;
+            if (interval > 0.0 && interval < 1.0) {
+                _masterFrameInterval = _masterFrameInterval * 0.9 + interval * 0.1;
+            }
+        }
+        _lastMasterPts = refPts;
+    }
+
     void syncLoop() {
         while (_running) {
-            auto frames = getSynchronizedFrames();
-            if (!_running) {
-                break;
+            {
+                // 출력 큐에 여유가 있을 때만 프레임 세트를 만들어 소비자(렌더 스레드)에 전달
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [this] {
+                    return !_running || (isReadyLocked() && _syncedSets.size() < MAX_SYNCED_SET_QUEUE_SIZE);
+                });
+                if (!_running) {
+                    break;
+                }
+
+                auto frames = collectSynchronizedFramesLocked();
+                if (!frames.empty()) {
+                    _syncedSets.push_back(std::move(frames));
+                }
             }
 
             static auto lastLogTime = std::chrono::steady_clock::now();
@@ -261,14 +431,17 @@ private:
                 }
 
                 double pts = _frameQueues[i].front().pts;
-                double diffMs = (pts - refPts) * 1000.0;
+                double diffMs = (_estimators[i].correct(pts) - refPts) * 1000.0;
+                double windowMs = getSyncWindowLocked(i) * 1000.0;
 
                 std::cout << "Channel " << i << ": "
                           << _frameQueues[i].size() << " frames, "
                           << "PTS: " << std::fixed << std::setprecision(6) << pts << "s, "
-                          << "Diff: " << std::setprecision(3) << diffMs << "ms "
+                          << "Diff: " << std::setprecision(3) << diffMs << "ms, "
+                          << "Offset: " << (_estimators[i].getOffset() * 1000.0) << "ms, "
+                          << "Skew: " << std::setprecision(1) << (_estimators[i].getSkew() * 1e6) << "ppm "
                           << (i == _masterChannel ? "(master)" : "")
-                          << (std::abs(diffMs) > MAX_INTER_CHANNEL_SYNC_MS * 1000.0 ? " [OUT OF SYNC]" : "")
+                          << (std::abs(diffMs) > windowMs ? " [OUT OF SYNC]" : "")
                           << std::endl;
             }
         }
@@ -281,6 +454,16 @@ private:
 
     // 각 채널 별 동기화 된 프레임을 저장하는 큐
     std::vector<std::deque<SyncedFrame>> _frameQueues;
+    std::vector<bool> _relaxedChannels;
+    std::vector<bool> _finishedChannels;
+
+    // 채널별 마스터 대비 offset/skew 추정
+    std::vector<ClockDriftEstimator> _estimators;
+    double _masterFrameInterval{1.0 / 30.0};
+    double _lastMasterPts{-1.0};
+
+    // 동기화 완료된 프레임 세트 (채널 순서)
+    std::deque<std::vector<VideoFrame>> _syncedSets;
 
     mutable std::mutex _mutex;
     std::condition_variable _cv;
@@ -2,13 +2,34 @@
 
 #include <vector>
 #include <cstdint>
+#include <memory>
 #include <utility>
 
+// 외부 메모리(예: 매핑된 PBO)에 저장된 프레임 픽셀
+class FrameBuffer {
+public:
+    virtual ~FrameBuffer() = default;
+
+    virtual uint8_t *data() = 0;
+
+    virtual size_t size() const = 0;
+};
+
 struct VideoFrame {
+    // 픽셀 배치 (YUV420P 는 Y, U, V 평면이 연속, 패딩 없음)
+    enum class PixelFormat {
+        RGB24,
+        RGBA,
+        YUV420P
+    };
+
     int width{0};
     int height{0};
     double pts{0.0};
+    PixelFormat format{PixelFormat::RGB24};
     std::vector<uint8_t> data;
+    // 설정된 경우 픽셀은 data 대신 buffer 에 저장
+    std::shared_ptr<FrameBuffer> buffer;
 
     VideoFrame() = default;
 
@@ -18,7 +39,9 @@ struct VideoFrame {
         : width(other.width),
           height(other.height),
           pts(other.pts),
-          data(std::move(other.data)) {
+          format(other.format),
+          data(std::move(other.data)),
+          buffer(std::move(other.buffer)) {
     }
 
     VideoFrame &operator=(VideoFrame &&other) noexcept {
@@ -26,7 +49,9 @@ struct VideoFrame {
             width = other.width;
             height = other.height;
             pts = other.pts;
+            format = other.format;
             data = std::move(other.data);
+            buffer = std::move(other.buffer);
         }
         return *this;
     }
@@ -42,11 +67,35 @@ struct VideoFrame {
               data(std::move(d)) {
     }
 
+    const uint8_t *pixels() const { return buffer ? buffer->data() : data.data(); }
+
+    uint8_t *pixels() { return buffer ? buffer->data() : data.data(); }
+
+    size_t pixelSize() const { return buffer ? buffer->size() : data.size(); }
+
+    bool empty() const { return pixelSize() == 0; }
+
+    // format 기준 픽셀 데이터 크기 (data 는 정렬 패딩으로 더 클 수 있음)
+    size_t frameSize() const {
+        const auto pixels = static_cast<size_t>(width) * height;
+        switch (format) {
+            case PixelFormat::RGBA:
+                return pixels * 4;
+            case PixelFormat::YUV420P:
+                return pixels * 3 / 2;
+            case PixelFormat::RGB24:
+            default:
+                return pixels * 3;
+        }
+    }
+
     void reset() {
         width = 0;
         height = 0;
         pts = 0.0;
+        format = PixelFormat::RGB24;
         data.clear();
         data.shrink_to_fit();
+        buffer.reset();
     }
 };
\ No newline at end of file
@@ -1,14 +1,9 @@
 #include "VideoRenderer.h"
 #include <stdexcept>
 
-VideoRenderer::VideoRenderer(GLFWwindow *win, int w, int h)
-        : _window(win),
-          _width(w),
+VideoRenderer::VideoRenderer(const int w, const int h)
+        : _width(w),
           _height(h) {
-    if (!_window) {
-        throw std::invalid_argument("GLFWwindow pointer is null");
-    }
-
     glGenTextures(1, &_texture);
     if (_texture == 0) {
         throw std::runtime_error("Failed to generate OpenGL _texture");
@@ -19,10 +14,14 @@ VideoRenderer::VideoRenderer(GLFWwindow *win, int w, int h)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (!initializeShaders()) {
+        throw std::runtime_error("Failed to initialize video shaders");
+    }
 
-    glViewport(0, 0, _width, _height);
-    glClearColor(0.f, 0.f, 0.f, 1.f);
+    _immutableStorage = isGLVersionAtLeast(4, 2) || hasGLExtension("GL_ARB_texture_storage");
+    _pixelBufferRing = std::make_shared<PixelBufferRing>();
 }
 
 VideoRenderer::~VideoRenderer() {
@@ -32,12 +31,17 @@ VideoRenderer::~VideoRenderer() {
 }
 
 VideoRenderer::VideoRenderer(VideoRenderer &&other) noexcept
-        : _window(other._window),
-          _texture(other._texture),
+        : _texture(other._texture),
           _width(other._width),
-          _height(other._height) {
+          _height(other._height),
+          _shaderProgram(std::move(other._shaderProgram)),
+          _pixelBufferRing(std::move(other._pixelBufferRing)),
+          _textureWidth(other._textureWidth),
+          _textureHeight(other._textureHeight),
+          _immutableStorage(other._immutableStorage),
+          _hasFrame(other._hasFrame) {
     other._texture = 0;
-    other._window = nullptr;
+    other._hasFrame = false;
 }
 
 VideoRenderer &VideoRenderer::operator=(VideoRenderer &&other) noexcept {
@@ -46,39 +50,134 @@ VideoRenderer &VideoRenderer::operator=(VideoRenderer &&other) noexcept {
             glDeleteTextures(1, &_texture);
         }
 
-        _window = other._window;
         _texture = other._texture;
         _width = other._width;
         _height = other._height;
+        _shaderProgram = std::move(other._shaderProgram);
+        _pixelBufferRing = std::move(other._pixelBufferRing);
+        _textureWidth = other._textureWidth;
+        _textureHeight = other._textureHeight;
+        _immutableStorage = other._immutableStorage;
+        _hasFrame = other._hasFrame;
 
         other._texture = 0;
-        other._window = nullptr;
+        other._hasFrame = false;
     }
     return *this;
 }
 
-void VideoRenderer::renderFrame(const VideoFrame &frame) const {
-    if (frame.data.empty()) {
+bool VideoRenderer::initializeShaders() {
+    _shaderProgram = std::make_unique<ShaderProgram>();
+
+    // letterbox: 영상/뷰포트 크기로 쿼드를 축소 (종횡비 유지)
+    // 디코더 프레임은 top-down 이므로 V 좌표를 뒤집어 샘플링
+    const auto vertexShaderSrc = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aTex;
+        uniform vec2 videoSize;
+        uniform vec2 viewportSize;
+        out vec2 TexCoord;
+        void main() {
+            float scale = min(viewportSize.x / videoSize.x, viewportSize.y / videoSize.y);
+            vec2 extent = videoSize * scale / viewportSize;
+            TexCoord = vec2(aTex.x, 1.0 - aTex.y);
+            gl_Position = vec4(aPos.xy * extent, 0.0, 1.0);
+        })";
+
+    const auto fragmentShaderSrc = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 TexCoord;
+        uniform sampler2D videoTexture;
+        void main() { FragColor = texture(videoTexture, TexCoord); })";
+
+    return _shaderProgram->loadVertexFragment(vertexShaderSrc, fragmentShaderSrc);
+}
+
+void VideoRenderer::prepareFrameSize(const int width, const int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    ensureTexture(width, height);
+    _pixelBufferRing->reserve(static_cast<size_t>(width) * height * 3);
+}
+
+std::shared_ptr<IFrameAllocator> VideoRenderer::getFrameAllocator() const {
+    if (!_pixelBufferRing || !_pixelBufferRing->isPersistent()) {
+        return nullptr;
+    }
+    return _pixelBufferRing;
+}
+
+void VideoRenderer::ensureTexture(const int width, const int height) {
+    if (width == _textureWidth && height == _textureHeight) {
+        return;
+    }
+
+    if (_immutableStorage) {
+        // immutable storage 는 크기 변경이 불가하므로 텍스처 재생성
+        glDeleteTextures(1, &_texture);
+        glGenTextures(1, &_texture);
+        glBindTexture(GL_TEXTURE_2D, _texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB8, width, height);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, _texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    _textureWidth = width;
+    _textureHeight = height;
+}
+
+void VideoRenderer::uploadFrame(const VideoFrame &frame) {
+    if (frame.empty()) {
         return;
     }
 
+    ensureTexture(frame.width, frame.height);
+
+    // 프레임 크기에 맞춰 PBO slot 확보 (사용 중인 slot 이 있으면 다음 프레임에 재시도)
+    const auto frameSize = static_cast<size_t>(frame.width) * frame.height * 3;
+    if (_pixelBufferRing->getSlotSize() < frameSize) {
+        _pixelBufferRing->reserve(frameSize);
+    }
+
     glBindTexture(GL_TEXTURE_2D, _texture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB,
-                 frame.width, frame.height, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, frame.data.data());
-
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.f, 1.f);
-    glVertex2f(-1.f, -1.f);
-    glTexCoord2f(1.f, 1.f);
-    glVertex2f(1.f, -1.f);
-    glTexCoord2f(1.f, 0.f);
-    glVertex2f(1.f, 1.f);
-    glTexCoord2f(0.f, 0.f);
-    glVertex2f(-1.f, 1.f);
-    glEnd();
-
-    glfwSwapBuffers(_window);
-}
\ No newline at end of file
+    _pixelBufferRing->upload(frame, GL_RGB);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    _hasFrame = true;
+}
+
+void VideoRenderer::render(const int x, const int y, const int width, const int height) const {
+    // 업로드가 없는 동안(일시정지 등)에도 GPU 사용이 끝난 slot 을 디코더가 다시 할당할 수 있게 회수
+    _pixelBufferRing->reclaim();
+
+    if (!_hasFrame || width <= 0 || height <= 0) {
+        return;
+    }
+
+    glViewport(x, y, width, height);
+
+    _shaderProgram->use();
+    _shaderProgram->setUniform2f("videoSize", static_cast<float>(_textureWidth), static_cast<float>(_textureHeight));
+    _shaderProgram->setUniform2f("viewportSize", static_cast<float>(width), static_cast<float>(height));
+    _shaderProgram->setUniform1i("videoTexture", 0);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    _shaderProgram->drawQuad();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+void VideoRenderer::clear() {
+    _hasFrame = false;
+}
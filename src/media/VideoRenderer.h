@@ -1,13 +1,17 @@
 #pragma once
 
 #include "../gl_common.h"
-#include <GLFW/glfw3.h>
+#include <memory>
 #include <stdexcept>
 #include "VideoFrame.h"
+#include "interface/IFrameAllocator.h"
+#include "../rendering/PixelBufferRing.h"
+#include "../rendering/ShaderProgram.h"
 
+// core profile 단일 패스 렌더러 (비디오 텍스처를 기본 프레임버퍼에 직접 그림)
 class VideoRenderer {
 public:
-    explicit VideoRenderer(GLFWwindow *win, int width, int height);
+    explicit VideoRenderer(int width, int height);
 
     ~VideoRenderer();
 
@@ -19,11 +23,35 @@ public:
 
     VideoRenderer &operator=(const VideoRenderer &) = delete;
 
-    void renderFrame(const VideoFrame &frame) const;
+    // 프레임을 비디오 텍스처로 업로드
+    void uploadFrame(const VideoFrame &frame);
+
+    // 현재 바인딩된 프레임버퍼의 (x, y, width, height) 영역에 letterbox 로 그림
+    void render(int x, int y, int width, int height) const;
+
+    // 표시 중인 프레임 해제 (다음 업로드 전까지 그리지 않음)
+    void clear();
+
+    // [GL] 프레임 크기에 맞춰 텍스처/PBO slot 을 미리 확보 (디코더 시작 전 호출)
+    void prepareFrameSize(int width, int height);
+
+    // 디코더가 변환 결과를 PBO 에 직접 기록하도록 전달할 할당자 (persistent mapping 미지원 시 nullptr)
+    std::shared_ptr<IFrameAllocator> getFrameAllocator() const;
 
 private:
-    GLFWwindow *_window{nullptr};
+    void ensureTexture(int width, int height);
+
+    bool initializeShaders();
+
     GLuint _texture{0};
     int _width{0};
     int _height{0};
+    std::unique_ptr<ShaderProgram> _shaderProgram;
+
+    // 텍스처 스트리밍 (immutable storage + PBO ring)
+    std::shared_ptr<PixelBufferRing> _pixelBufferRing;
+    int _textureWidth{0};
+    int _textureHeight{0};
+    bool _immutableStorage{false};
+    bool _hasFrame{false};
 };
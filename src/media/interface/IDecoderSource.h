@@ -15,11 +15,28 @@ public:
         CUDA
     };
 
+    // 채널별 디코딩 우선순위 (grid 에서 비활성 채널의 부하 감소)
+    enum class DecodePriority {
+        Full,           // 모든 프레임
+        ReducedFps,     // 비참조 프레임 제외
+        KeyframeOnly,   // 키프레임만
+        Disabled        // 비디오 디코딩 안 함 (다른 디코더가 비디오를 대신 출력하는 동안)
+    };
+
     struct DecoderConfig {
         DecoderType decoderType{DecoderType::SW};
         std::string hwDevice;
         bool enableLowLatency{false};
         int maxThreads{0};
+        DecodePriority priority{DecodePriority::Full};
+        bool realtimePacing{true};   // false: 오디오 시계 대기 없이 최대 속도로 출력 (headless 벤치마크)
+        bool enableAudio{true};      // false: 오디오 스트림 디코딩 안 함 (proxy 등 비디오 전용)
+        bool scanFrameTypes{true};   // false: 열 때 전체 패킷 I/P 스캔 생략 (색인을 따로 구성하는 경우)
+        bool liveTail{false};        // 기록 중인 fragmented MP4 를 파일 끝에서 대기하며 따라 읽음
+        double liveLatency{5.0};     // liveTail: 열 때 live edge 에서 이만큼(초) 뒤부터 재생
+        size_t readAheadBytes{16 * 1024 * 1024};  // 로컬 파일 read-ahead 버퍼 (0: libavformat 기본 파일 I/O)
+        int outputWidth{0};          // 표시 크기 힌트: 변환 단계에서 화면비를 유지하며 이 크기 안으로 축소 (0: 원본 해상도)
+        int outputHeight{0};
     };
 
 public:
@@ -33,6 +50,8 @@ public:
 
     virtual bool seek(double timeInSeconds) = 0;
 
+    virtual void setPriority(DecodePriority priority) = 0;
+
     virtual double getDuration() const = 0;
 
     virtual ThreadSafeQueue<VideoFrame> &getVideoQueue() = 0;
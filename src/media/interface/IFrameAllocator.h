@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include "media/VideoFrame.h"
+
+// 디코더가 변환 결과를 직접 기록할 프레임 버퍼 할당자 (예: 매핑된 PBO)
+class IFrameAllocator {
+public:
+    virtual ~IFrameAllocator() = default;
+
+    // size 바이트 버퍼 할당, 여유가 없으면 nullptr (호출자는 VideoFrame::data 사용)
+    virtual std::shared_ptr<FrameBuffer> allocate(size_t size) = 0;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <memory>
+#include "media/VideoFrame.h"
+
+// 디코딩된 원본 크기 비디오 프레임 수신자 (예: 재인코딩 녹화, 표시용 변환과 별개)
+class IFrameSink {
+public:
+    virtual ~IFrameSink() = default;
+
+    // [Convert strand] YUV420P, 디코딩 크기 그대로 (수신자는 핸들만 보관)
+    virtual void onFrame(std::shared_ptr<const VideoFrame> frame) = 0;
+};
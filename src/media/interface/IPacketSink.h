@@ -0,0 +1,25 @@
+#pragma once
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+// 패킷 tap 대상 스트림 정보 (디코더가 유효한 동안만 유효)
+struct PacketStreamInfo {
+    const AVCodecParameters *videoParams{nullptr};
+    AVRational videoTimeBase{0, 1};
+    const AVCodecParameters *audioParams{nullptr};
+    AVRational audioTimeBase{0, 1};
+};
+
+// 디먹스된 압축 패킷 수신자 (예: stream copy 녹화)
+class IPacketSink {
+public:
+    virtual ~IPacketSink() = default;
+
+    // [Decode thread] 호출 후 패킷은 재사용되므로 보관하려면 참조를 복제해야 함
+    virtual void onPacket(const AVPacket *packet, bool isVideo) = 0;
+
+    // pre-roll flush 로 한꺼번에 전달되는 패킷 (수신자가 큐 상한을 무시할 수 있음)
+    virtual void onBufferedPacket(const AVPacket *packet, const bool isVideo) { onPacket(packet, isVideo); }
+};
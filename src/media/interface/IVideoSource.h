@@ -2,10 +2,42 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "media/ThreadSafeQueue.h"
 #include "media/VideoFrame.h"
 #include "media/AudioFrame.h"
 #include "media/CodecInfo.h"
+#include "media/PacketRing.h"
+#include "threads/EncodeThread.h"
+
+enum class RecordMode {
+    Transcode,      // 디코딩 프레임(원본 크기)을 H.264 로 재인코딩
+    Passthrough     // 디먹스된 패킷을 그대로 remux (재인코딩 없음)
+};
+
+// 원본과 함께 기록할 저해상도 rendition (검토/스크러빙용 proxy)
+struct RenditionConfig {
+    std::string name{"proxy_360p"};     // 세션 디렉터리 하위 폴더 (proxy_ 로 시작하면 재생 시 proxy 로 사용)
+    int height{360};
+    EncoderConfig encoder{"veryfast", 28, 800000};
+};
+
+struct RecordOptions {
+    RecordMode mode{RecordMode::Transcode};
+    // 기록 중인 세그먼트를 바로 검토(loadLive)할 수 있도록 fragmented MP4 가 기본
+    Encoder::OutputFormat container{Encoder::OutputFormat::FragmentedMP4};
+    EncoderConfig encoder;          // Transcode 에서만 사용
+    std::vector<RenditionConfig> renditions;    // Transcode 에서만 사용, 같은 디코딩 프레임에서 함께 인코딩
+    EncodeThread::Config encodeQueue;
+    PreRecordConfig preRecord;      // Passthrough 에서만 사용 (압축 패킷 보관)
+    Encoder::SegmentClosedCallback onSegmentClosed;     // 세그먼트 파일이 닫힐 때마다 (예: 보관 정책 등록)
+};
+
+// 재생 상태 (소스가 디코딩 방식을 조정하는 데 사용)
+struct PlaybackHint {
+    bool playing{false};
+    double speed{1.0};
+};
 
 class IVideoSource {
 public:
@@ -15,14 +47,23 @@ public:
 
     virtual void stop() = 0;
 
-    virtual void startRecord() = 0;
+    virtual void startRecord(const RecordOptions &options) = 0;
 
     virtual void stopRecord() = 0;
 
+    // 녹화 시작 전 구간 보관 설정 (seconds 0 이면 해제, 녹화 중에는 무시)
+    virtual void setPreRecord(const PreRecordConfig &config) = 0;
+
     virtual void flush() = 0;
 
     virtual bool seek(double timeInSeconds) = 0;
 
+    // [Main thread] 매 update 마다 현재 재생 상태 전달
+    virtual void setPlaybackHint(const PlaybackHint &hint) = 0;
+
+    // 표시(또는 타일) 크기 - 디코더 변환 단계에서 이 크기로 축소 (0 이면 원본 해상도)
+    virtual void setOutputSize(int width, int height) = 0;
+
     virtual double getDuration() const = 0;
 
     virtual CodecInfo getCodecInfo() const = 0;
@@ -31,7 +72,8 @@ public:
 
     virtual ThreadSafeQueue<AudioFrame> &getAudioQueue() = 0;
 
-    virtual void encodeFrame(const VideoFrame &frame) = 0;
+    // 현재/마지막 녹화에서 큐 overflow 로 버려진 프레임(Passthrough 는 패킷) 수
+    virtual uint64_t getDroppedRecordFrames() const = 0;
 
     virtual std::vector<double> getIFrameTimestamps() const = 0;
 
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "../gl_common.h"
+#include "GridRenderer.h"
+
+GridRenderer::GridRenderer() = default;
+
+GridRenderer::~GridRenderer() {
+    releaseTiles();
+}
+
+bool GridRenderer::initialize() {
+    _shaderProgram = std::make_unique<ShaderProgram>();
+
+    // 디코더 프레임은 top-down 이므로 V 좌표를 뒤집어 샘플링
+    const auto vertexShaderSrc = R"(
+        #version 330 core
+        layout (location = 0) in vec2 aPos;
+        layout (location = 1) in vec2 aTex;
+        out vec2 TexCoord;
+        void main() {
+            TexCoord = vec2(aTex.x, 1.0 - aTex.y);
+            gl_Position = vec4(aPos.xy, 0.0, 1.0);
+        })";
+
+    const auto fragmentShaderSrc = R"(
+        #version 330 core
+        out vec4 FragColor;
+        in vec2 TexCoord;
+        uniform sampler2D tileTexture;
+        void main() { FragColor = texture(tileTexture, TexCoord); })";
+
+    if (!_shaderProgram->loadVertexFragment(vertexShaderSrc, fragmentShaderSrc)) {
+        std::cerr << "Failed to initialize grid shaders\n";
+        return false;
+    }
+
+    _immutableStorage = isGLVersionAtLeast(4, 2) || hasGLExtension("GL_ARB_texture_storage");
+    return true;
+}
+
+void GridRenderer::setChannelCount(const size_t count) {
+    releaseTiles();
+
+    _tiles.resize(count);
+    for (auto &tile: _tiles) {
+        createTileTexture(tile);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // 정사각형에 가까운 배치 (4 -> 2x2, 9 -> 3x3, 16 -> 4x4)
+    _columns = std::max<size_t>(1, static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    _rows = std::max<size_t>(1, (count + _columns - 1) / _columns);
+}
+
+void GridRenderer::updateTile(const size_t index, const VideoFrame &frame) {
+    if (index >= _tiles.size() || frame.empty()) {
+        return;
+    }
+
+    auto &tile = _tiles[index];
+    glBindTexture(GL_TEXTURE_2D, tile.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (tile.width != frame.width || tile.height != frame.height) {
+        if (_immutableStorage) {
+            // immutable storage 는 크기 변경이 불가하므로 텍스처 재생성
+            glDeleteTextures(1, &tile.texture);
+            createTileTexture(tile);
+            glBindTexture(GL_TEXTURE_2D, tile.texture);
+            glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB8, frame.width, frame.height);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, frame.width, frame.height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        }
+        tile.width = frame.width;
+        tile.height = frame.height;
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frame.width, frame.height, GL_RGB, GL_UNSIGNED_BYTE, frame.pixels());
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GridRenderer::render(const int originX, const int originY, const int width, const int height) const {
+    if (_tiles.empty() || !_shaderProgram) {
+        return;
+    }
+
+    const int cellWidth = width / static_cast<int>(_columns);
+    const int cellHeight = height / static_cast<int>(_rows);
+
+    _shaderProgram->use();
+    _shaderProgram->setUniform1i("tileTexture", 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    for (size_t i = 0; i < _tiles.size(); ++i) {
+        const auto &tile = _tiles[i];
+        if (tile.width <= 0 || tile.height <= 0) {
+            continue;
+        }
+
+        const int column = static_cast<int>(i % _columns);
+        const int row = static_cast<int>(i / _columns);
+
+        // 타일 내부 letterbox (종횡비 유지)
+        const double scale = std::min(static_cast<double>(cellWidth) / tile.width,
+                                      static_cast<double>(cellHeight) / tile.height);
+        const int drawWidth = static_cast<int>(tile.width * scale);
+        const int drawHeight = static_cast<int>(tile.height * scale);
+        const int x = originX + column * cellWidth + (cellWidth - drawWidth) / 2;
+        const int y = originY + height - (row + 1) * cellHeight + (cellHeight - drawHeight) / 2;
+
+        glViewport(x, y, drawWidth, drawHeight);
+        glBindTexture(GL_TEXTURE_2D, tile.texture);
+        _shaderProgram->drawQuad();
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+}
+
+int GridRenderer::tileAt(const double x, const double y, const int width, const int height) const {
+    if (_tiles.empty() || width <= 0 || height <= 0 || x < 0 || y < 0 || x >= width || y >= height) {
+        return -1;
+    }
+
+    const auto column = static_cast<size_t>(x / (static_cast<double>(width) / _columns));
+    const auto row = static_cast<size_t>(y / (static_cast<double>(height) / _rows));
+    const size_t index = row * _columns + column;
+    return index < _tiles.size() ? static_cast<int>(index) : -1;
+}
+
+void GridRenderer::createTileTexture(Tile &tile) {
+    glGenTextures(1, &tile.texture);
+    glBindTexture(GL_TEXTURE_2D, tile.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GridRenderer::releaseTiles() {
+    for (auto &tile: _tiles) {
+        if (tile.texture != 0) {
+            glDeleteTextures(1, &tile.texture);
+        }
+    }
+    _tiles.clear();
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../gl_common.h"
+#include <memory>
+#include <vector>
+#include "ShaderProgram.h"
+#include "../media/VideoFrame.h"
+
+// N개 채널을 타일(grid) 형태로 하나의 렌더 패스에 합성
+class GridRenderer {
+public:
+    GridRenderer();
+
+    ~GridRenderer();
+
+    GridRenderer(const GridRenderer &) = delete;
+
+    GridRenderer &operator=(const GridRenderer &) = delete;
+
+    bool initialize();
+
+    void setChannelCount(size_t count);
+
+    size_t getChannelCount() const { return _tiles.size(); }
+
+    size_t getColumns() const { return _columns; }
+
+    size_t getRows() const { return _rows; }
+
+    // 채널 프레임을 타일 텍스처로 업로드
+    void updateTile(size_t index, const VideoFrame &frame);
+
+    // 현재 바인딩된 framebuffer의 (originX, originY, width, height) 영역에 모든 타일을 그림
+    void render(int originX, int originY, int width, int height) const;
+
+    // 출력 좌표(좌상단 기준)에 해당하는 타일 인덱스, 없으면 -1
+    int tileAt(double x, double y, int width, int height) const;
+
+private:
+    struct Tile {
+        GLuint texture{0};
+        int width{0};
+        int height{0};
+    };
+
+    static void createTileTexture(Tile &tile);
+
+    void releaseTiles();
+
+    std::unique_ptr<ShaderProgram> _shaderProgram;
+    std::vector<Tile> _tiles;
+    size_t _columns{1};
+    size_t _rows{1};
+    bool _immutableStorage{false};
+};
@@ -0,0 +1,132 @@
+#include "HeadlessContext.h"
+#include <EGL/eglext.h>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+    bool hasClientExtension(const char *name) {
+        const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        return extensions && std::strstr(extensions, name) != nullptr;
+    }
+}
+
+HeadlessContext::~HeadlessContext() {
+    release();
+}
+
+bool HeadlessContext::initialize() {
+    if (!openDisplay()) {
+        std::cerr << "Failed to open EGL display\n";
+        return false;
+    }
+
+    EGLint major = 0;
+    EGLint minor = 0;
+    if (!eglInitialize(_display, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL\n";
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL does not support desktop OpenGL\n";
+        release();
+        return false;
+    }
+
+    const EGLint configAttributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(_display, configAttributes, &config, 1, &numConfigs) || numConfigs == 0) {
+        std::cerr << "No suitable EGL config\n";
+        release();
+        return false;
+    }
+
+    // 창 모드와 동일한 3.3 core 프로파일 (렌더러 셰이더가 GLSL 330 core)
+    const EGLint contextAttributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+    };
+
+    _context = eglCreateContext(_display, config, EGL_NO_CONTEXT, contextAttributes);
+    if (_context == EGL_NO_CONTEXT) {
+        std::cerr << "Failed to create EGL context\n";
+        release();
+        return false;
+    }
+
+    // surfaceless (EGL_KHR_surfaceless_context)
+    if (!eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context)) {
+        std::cerr << "Failed to make EGL context current\n";
+        release();
+        return false;
+    }
+
+    std::cout << "Headless EGL " << major << "." << minor << " context created\n";
+    return true;
+}
+
+void HeadlessContext::makeCurrent() const {
+    if (_context != EGL_NO_CONTEXT) {
+        eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context);
+    }
+}
+
+bool HeadlessContext::openDisplay() {
+    if (hasClientExtension("EGL_EXT_platform_base")) {
+        const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        // Mesa (llvmpipe, 컨테이너 환경 포함)
+        if (getPlatformDisplay && hasClientExtension("EGL_MESA_platform_surfaceless")) {
+            _display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (_display != EGL_NO_DISPLAY) {
+                return true;
+            }
+        }
+
+        // GPU 드라이버 (NVIDIA 등) - 첫 번째 device 사용
+        const auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(
+                eglGetProcAddress("eglQueryDevicesEXT"));
+        if (getPlatformDisplay && queryDevices && hasClientExtension("EGL_EXT_platform_device")) {
+            EGLint count = 0;
+            if (queryDevices(0, nullptr, &count) && count > 0) {
+                std::vector<EGLDeviceEXT> devices(count);
+                queryDevices(count, devices.data(), &count);
+                _display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices.front(), nullptr);
+                if (_display != EGL_NO_DISPLAY) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    return _display != EGL_NO_DISPLAY;
+}
+
+void HeadlessContext::release() {
+    if (_display == EGL_NO_DISPLAY) {
+        return;
+    }
+
+    eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (_context != EGL_NO_CONTEXT) {
+        eglDestroyContext(_display, _context);
+        _context = EGL_NO_CONTEXT;
+    }
+
+    eglTerminate(_display);
+    _display = EGL_NO_DISPLAY;
+}
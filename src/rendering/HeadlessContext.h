@@ -0,0 +1,29 @@
+#pragma once
+
+#include <EGL/egl.h>
+
+// 디스플레이 없이 사용하는 EGL OpenGL 3.3 core 컨텍스트 (surfaceless)
+// - Mesa surfaceless 플랫폼 -> EGL device (GPU 직접) -> 기본 디스플레이 순으로 시도
+// - 기본 프레임버퍼가 없으므로 렌더링은 FBO 로 수행
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+
+    ~HeadlessContext();
+
+    HeadlessContext(const HeadlessContext &) = delete;
+
+    HeadlessContext &operator=(const HeadlessContext &) = delete;
+
+    bool initialize();
+
+    void makeCurrent() const;
+
+private:
+    bool openDisplay();
+
+    void release();
+
+    EGLDisplay _display{EGL_NO_DISPLAY};
+    EGLContext _context{EGL_NO_CONTEXT};
+};
@@ -0,0 +1,301 @@
+#include "PixelBufferRing.h"
+#include <algorithm>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+class PixelBufferRing::SlotBuffer final : public FrameBuffer {
+public:
+    SlotBuffer(std::shared_ptr<SharedState> state, const size_t index, uint8_t *data, const size_t size)
+            : _state(std::move(state)), _generation(_state->generation), _index(index), _data(data), _size(size) {
+    }
+
+    ~SlotBuffer() override {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        if (_generation == _state->generation) {
+            if (_index < _state->slots.size()) {
+                _state->slots[_index].held = false;
+            }
+            return;
+        }
+
+        // 재생성 전 slot 은 GL 스레드의 reclaim 에서 삭제
+        for (auto &retired: _state->retired) {
+            if (retired.generation == _generation && retired.index == _index) {
+                retired.slot.held = false;
+                break;
+            }
+        }
+    }
+
+    uint8_t *data() override { return _data; }
+
+    size_t size() const override { return _size; }
+
+    const SharedState *owner() const { return _state.get(); }
+
+    uint64_t generation() const { return _generation; }
+
+    size_t index() const { return _index; }
+
+private:
+    std::shared_ptr<SharedState> _state;
+    uint64_t _generation;
+    size_t _index;
+    uint8_t *_data;
+    size_t _size;
+};
+
+PixelBufferRing::PixelBufferRing(const size_t slotCount)
+        : _slotCount(slotCount), _state(std::make_shared<SharedState>()) {
+}
+
+PixelBufferRing::~PixelBufferRing() {
+    releaseBuffers();
+
+    // 남은 프레임이 매핑에 기록할 수 있으므로 사용 중인 slot 은 컨텍스트 종료 시 정리
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    std::erase_if(_state->retired, [](RetiredSlot &retired) {
+        if (retired.slot.held) {
+            spdlog::warn("Pixel buffer slot still in use while destroying ring");
+            return false;
+        }
+        deleteSlot(retired.slot);
+        return true;
+    });
+}
+
+bool PixelBufferRing::reserve(const size_t slotSize) {
+    reclaim();
+
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        if (_state->slotSize >= slotSize) {
+            return true;
+        }
+
+        for (const auto &slot: _state->slots) {
+            if (slot.held) {
+                return false;
+            }
+        }
+    }
+
+    releaseBuffers();
+
+    if (supportsBufferStorage() && createBuffers(slotSize, true)) {
+        return true;
+    }
+    return createBuffers(slotSize, false);
+}
+
+void PixelBufferRing::upload(const VideoFrame &frame, const GLenum format) {
+    if (frame.empty()) {
+        return;
+    }
+
+    reclaim();
+
+    const auto size = static_cast<size_t>(frame.width) * frame.height * 3;
+    int index = findSlot(frame.buffer.get());
+    const bool copied = (index < 0);
+    if (copied) {
+        // 일반 메모리 프레임: 여유 slot 에 복사 후 비동기 업로드
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        if (size <= _state->slotSize) {
+            index = acquireSlotLocked(*_state);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (index < 0) {
+        // slot 이 없으면 동기 업로드
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frame.width, frame.height, format, GL_UNSIGNED_BYTE, frame.pixels());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        return;
+    }
+
+    auto &slot = _state->slots[index];
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+
+    if (copied) {
+        if (_persistent) {
+            std::memcpy(slot.mapped, frame.pixels(), size);
+        } else {
+            // 기존 내용을 버리고 매핑 (GPU 사용 중인 버퍼와 동기화하지 않음)
+            void *mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+                                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (mapped) {
+                std::memcpy(mapped, frame.pixels(), size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+        }
+    }
+
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, frame.width, frame.height, format, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (slot.fence) {
+        glDeleteSync(slot.fence);
+    }
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (copied) {
+        slot.held = false;
+    }
+}
+
+void PixelBufferRing::reclaim() {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+
+    // 프레임이 모두 놓아준 이전 slot 해제
+    std::erase_if(_state->retired, [](RetiredSlot &retired) {
+        if (retired.slot.held) {
+            return false;
+        }
+        deleteSlot(retired.slot);
+        return true;
+    });
+
+    for (auto &slot: _state->slots) {
+        if (!slot.fence) {
+            continue;
+        }
+
+        const auto result = glClientWaitSync(slot.fence, 0, 0);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+    }
+}
+
+size_t PixelBufferRing::getSlotSize() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->slotSize;
+}
+
+std::shared_ptr<FrameBuffer> PixelBufferRing::allocate(const size_t size) {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (!_state->accepting || size > _state->slotSize) {
+        return nullptr;
+    }
+
+    const int index = acquireSlotLocked(*_state);
+    if (index < 0) {
+        return nullptr;
+    }
+    return std::make_shared<SlotBuffer>(_state, static_cast<size_t>(index), _state->slots[index].mapped, size);
+}
+
+bool PixelBufferRing::createBuffers(const size_t slotSize, const bool persistent) {
+    constexpr GLbitfield persistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    std::vector<Slot> slots(_slotCount);
+    for (auto &slot: slots) {
+        glGenBuffers(1, &slot.buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+
+        if (persistent) {
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(slotSize), nullptr,
+                            persistentFlags | GL_CLIENT_STORAGE_BIT);
+            slot.mapped = static_cast<uint8_t *>(
+                    glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(slotSize), persistentFlags));
+        } else {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(slotSize), nullptr, GL_STREAM_DRAW);
+        }
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    const bool mapped = !persistent || std::all_of(slots.begin(), slots.end(),
+                                                   [](const Slot &slot) { return slot.mapped != nullptr; });
+
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->slots = std::move(slots);
+        _state->slotSize = slotSize;
+        _state->nextSlot = 0;
+        _state->accepting = persistent && mapped;
+    }
+
+    if (!mapped) {
+        spdlog::warn("Failed to map persistent pixel buffers; falling back to streamed uploads");
+        releaseBuffers();
+        return false;
+    }
+
+    _persistent = persistent;
+    spdlog::info("Pixel buffer ring: {} x {} bytes ({})", _slotCount, slotSize,
+                 persistent ? "persistent mapped" : "streamed");
+    return true;
+}
+
+void PixelBufferRing::releaseBuffers() {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->accepting = false;
+
+    for (size_t i = 0; i < _state->slots.size(); ++i) {
+        auto &slot = _state->slots[i];
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+
+        // 아직 프레임이 사용 중인 매핑은 핸들이 모두 해제된 뒤 reclaim 에서 삭제
+        if (slot.held) {
+            _state->retired.push_back({_state->generation, i, slot});
+            continue;
+        }
+        deleteSlot(slot);
+    }
+
+    _state->slots.clear();
+    _state->slotSize = 0;
+    ++_state->generation;
+    _persistent = false;
+}
+
+void PixelBufferRing::deleteSlot(Slot &slot) {
+    if (slot.fence) {
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+    if (slot.mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slot.mapped = nullptr;
+    }
+    if (slot.buffer != 0) {
+        glDeleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+    }
+}
+
+int PixelBufferRing::acquireSlotLocked(SharedState &state) {
+    // 순환 순서로 탐색하여 최근 업로드된 slot 의 fence 가 완료될 시간을 확보
+    for (size_t i = 0; i < state.slots.size(); ++i) {
+        const size_t index = (state.nextSlot + i) % state.slots.size();
+        auto &slot = state.slots[index];
+        if (!slot.held && !slot.fence) {
+            slot.held = true;
+            state.nextSlot = (index + 1) % state.slots.size();
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+
+int PixelBufferRing::findSlot(const FrameBuffer *buffer) const {
+    const auto *slotBuffer = dynamic_cast<const SlotBuffer *>(buffer);
+    // 재생성 전 slot 의 프레임은 일반 메모리 프레임처럼 복사 경로로 업로드
+    if (!slotBuffer || slotBuffer->owner() != _state.get() || slotBuffer->generation() != _state->generation) {
+        return -1;
+    }
+    return static_cast<int>(slotBuffer->index());
+}
+
+bool PixelBufferRing::supportsBufferStorage() {
+    return isGLVersionAtLeast(4, 4) || hasGLExtension("GL_ARB_buffer_storage");
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../gl_common.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../media/VideoFrame.h"
+#include "../media/interface/IFrameAllocator.h"
+
+// 텍스처 스트리밍용 PBO ring
+// - ARB_buffer_storage 지원 시 persistent mapping 으로 디코더가 slot 에 직접 기록 (IFrameAllocator)
+// - 업로드마다 fence 를 두고 GPU 사용이 끝난 slot 만 재사용
+class PixelBufferRing final : public IFrameAllocator {
+public:
+    explicit PixelBufferRing(size_t slotCount = DEFAULT_SLOT_COUNT);
+
+    ~PixelBufferRing() override;
+
+    PixelBufferRing(const PixelBufferRing &) = delete;
+
+    PixelBufferRing &operator=(const PixelBufferRing &) = delete;
+
+    // [GL] slot 크기 확보 (사용 중인 slot 이 없을 때만 재생성)
+    bool reserve(size_t slotSize);
+
+    // [GL] 현재 바인딩된 GL_TEXTURE_2D 로 프레임 업로드 (glTexSubImage2D)
+    void upload(const VideoFrame &frame, GLenum format);
+
+    // [GL] fence 가 완료된 slot 회수, 재생성 전 slot 중 프레임이 놓아준 버퍼 해제
+    // allocate 는 GL 컨텍스트가 없는 디코더 스레드에서 호출되므로 렌더링 프레임마다 여기서 fence 확인
+    void reclaim();
+
+    bool isPersistent() const { return _persistent; }
+
+    size_t getSlotSize() const;
+
+    // [Any] persistent mapping 일 때만 할당, 여유 slot 이 없으면 nullptr
+    std::shared_ptr<FrameBuffer> allocate(size_t size) override;
+
+    static constexpr size_t DEFAULT_SLOT_COUNT = 6;
+
+private:
+    struct Slot {
+        GLuint buffer{0};
+        uint8_t *mapped{nullptr};
+        GLsync fence{nullptr};
+        bool held{false};   // 프레임(디코더/큐)이 사용 중
+    };
+
+    // 재생성(releaseBuffers) 시 프레임이 사용 중이던 slot - 마지막 핸들이 해제되면 GL 스레드에서 삭제
+    struct RetiredSlot {
+        uint64_t generation{0};
+        size_t index{0};
+        Slot slot;
+    };
+
+    // 할당된 버퍼가 ring 보다 오래 남을 수 있으므로 공유 상태로 분리
+    struct SharedState {
+        std::mutex mutex;
+        std::vector<Slot> slots;
+        std::vector<RetiredSlot> retired;
+        uint64_t generation{0};     // slots 를 새로 만들 때마다 증가 (이전 slot 핸들 구분)
+        size_t slotSize{0};
+        size_t nextSlot{0};
+        bool accepting{false};
+    };
+
+    class SlotBuffer;
+
+    bool createBuffers(size_t slotSize, bool persistent);
+
+    void releaseBuffers();
+
+    static int acquireSlotLocked(SharedState &state);
+
+    // [GL] slot 의 매핑과 버퍼 삭제
+    static void deleteSlot(Slot &slot);
+
+    int findSlot(const FrameBuffer *buffer) const;
+
+    static bool supportsBufferStorage();
+
+    const size_t _slotCount;
+    std::shared_ptr<SharedState> _state;
+    bool _persistent{false};
+};
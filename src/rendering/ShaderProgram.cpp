@@ -13,8 +13,8 @@ ShaderProgram::~ShaderProgram() {
         glDeleteVertexArrays(1, &_vao);
     }
 
-    if (_ebo) {
-        glDeleteBuffers(1, &_ebo);
+    if (_vbo) {
+        glDeleteBuffers(1, &_vbo);
     }
 
     if (_ebo) {
@@ -97,6 +97,10 @@ void ShaderProgram::setUniform1i(const std::string &name, const int value) const
     glUniform1i(glGetUniformLocation(_program, name.c_str()), value);
 }
 
+void ShaderProgram::setUniform2f(const std::string &name, const float x, const float y) const {
+    glUniform2f(glGetUniformLocation(_program, name.c_str()), x, y);
+}
+
 void ShaderProgram::drawQuad() const {
     glBindVertexArray(_vao);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
@@ -14,6 +14,8 @@ public:
 
     void setUniform1i(const std::string &name, int value) const;
 
+    void setUniform2f(const std::string &name, float x, float y) const;
+
     void drawQuad() const;
 
     GLuint getProgram() const { return _program; }
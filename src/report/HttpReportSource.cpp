@@ -154,6 +154,18 @@ std::string IReportSource::buildStatusJson(const std::vector<ChannelStatus> &cha
         web::json::value syncObj;
         syncObj[U("max_offset_ms")] = syncStatus.max_offset_ms;
         syncObj[U("locked")] = syncStatus.locked;
+
+        web::json::value offsetArray = web::json::value::array();
+        for (size_t i = 0; i < syncStatus.channel_offsets.size(); ++i) {
+            const auto &channelOffset = syncStatus.channel_offsets[i];
+            web::json::value offsetObj;
+            offsetObj[U("id")] = channelOffset.id;
+            offsetObj[U("offset_ms")] = channelOffset.offset_ms;
+            offsetObj[U("drift_ppm")] = channelOffset.drift_ppm;
+            offsetObj[U("window_ms")] = channelOffset.window_ms;
+            offsetArray[i] = offsetObj;
+        }
+        syncObj[U("channel_offsets")] = offsetArray;
         return syncObj;
     };
 
@@ -10,9 +10,17 @@ struct ChannelStatus {
     int queue_length;
 };
 
+struct ChannelSyncOffset {
+    int id;
+    double offset_ms;
+    double drift_ppm;
+    double window_ms;
+};
+
 struct SyncStatus {
     double max_offset_ms;
     bool locked;
+    std::vector<ChannelSyncOffset> channel_offsets;
 };
 
 struct SensorStatus {
@@ -0,0 +1,325 @@
+#include "DecodeExecutor.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+DecodeExecutor::Strand::Strand(DecodeExecutor &executor, std::function<Step()> step)
+        : _executor(executor), _step(std::move(step)) {
+}
+
+DecodeExecutor::Strand::~Strand() {
+    if (_thread.joinable()) {
+        cancel();
+    }
+}
+
+void DecodeExecutor::Strand::schedule() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_cancelled) {
+            return;
+        }
+
+        if (_thread.joinable()) {
+            if (_state == State::Running) {
+                _wakeRequested = true;
+            } else {
+                _state = State::Queued;
+                _cv.notify_all();
+            }
+            return;
+        }
+
+        switch (_state) {
+            case State::Idle:
+                break;
+            case State::Timed:
+                // 대기 중인 타이머는 무효화하고 즉시 실행
+                ++_timerGeneration;
+                break;
+            case State::Running:
+                _wakeRequested = true;
+                return;
+            case State::Queued:
+                return;
+        }
+        _state = State::Queued;
+    }
+
+    _executor.enqueue(shared_from_this(), _executor._nextWorker.fetch_add(1) % _executor.getThreadCount());
+}
+
+void DecodeExecutor::Strand::cancel() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cancelled = true;
+    _cv.notify_all();
+    _cv.wait(lock, [this] { return _state != State::Running; });
+    _state = State::Idle;
+    lock.unlock();
+
+    if (_thread.joinable() && _thread.get_id() != std::this_thread::get_id()) {
+        _thread.join();
+    }
+}
+
+void DecodeExecutor::Strand::threadLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_cancelled) {
+        if (_state == State::Idle) {
+            _cv.wait(lock);
+            continue;
+        }
+        if (_state == State::Timed && Clock::now() < _notBefore) {
+            _cv.wait_until(lock, _notBefore);
+            continue;
+        }
+
+        _state = State::Running;
+        lock.unlock();
+
+        auto step = Step::idle();
+        try {
+            step = _step();
+        } catch (const std::exception &e) {
+            spdlog::error("Decode task failed: {}", e.what());
+        }
+
+        lock.lock();
+        if (_wakeRequested) {
+            _wakeRequested = false;
+            step = Step::next();
+        }
+
+        switch (step.kind) {
+            case Step::Kind::Continue:
+                _state = State::Queued;
+                break;
+            case Step::Kind::Wait:
+                _state = State::Timed;
+                _notBefore = step.notBefore;
+                break;
+            case Step::Kind::Idle:
+                _state = State::Idle;
+                break;
+        }
+        _cv.notify_all();
+    }
+}
+
+bool DecodeExecutor::Strand::isCancelled() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cancelled;
+}
+
+DecodeExecutor &DecodeExecutor::instance() {
+    static DecodeExecutor executor(std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+}
+
+DecodeExecutor::DecodeExecutor(const size_t threadCount) {
+    for (size_t i = 0; i < threadCount; ++i) {
+        _workers.push_back(std::make_unique<Worker>());
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        _workers[i]->thread = std::thread(&DecodeExecutor::workerLoop, this, i);
+    }
+
+    spdlog::info("Decode executor started with {} threads", threadCount);
+}
+
+DecodeExecutor::~DecodeExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _running = false;
+    }
+    _sleepCv.notify_all();
+
+    for (const auto &worker: _workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+std::shared_ptr<DecodeExecutor::Strand> DecodeExecutor::createStrand(std::function<Step()> step) {
+    return std::shared_ptr<Strand>(new Strand(*this, std::move(step)));
+}
+
+std::shared_ptr<DecodeExecutor::Strand> DecodeExecutor::createDedicatedStrand(std::function<Step()> step) {
+    auto strand = std::shared_ptr<Strand>(new Strand(*this, std::move(step)));
+    strand->_thread = std::thread(&Strand::threadLoop, strand.get());
+    return strand;
+}
+
+int DecodeExecutor::getCodecThreadLimit(const int requested) const {
+    // 자동(0)이면 코덱 내부 스레드 없이 풀에서만 병렬 처리
+    if (requested <= 0) {
+        return 1;
+    }
+    return std::min(requested, static_cast<int>(_workers.size()));
+}
+
+void DecodeExecutor::workerLoop(const size_t index) {
+    while (_running.load()) {
+        auto strand = popLocal(index);
+        if (!strand) {
+            strand = steal(index);
+        }
+        if (!strand) {
+            strand = popDueTimer();
+        }
+
+        if (strand) {
+            run(strand, index);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        if (!_running.load() || _pending.load() > 0) {
+            continue;
+        }
+
+        if (_timers.empty()) {
+            _sleepCv.wait(lock);
+        } else if (_timers.begin()->first > Clock::now()) {
+            _sleepCv.wait_until(lock, _timers.begin()->first);
+        }
+    }
+}
+
+void DecodeExecutor::enqueue(std::shared_ptr<Strand> strand, const size_t worker) {
+    {
+        std::lock_guard<std::mutex> lock(_workers[worker]->mutex);
+        _workers[worker]->queue.push_back(std::move(strand));
+    }
+    _pending.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _sleepCv.notify_one();
+}
+
+void DecodeExecutor::enqueueTimer(std::shared_ptr<Strand> strand, const Clock::time_point time,
+                                  const uint64_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _timers.emplace(time, TimerEntry{std::move(strand), generation});
+    }
+    // 가장 이른 타이머가 바뀌었을 수 있으므로 대기 중인 워커를 깨움
+    _sleepCv.notify_one();
+}
+
+std::shared_ptr<DecodeExecutor::Strand> DecodeExecutor::popLocal(const size_t index) {
+    auto &worker = *_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.queue.empty()) {
+        return nullptr;
+    }
+
+    auto strand = std::move(worker.queue.front());
+    worker.queue.pop_front();
+    _pending.fetch_sub(1);
+    return strand;
+}
+
+std::shared_ptr<DecodeExecutor::Strand> DecodeExecutor::steal(const size_t thief) {
+    for (size_t offset = 1; offset < _workers.size(); ++offset) {
+        auto &victim = *_workers[(thief + offset) % _workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.queue.empty()) {
+            continue;
+        }
+
+        auto strand = std::move(victim.queue.back());
+        victim.queue.pop_back();
+        _pending.fetch_sub(1);
+        return strand;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<DecodeExecutor::Strand> DecodeExecutor::popDueTimer() {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+
+    while (!_timers.empty() && _timers.begin()->first <= Clock::now()) {
+        auto entry = std::move(_timers.begin()->second);
+        _timers.erase(_timers.begin());
+
+        std::lock_guard<std::mutex> strandLock(entry.strand->_mutex);
+        if (entry.strand->_state != Strand::State::Timed || entry.generation != entry.strand->_timerGeneration) {
+            continue;  // schedule()로 이미 재등록된 타이머
+        }
+
+        if (entry.strand->_cancelled) {
+            entry.strand->_state = Strand::State::Idle;
+            entry.strand->_cv.notify_all();
+            continue;
+        }
+
+        entry.strand->_state = Strand::State::Queued;
+        return entry.strand;
+    }
+    return nullptr;
+}
+
+void DecodeExecutor::run(const std::shared_ptr<Strand> &strand, const size_t worker) {
+    {
+        std::lock_guard<std::mutex> lock(strand->_mutex);
+        if (strand->_state != Strand::State::Queued) {
+            return;
+        }
+
+        if (strand->_cancelled) {
+            strand->_state = Strand::State::Idle;
+            strand->_cv.notify_all();
+            return;
+        }
+        strand->_state = Strand::State::Running;
+    }
+
+    auto step = Step::idle();
+    try {
+        step = strand->_step();
+    } catch (const std::exception &e) {
+        spdlog::error("Decode task failed: {}", e.what());
+    }
+
+    std::unique_lock<std::mutex> lock(strand->_mutex);
+    if (strand->_cancelled) {
+        strand->_state = Strand::State::Idle;
+        strand->_cv.notify_all();
+        return;
+    }
+
+    // 실행 중 schedule() 요청이 있었다면 대기하지 않고 바로 재실행
+    if (strand->_wakeRequested) {
+        strand->_wakeRequested = false;
+        step = Step::next();
+    }
+
+    if (step.kind == Step::Kind::Wait && step.notBefore <= Clock::now()) {
+        step = Step::next();
+    }
+
+    switch (step.kind) {
+        case Step::Kind::Continue: {
+            // 공정성: 같은 워커 큐의 뒤로 보내 다른 채널이 먼저 실행되도록 함
+            strand->_state = Strand::State::Queued;
+            lock.unlock();
+            enqueue(strand, worker);
+            return;
+        }
+        case Step::Kind::Wait: {
+            strand->_state = Strand::State::Timed;
+            const auto generation = strand->_timerGeneration;
+            lock.unlock();
+            enqueueTimer(strand, step.notBefore, generation);
+            return;
+        }
+        case Step::Kind::Idle:
+            strand->_state = Strand::State::Idle;
+            strand->_cv.notify_all();
+            return;
+    }
+}
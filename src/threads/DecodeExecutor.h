@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 프로세스 전역 디코딩 스레드 풀 (work-stealing)
+// - 워커 수는 코어 수로 제한
+// - 채널(디코더)별 작업은 Strand 단위로 직렬 실행되며, 한 번에 한 단위(quantum)만 실행 후 큐 뒤로 이동 (채널간 공정성)
+// - 오래 블로킹될 수 있는 작업(네트워크/live 입력 대기)은 전용 스레드 Strand 로 실행해 풀 워커를 점유하지 않음
+class DecodeExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 작업 한 단위 실행 결과
+    struct Step {
+        enum class Kind {
+            Continue,   // 즉시 다시 실행
+            Wait,       // notBefore 이후 다시 실행
+            Idle        // schedule() 호출 전까지 대기
+        };
+
+        Kind kind{Kind::Idle};
+        Clock::time_point notBefore{};
+
+        static Step next() { return {Kind::Continue, {}}; }
+
+        static Step at(const Clock::time_point time) { return {Kind::Wait, time}; }
+
+        static Step after(const std::chrono::microseconds delay) { return at(Clock::now() + delay); }
+
+        static Step idle() { return {Kind::Idle, {}}; }
+    };
+
+    class Strand : public std::enable_shared_from_this<Strand> {
+    public:
+        // 실행 대기열에 등록 (대기 중이면 즉시 깨움)
+        void schedule();
+
+        // 이후 실행을 막고 실행 중인 작업이 끝날 때까지 대기
+        void cancel();
+
+        bool isCancelled() const;
+
+        ~Strand();
+
+    private:
+        friend class DecodeExecutor;
+
+        enum class State {
+            Idle,
+            Queued,
+            Timed,
+            Running
+        };
+
+        Strand(DecodeExecutor &executor, std::function<Step()> step);
+
+        // 전용 스레드 Strand 의 실행 루프 (Step 규칙은 풀과 같음)
+        void threadLoop();
+
+        DecodeExecutor &_executor;
+        std::function<Step()> _step;
+        std::thread _thread;            // 전용 스레드 Strand 만 사용
+        Clock::time_point _notBefore{};
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        State _state{State::Idle};
+        uint64_t _timerGeneration{0};
+        bool _wakeRequested{false};
+        bool _cancelled{false};
+    };
+
+    static DecodeExecutor &instance();
+
+    ~DecodeExecutor();
+
+    DecodeExecutor(const DecodeExecutor &) = delete;
+
+    DecodeExecutor &operator=(const DecodeExecutor &) = delete;
+
+    std::shared_ptr<Strand> createStrand(std::function<Step()> step);
+
+    // 풀 대신 자체 스레드에서 실행되는 Strand (I/O 대기로 워커를 막는 입력용)
+    std::shared_ptr<Strand> createDedicatedStrand(std::function<Step()> step);
+
+    size_t getThreadCount() const { return _workers.size(); }
+
+    // libavcodec 내부 스레드 상한 (풀과 합쳐 코어 수를 넘지 않도록)
+    int getCodecThreadLimit(int requested) const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Strand>> queue;
+        std::thread thread;
+    };
+
+    struct TimerEntry {
+        std::shared_ptr<Strand> strand;
+        uint64_t generation;
+    };
+
+    explicit DecodeExecutor(size_t threadCount);
+
+    void workerLoop(size_t index);
+
+    void enqueue(std::shared_ptr<Strand> strand, size_t worker);
+
+    void enqueueTimer(std::shared_ptr<Strand> strand, Clock::time_point time, uint64_t generation);
+
+    std::shared_ptr<Strand> popLocal(size_t index);
+
+    std::shared_ptr<Strand> steal(size_t thief);
+
+    std::shared_ptr<Strand> popDueTimer();
+
+    void run(const std::shared_ptr<Strand> &strand, size_t worker);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::atomic<size_t> _nextWorker{0};
+    std::atomic<size_t> _pending{0};
+    std::atomic<bool> _running{true};
+
+    // 유휴 대기 및 타이머
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCv;
+    std::multimap<Clock::time_point, TimerEntry> _timers;
+};
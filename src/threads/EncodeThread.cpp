@@ -0,0 +1,114 @@
+#include "EncodeThread.h"
+#include <algorithm>
+#include <chrono>
+#include <spdlog/spdlog.h>
+
+EncodeThread::EncodeThread(Encoder &encoder, const Config config)
+        : _encoder(encoder), _config{std::max<size_t>(1, config.maxQueueSize), config.overflowPolicy} {
+    const auto &encoderConfig = encoder.getConfig();
+    if (encoderConfig.adaptivePreset) {
+        _rateController = std::make_unique<EncodeRateController>(encoderConfig, encoder.getFps());
+    }
+}
+
+EncodeThread::~EncodeThread() {
+    stop();
+}
+
+void EncodeThread::start() {
+    if (!_running) {
+        _running = true;
+        _thread = std::thread(&EncodeThread::run, this);
+    }
+}
+
+void EncodeThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _notEmpty.notify_all();
+    _notFull.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+bool EncodeThread::push(std::shared_ptr<const VideoFrame> frame, const int64_t sequence) {
+    if (!frame) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_running) {
+        return false;
+    }
+
+    if (_queue.size() >= _config.maxQueueSize) {
+        switch (_config.overflowPolicy) {
+            case OverflowPolicy::DropOldest:
+                _queue.pop_front();
+                ++_droppedFrames;
+                break;
+            case OverflowPolicy::DropNewest:
+                ++_droppedFrames;
+                return false;
+            case OverflowPolicy::Block:
+                _notFull.wait(lock, [this] { return !_running || _queue.size() < _config.maxQueueSize; });
+                if (!_running) {
+                    ++_droppedFrames;
+                    return false;
+                }
+                break;
+        }
+    }
+
+    _queue.push_back({std::move(frame), sequence});
+    lock.unlock();
+    _notEmpty.notify_one();
+    return true;
+}
+
+size_t EncodeThread::getQueueSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+}
+
+void EncodeThread::run() {
+    while (true) {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [this] { return !_running || !_queue.empty(); });
+
+            // 종료 요청 후에도 이미 받은 프레임은 모두 인코딩
+            if (_queue.empty()) {
+                break;
+            }
+            item = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        _notFull.notify_one();
+
+        const auto encodeStart = std::chrono::steady_clock::now();
+        _encoder.encodeFrame(item.frame, item.sequence);
+        ++_encodedFrames;
+
+        if (_rateController) {
+            const double encodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - encodeStart).count();
+            if (const int direction = _rateController->update(encodeSeconds, getQueueSize(), _config.maxQueueSize)) {
+                const auto &step = _rateController->getStep();
+                spdlog::info("Encoder load {:.2f}, switching to preset {} (threads {}, sliced-threads {})",
+                             _encodeLoad.load(), step.preset, step.threads, step.slicedThreads);
+                // 빠른 쪽은 바로, 느린 쪽은 다음 세그먼트 경계에서 적용
+                _encoder.requestStep(step, direction < 0);
+            }
+            _encodeLoad = _rateController->getLoad();
+        }
+    }
+
+    if (_droppedFrames > 0) {
+        spdlog::warn("Encode queue dropped {} frames ({} encoded)", _droppedFrames.load(), _encodedFrames.load());
+    }
+}
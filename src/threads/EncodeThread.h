@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "../media/EncodeRateController.h"
+#include "../media/Encoder.h"
+#include "../media/VideoFrame.h"
+#include "../media/interface/IFrameSink.h"
+
+// 녹화 인코딩 전용 스레드 (디코더 frame sink 는 프레임 핸들만 큐에 넣고 바로 반환)
+class EncodeThread : public IFrameSink {
+public:
+    // 큐가 가득 찼을 때의 처리
+    enum class OverflowPolicy {
+        DropOldest,     // 가장 오래된 프레임을 버리고 추가 (기본)
+        DropNewest,     // 새 프레임을 버림
+        Block           // 공간이 생길 때까지 호출 스레드 대기 (무손실, 재생에 영향 가능)
+    };
+
+    struct Config {
+        size_t maxQueueSize{DEFAULT_QUEUE_SIZE};
+        OverflowPolicy overflowPolicy{OverflowPolicy::DropOldest};
+    };
+
+    EncodeThread(Encoder &encoder, Config config);
+
+    ~EncodeThread() override;
+
+    void start();
+
+    // 남은 프레임을 모두 인코딩한 뒤 종료
+    void stop();
+
+    // 큐에 추가, 프레임을 버렸으면 false
+    // sequence: 세그먼트 schedule 을 공유하는 Encoder 들의 입력 프레임 번호 (RenditionThread 가 부여)
+    bool push(std::shared_ptr<const VideoFrame> frame, int64_t sequence = -1);
+
+    void onFrame(std::shared_ptr<const VideoFrame> frame) override { push(std::move(frame)); }
+
+    size_t getQueueSize() const;
+
+    uint64_t getDroppedFrames() const { return _droppedFrames; }
+
+    uint64_t getEncodedFrames() const { return _encodedFrames; }
+
+    // 프레임당 평균 인코딩 시간 / 프레임 간격 (adaptivePreset 사용 시)
+    double getEncodeLoad() const { return _encodeLoad; }
+
+    static constexpr size_t DEFAULT_QUEUE_SIZE = 8;
+
+private:
+    void run();
+
+    struct Item {
+        std::shared_ptr<const VideoFrame> frame;
+        int64_t sequence{-1};
+    };
+
+    Encoder &_encoder;
+    const Config _config;
+    std::unique_ptr<EncodeRateController> _rateController;
+
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+
+    std::deque<Item> _queue;
+    mutable std::mutex _mutex;
+    std::condition_variable _notEmpty;
+    std::condition_variable _notFull;
+
+    std::atomic<uint64_t> _droppedFrames{0};
+    std::atomic<uint64_t> _encodedFrames{0};
+    std::atomic<double> _encodeLoad{0.0};
+};
@@ -0,0 +1,107 @@
+#include "RemuxThread.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+RemuxThread::RemuxThread(Encoder &encoder, const size_t maxQueueSize)
+        : _encoder(encoder), _maxQueueSize(std::max<size_t>(1, maxQueueSize)) {
+}
+
+RemuxThread::~RemuxThread() {
+    stop();
+
+    for (auto &entry : _queue) {
+        av_packet_free(&entry.packet);
+    }
+    _queue.clear();
+}
+
+void RemuxThread::start() {
+    if (!_running) {
+        _running = true;
+        _thread = std::thread(&RemuxThread::run, this);
+    }
+}
+
+void RemuxThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _notEmpty.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void RemuxThread::onPacket(const AVPacket *packet, const bool isVideo) {
+    enqueue(packet, isVideo, true);
+}
+
+void RemuxThread::onBufferedPacket(const AVPacket *packet, const bool isVideo) {
+    enqueue(packet, isVideo, false);
+}
+
+void RemuxThread::enqueue(const AVPacket *packet, const bool isVideo, const bool bounded) {
+    if (!packet) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_running) {
+        return;
+    }
+
+    // 디코드 스레드를 막지 않도록 드롭, 참조 프레임이 빠지므로 writer 가 다음 키프레임부터 재개
+    if (bounded && _queue.size() - _bufferedInQueue >= _maxQueueSize) {
+        ++_droppedPackets;
+        _pendingDiscontinuity = true;
+        return;
+    }
+
+    // 복사 없이 참조 카운트만 증가
+    AVPacket *clone = av_packet_clone(packet);
+    if (!clone) {
+        ++_droppedPackets;
+        _pendingDiscontinuity = true;
+        return;
+    }
+
+    _queue.push_back({clone, isVideo, _pendingDiscontinuity, !bounded});
+    _pendingDiscontinuity = false;
+    if (!bounded) {
+        ++_bufferedInQueue;
+    }
+    lock.unlock();
+    _notEmpty.notify_one();
+}
+
+void RemuxThread::run() {
+    while (true) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [this] { return !_running || !_queue.empty(); });
+
+            // 종료 요청 후에도 이미 받은 패킷은 모두 기록
+            if (_queue.empty()) {
+                break;
+            }
+            entry = _queue.front();
+            _queue.pop_front();
+            if (entry.buffered) {
+                --_bufferedInQueue;
+            }
+        }
+
+        if (entry.discontinuity) {
+            _encoder.markDiscontinuity();
+        }
+        _encoder.writePacket(entry.packet, entry.isVideo);
+        av_packet_free(&entry.packet);
+    }
+
+    if (_droppedPackets > 0) {
+        spdlog::warn("Remux queue dropped {} packets", _droppedPackets.load());
+    }
+}
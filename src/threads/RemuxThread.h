@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "../media/Encoder.h"
+#include "../media/interface/IPacketSink.h"
+
+// stream copy 녹화 전용 스레드 (디코드 스레드는 패킷 참조만 큐에 넣고 바로 반환)
+class RemuxThread : public IPacketSink {
+public:
+    RemuxThread(Encoder &encoder, size_t maxQueueSize);
+
+    ~RemuxThread() override;
+
+    void start();
+
+    // 남은 패킷을 모두 기록한 뒤 종료
+    void stop();
+
+    // [Decode thread] 큐가 가득 차면 새 패킷을 버리고 다음 키프레임까지 기록 중단
+    void onPacket(const AVPacket *packet, bool isVideo) override;
+
+    // pre-roll 패킷은 상한 없이 큐에 추가 (PacketRing 메모리 상한으로 제한됨)
+    void onBufferedPacket(const AVPacket *packet, bool isVideo) override;
+
+    uint64_t getDroppedPackets() const { return _droppedPackets; }
+
+    static constexpr size_t DEFAULT_QUEUE_SIZE = 256;
+
+private:
+    struct Entry {
+        AVPacket *packet{nullptr};
+        bool isVideo{false};
+        bool discontinuity{false};
+        bool buffered{false};
+    };
+
+    void enqueue(const AVPacket *packet, bool isVideo, bool bounded);
+
+    void run();
+
+    Encoder &_encoder;
+    const size_t _maxQueueSize;
+
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+
+    std::deque<Entry> _queue;
+    mutable std::mutex _mutex;
+    std::condition_variable _notEmpty;
+    bool _pendingDiscontinuity{false};
+    size_t _bufferedInQueue{0};     // 큐 상한에서 제외되는 pre-roll 패킷 수
+
+    std::atomic<uint64_t> _droppedPackets{0};
+};
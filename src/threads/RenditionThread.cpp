@@ -0,0 +1,143 @@
+#include "RenditionThread.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+extern "C" {
+#include <libavutil/imgutils.h>
+}
+
+RenditionThread::RenditionThread(std::vector<Output> outputs, const size_t maxQueueSize)
+        : _outputs(std::move(outputs)),
+          _swsContexts(_outputs.size(), nullptr),
+          _maxQueueSize(std::max<size_t>(1, maxQueueSize)) {
+}
+
+RenditionThread::~RenditionThread() {
+    stop();
+
+    for (auto *swsCtx : _swsContexts) {
+        sws_freeContext(swsCtx);
+    }
+}
+
+void RenditionThread::start() {
+    if (!_running) {
+        _running = true;
+        _thread = std::thread(&RenditionThread::run, this);
+    }
+}
+
+void RenditionThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _notEmpty.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+bool RenditionThread::push(std::shared_ptr<const VideoFrame> frame) {
+    if (!frame) {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_running) {
+        return false;
+    }
+
+    if (_queue.size() >= _maxQueueSize) {
+        _queue.pop_front();
+        ++_droppedFrames;
+    }
+    _queue.push_back(std::move(frame));
+    lock.unlock();
+    _notEmpty.notify_one();
+    return true;
+}
+
+void RenditionThread::run() {
+    while (true) {
+        std::shared_ptr<const VideoFrame> frame;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [this] { return !_running || !_queue.empty(); });
+
+            if (_queue.empty()) {
+                break;
+            }
+            frame = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        distribute(frame);
+    }
+
+    if (_droppedFrames > 0) {
+        spdlog::warn("Rendition queue dropped {} frames", _droppedFrames.load());
+    }
+}
+
+void RenditionThread::distribute(const std::shared_ptr<const VideoFrame> &frame) {
+    if (_outputs.empty()) {
+        return;
+    }
+
+    // 원본 크기 YUV420P (이미 같은 포맷/크기면 변환 없이 공유)
+    const Output &primary = _outputs.front();
+    std::shared_ptr<const VideoFrame> converted = frame;
+    if (frame->format != VideoFrame::PixelFormat::YUV420P ||
+        frame->width != primary.width || frame->height != primary.height) {
+        converted = scale(*frame, 0);
+    }
+    if (!converted) {
+        return;
+    }
+    const int64_t sequence = _sequence++;
+    primary.encodeThread->push(converted, sequence);
+
+    // 축소는 원본 RGB 대신 변환된 YUV420P 에서 (평면 축소라 변환 비용 없음)
+    for (size_t i = 1; i < _outputs.size(); ++i) {
+        if (auto proxy = scale(*converted, i)) {
+            _outputs[i].encodeThread->push(std::move(proxy), sequence);
+        }
+    }
+}
+
+std::shared_ptr<const VideoFrame> RenditionThread::scale(const VideoFrame &source, const size_t outputIndex) {
+    const Output &output = _outputs[outputIndex];
+    const AVPixelFormat srcFormat = Encoder::toAVPixelFormat(source.format);
+
+    auto &swsCtx = _swsContexts[outputIndex];
+    swsCtx = sws_getCachedContext(swsCtx, source.width, source.height, srcFormat,
+                                  output.width, output.height, AV_PIX_FMT_YUV420P,
+                                  outputIndex == 0 ? SWS_BICUBIC : SWS_BILINEAR, nullptr, nullptr, nullptr);
+    if (!swsCtx) {
+        spdlog::error("Could not initialize rendition conversion context");
+        return nullptr;
+    }
+
+    auto scaled = std::make_shared<VideoFrame>();
+    scaled->width = output.width;
+    scaled->height = output.height;
+    scaled->pts = source.pts;
+    scaled->format = VideoFrame::PixelFormat::YUV420P;
+    scaled->data.resize(scaled->frameSize());
+
+    uint8_t *srcData[4] = {nullptr};
+    int srcLinesize[4] = {0};
+    av_image_fill_arrays(srcData, srcLinesize, source.pixels(), srcFormat, source.width, source.height, 1);
+
+    uint8_t *dstData[4] = {nullptr};
+    int dstLinesize[4] = {0};
+    av_image_fill_arrays(dstData, dstLinesize, scaled->data.data(), AV_PIX_FMT_YUV420P,
+                         output.width, output.height, 1);
+
+    if (sws_scale(swsCtx, srcData, srcLinesize, 0, source.height, dstData, dstLinesize) <= 0) {
+        return nullptr;
+    }
+    return scaled;
+}
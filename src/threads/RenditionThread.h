@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "EncodeThread.h"
+#include "../media/VideoFrame.h"
+#include "../media/interface/IFrameSink.h"
+
+extern "C" {
+#include <libswscale/swscale.h>
+}
+
+// 녹화 프레임을 rendition 별 크기로 축소해 각 EncodeThread 로 분배
+// (첫 output 은 원본 크기, 이후 output 은 원본 YUV420P 에서 축소)
+class RenditionThread : public IFrameSink {
+public:
+    struct Output {
+        EncodeThread *encodeThread{nullptr};
+        int width{0};
+        int height{0};
+    };
+
+    RenditionThread(std::vector<Output> outputs, size_t maxQueueSize);
+
+    ~RenditionThread() override;
+
+    void start();
+
+    // 남은 프레임을 모두 분배한 뒤 종료 (EncodeThread 종료는 호출자 책임)
+    void stop();
+
+    // 큐가 가득 차면 가장 오래된 프레임을 버림
+    bool push(std::shared_ptr<const VideoFrame> frame);
+
+    void onFrame(std::shared_ptr<const VideoFrame> frame) override { push(std::move(frame)); }
+
+    uint64_t getDroppedFrames() const { return _droppedFrames; }
+
+private:
+    void run();
+
+    void distribute(const std::shared_ptr<const VideoFrame> &frame);
+
+    std::shared_ptr<const VideoFrame> scale(const VideoFrame &source, size_t outputIndex);
+
+    std::vector<Output> _outputs;
+    std::vector<SwsContext *> _swsContexts;
+    const size_t _maxQueueSize;
+
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+
+    std::deque<std::shared_ptr<const VideoFrame>> _queue;
+    mutable std::mutex _mutex;
+    std::condition_variable _notEmpty;
+
+    std::atomic<uint64_t> _droppedFrames{0};
+    // 분배한 프레임 번호 (모든 output 에 같은 번호로 전달해 세그먼트 경계를 맞춤)
+    int64_t _sequence{0};
+};
@@ -21,6 +21,12 @@ void ControlPanel::render(MediaState &state) {
                  ImGuiWindowFlags_NoCollapse |
                  ImGuiWindowFlags_NoBringToFrontOnFocus);
 
+    if (state.currentFile != _markedFile) {
+        _markedFile = state.currentFile;
+        _inPoint = -1.0;
+        _outPoint = -1.0;
+    }
+
     renderProgressBar(state);
     renderTimeDisplay(state);
     renderControlButtons(state);
@@ -70,6 +76,38 @@ void ControlPanel::handleInput(GLFWwindow* window, const MediaState& state) {
         _showMarkers = !_showMarkers;
     }
     mKeyWasPressed = mKeyIsPressed;
+
+    // key - i / o (내보낼 구간 시작/끝)
+    if (ImGui::GetIO().WantCaptureKeyboard) {
+        return;
+    }
+    static bool iKeyWasPressed = false;
+    const bool iKeyIsPressed = (glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS);
+    if (iKeyIsPressed && !iKeyWasPressed) {
+        markIn(state);
+    }
+    iKeyWasPressed = iKeyIsPressed;
+
+    static bool oKeyWasPressed = false;
+    const bool oKeyIsPressed = (glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS);
+    if (oKeyIsPressed && !oKeyWasPressed) {
+        markOut(state);
+    }
+    oKeyWasPressed = oKeyIsPressed;
+}
+
+void ControlPanel::markIn(const MediaState &state) {
+    _inPoint = state.currentTime;
+    if (_outPoint >= 0.0 && _outPoint <= _inPoint) {
+        _outPoint = -1.0;
+    }
+}
+
+void ControlPanel::markOut(const MediaState &state) {
+    _outPoint = state.currentTime;
+    if (_inPoint >= _outPoint) {
+        _inPoint = -1.0;
+    }
 }
 
 void ControlPanel::renderProgressBar(const MediaState &state) {
@@ -98,6 +136,7 @@ void ControlPanel::renderProgressBar(const MediaState &state) {
     ImGui::Checkbox("Show Frame Markers", &_showMarkers);
 
     ImDrawList *drawList = ImGui::GetWindowDrawList();
+    renderClipRange(drawList, progressBarPos, progressBarWidth, progressBarHeight, state.totalDuration);
 
     // markers - On/Off
     if (_showMarkers) {
@@ -167,6 +206,27 @@ void ControlPanel::renderProgressBar(const MediaState &state) {
     ImGui::PopItemWidth();
 }
 
+void ControlPanel::renderClipRange(ImDrawList *drawList, const ImVec2 &barPos, const float barWidth,
+                                   const float barHeight, const double totalDuration) const {
+    if (totalDuration <= 0.0) {
+        return;
+    }
+    constexpr ImU32 clipColor = IM_COL32(0, 191, 255, 255 /* Deep Sky Blue */);
+
+    const auto toX = [&](const double time) {
+        return barPos.x + static_cast<float>(std::clamp(time / totalDuration, 0.0, 1.0)) * barWidth;
+    };
+    if (_inPoint >= 0.0) {
+        drawList->AddLine(ImVec2(toX(_inPoint), barPos.y), ImVec2(toX(_inPoint), barPos.y + barHeight), clipColor, 2.0f);
+    }
+    if (_outPoint >= 0.0) {
+        drawList->AddLine(ImVec2(toX(_outPoint), barPos.y), ImVec2(toX(_outPoint), barPos.y + barHeight), clipColor, 2.0f);
+    }
+    if (hasClipRange()) {
+        drawList->AddRect(ImVec2(toX(_inPoint), barPos.y), ImVec2(toX(_outPoint), barPos.y + barHeight), clipColor);
+    }
+}
+
 void ControlPanel::renderTimeDisplay(const MediaState &state) {
     ImGui::SameLine();
     const std::string timeText = Utils::formatTime(state.currentTime) + " / " + Utils::formatTime(state.totalDuration);
@@ -179,7 +239,7 @@ void ControlPanel::renderControlButtons(const MediaState &state) {
     constexpr float buttonWidth = 60.0f;
     constexpr float buttonHeight = 35.0f;
     constexpr float spacing = 15.0f;
-    constexpr int numButtons = 5;
+    constexpr int numButtons = 8;
     constexpr float totalWidth = buttonWidth * numButtons + spacing * (numButtons - 1);
     const float startX = (static_cast<float>(_videoWidth) - totalWidth) * 0.5f;
 
@@ -235,4 +295,22 @@ void ControlPanel::renderControlButtons(const MediaState &state) {
             }
         }
     }
+
+    // Clip - 현재 위치를 In/Out 으로 지정 후 구간 내보내기
+    ImGui::SameLine(0, spacing);
+    if (ImGui::Button("In", ImVec2(buttonWidth, buttonHeight))) {
+        markIn(state);
+    }
+
+    ImGui::SameLine(0, spacing);
+    if (ImGui::Button("Out", ImVec2(buttonWidth, buttonHeight))) {
+        markOut(state);
+    }
+
+    ImGui::SameLine(0, spacing);
+    if (ImGui::Button("Export", ImVec2(buttonWidth, buttonHeight))) {
+        if (hasClipRange() && _onExportClip) {
+            _onExportClip(_inPoint, _outPoint);
+        }
+    }
 }
\ No newline at end of file
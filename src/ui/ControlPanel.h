@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 #include <functional>
+#include <string>
 #include <utility>
 #include "core/MediaState.h"
 #include "imgui.h"
@@ -29,6 +30,9 @@ public:
     void setStopRecordingCallback(std::function<void()> cb) { _onStopRecording = std::move(cb); }
     void setRecordingState(const bool isRecording) { _isRecording = isRecording; }
 
+    // In/Out 구간 내보내기 (inTime, outTime)
+    void setExportClipCallback(std::function<void(double, double)> cb) { _onExportClip = std::move(cb); }
+
     bool handleKeyInput(int key, int action, const MediaState &state);
     void handleInput(GLFWwindow *window, const MediaState &state);
 
@@ -39,6 +43,15 @@ private:
 
     static void renderTimeDisplay(const MediaState &state);
 
+    void renderClipRange(ImDrawList *drawList, const ImVec2 &barPos, float barWidth, float barHeight,
+                         double totalDuration) const;
+
+    void markIn(const MediaState &state);
+
+    void markOut(const MediaState &state);
+
+    bool hasClipRange() const { return _inPoint >= 0.0 && _outPoint > _inPoint; }
+
     int _videoWidth;
     int _controlsHeight;
 
@@ -46,10 +59,16 @@ private:
     bool _showMarkers{false};
     bool _spacePressed{false};
 
+    // 내보낼 구간 (-1 이면 미지정), 파일이 바뀌면 초기화
+    double _inPoint{-1.0};
+    double _outPoint{-1.0};
+    std::string _markedFile;
+
     std::function<void()> _onPlay;
     std::function<void()> _onPause;
     std::function<void()> _onStop;
     std::function<void(double)> _onSeek;
     std::function<bool()> _onStartRecording;
     std::function<void()> _onStopRecording;
+    std::function<void(double, double)> _onExportClip;
 };
\ No newline at end of file
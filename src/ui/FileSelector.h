@@ -22,12 +22,23 @@ public:
 
     void setFiles(const std::vector<std::string> &files) {
         _files = files;
+        _checked.assign(_files.size(), false);
     }
 
     void setSelectCallback(std::function<void(const std::string &)> cb) {
         _selectCallback = std::move(cb);
     }
 
+    // 체크한 파일들을 재생 목록으로 재생
+    void setPlaylistCallback(std::function<void(const std::vector<std::string> &)> cb) {
+        _playlistCallback = std::move(cb);
+    }
+
+    // 체크한 파일들을 재생 목록 뒤에 추가
+    void setEnqueueCallback(std::function<void(const std::vector<std::string> &)> cb) {
+        _enqueueCallback = std::move(cb);
+    }
+
     void render() {
         if (!_visible) {
             return;
@@ -35,7 +46,14 @@ public:
 
         ImGui::Begin("Select Video File", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize);
 
-        for (const auto &file: _files) {
+        _checked.resize(_files.size(), false);
+        for (size_t i = 0; i < _files.size(); ++i) {
+            const auto &file = _files[i];
+            bool checked = _checked[i];
+            if (ImGui::Checkbox(("##" + file).c_str(), &checked)) {
+                _checked[i] = checked;
+            }
+            ImGui::SameLine();
             if (ImGui::Selectable(file.c_str())) {
                 if (_selectCallback) {
                     _selectCallback(file);
@@ -44,11 +62,41 @@ public:
             }
         }
 
+        ImGui::Separator();
+        if (ImGui::Button("Play Selected")) {
+            submitChecked(_playlistCallback);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Enqueue")) {
+            submitChecked(_enqueueCallback);
+        }
+
         ImGui::End();
     }
 
 private:
+    void submitChecked(const std::function<void(const std::vector<std::string> &)> &cb) {
+        std::vector<std::string> checkedFiles;
+        for (size_t i = 0; i < _files.size(); ++i) {
+            if (_checked[i]) {
+                checkedFiles.push_back(_files[i]);
+            }
+        }
+        if (checkedFiles.empty()) {
+            return;
+        }
+
+        if (cb) {
+            cb(checkedFiles);
+        }
+        _checked.assign(_files.size(), false);
+        _visible = false;
+    }
+
     bool _visible = false;
     std::vector<std::string> _files;
+    std::vector<bool> _checked;
     std::function<void(const std::string &)> _selectCallback;
+    std::function<void(const std::vector<std::string> &)> _playlistCallback;
+    std::function<void(const std::vector<std::string> &)> _enqueueCallback;
 };
\ No newline at end of file